@@ -0,0 +1,217 @@
+#  Copyright 2020 HPS/SAFARI Research Groups
+#
+#  Permission is hereby granted, free of charge, to any person obtaining a copy of
+#  this software and associated documentation files (the "Software"), to deal in
+#  the Software without restriction, including without limitation the rights to
+#  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+#  of the Software, and to permit persons to whom the Software is furnished to do
+#  so, subject to the following conditions:
+#
+#  The above copyright notice and this permission notice shall be included in all
+#  copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+#  SOFTWARE.
+
+
+"""Simulator throughput benchmark suite.
+
+Runs every workload of a suite file (default: utils/bench/suite.json) with every PARAMS file of the suite and writes
+the simulation speed of each run (KIPS, peak RSS, per-phase host time) to a JSON file. Use scarab_bench_compare.py to
+compare two result files.
+"""
+
+from __future__ import print_function
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+from scarab_globals import *
+
+parser = argparse.ArgumentParser(description="Measure Scarab simulation throughput")
+parser.add_argument('--suite', default=scarab_paths.utils_dir + "/bench/suite.json", help="Benchmark suite file.")
+parser.add_argument('--out', default="bench.json", help="Path of the JSON results file.")
+parser.add_argument('--scarab', default=scarab_paths.scarab_bin, help="Path to the scarab binary. Defaults to src/scarab.")
+parser.add_argument('--rundir', default="bench_runs", help="Directory for the simulation runs and generated traces.")
+parser.add_argument('--repeat', type=int, default=3, help="Runs per workload and PARAMS file; the fastest one is kept.")
+parser.add_argument('--workloads', default=None, help="Comma separated subset of the suite workloads to run.")
+parser.add_argument('--params', default=None, help="Comma separated subset of the suite PARAMS files to run.")
+parser.add_argument('--no_host_prof', action='store_true', help="Do not collect per-phase host time.")
+parser.add_argument('--scarab_args', default="", help="Additional arguments to pass to every scarab run.")
+
+cumulative_re = re.compile(r"Cumulative:\s+Cycles:\s+(\d+)\s+Instructions:\s+(\d+)")
+
+def generator_bin():
+  return scarab_paths.utils_dir + "/bench/gen_synthetic_trace"
+
+def build_generator():
+  if not os.path.exists(generator_bin()):
+    subprocess.check_call(["make", "--no-print-directory", "-C", os.path.dirname(generator_bin())])
+
+def synthetic_trace(rundir, name, synthetic):
+  """Generate (once) the synthetic pin trace of a workload and return its path."""
+  path = os.path.join(rundir, "traces", name + ".trace.bz2")
+  if os.path.exists(path):
+    return path
+  build_generator()
+  os.makedirs(os.path.dirname(path), exist_ok=True)
+  cmd = [generator_bin(), "-k", synthetic["kernel"], "-n", str(synthetic["insts"]), "-o", path]
+  for key, opt in [("footprint", "-f"), ("trip", "-t"), ("taken_prob", "-p"), ("seed", "-s")]:
+    if key in synthetic:
+      cmd += [opt, str(synthetic[key])]
+  subprocess.check_call(cmd)
+  return path
+
+def workload_args(rundir, workload):
+  """Return the scarab arguments of a workload, or None if it cannot run on this host."""
+  args = ["--frontend", workload["frontend"], "--fetch_off_path_ops", "0"]
+  if "model" in workload:
+    args += ["--model", workload["model"]]
+  if "inst_limit" in workload:
+    args += ["--inst_limit", str(workload["inst_limit"])]
+
+  if "synthetic" in workload:
+    args += ["--cbp_trace_r0", os.path.abspath(synthetic_trace(rundir, workload["name"], workload["synthetic"]))]
+  elif "trace" in workload:
+    args += ["--cbp_trace_r0", os.path.join(scarab_paths.sim_dir, workload["trace"])]
+  elif "trace_env" in workload:
+    trace = os.environ.get(workload["trace_env"])
+    if not trace:
+      return None
+    args += ["--cbp_trace_r0", trace]
+    if "modules_log_env" in workload:
+      modules_log = os.environ.get(workload["modules_log_env"])
+      if not modules_log:
+        return None
+      args += ["--memtrace_modules_log", modules_log]
+  return args
+
+def read_counts(simdir):
+  """Return (cycles, instructions) of core 0 from the stat files of a run."""
+  for file_name in sorted(os.listdir(simdir)):
+    if file_name.endswith(".stat.0.out"):
+      with open(os.path.join(simdir, file_name)) as f:
+        match = cumulative_re.search(f.read())
+      if match:
+        return int(match.group(1)), int(match.group(2))
+  return 0, 0
+
+def read_host_prof(simdir):
+  """Return {phase: fraction of the run} from the summary of the host profile, if any."""
+  path = os.path.join(simdir, "host_prof.out")
+  phases = {}
+  if not os.path.exists(path):
+    return phases
+  in_summary = False
+  with open(path) as f:
+    for line in f:
+      fields = line.split()
+      if fields[:2] == ["phase", "ticks"]:
+        in_summary = True
+      elif in_summary and len(fields) >= 4 and fields[0] != "run":
+        phases[fields[0]] = float(fields[3]) / 100.0
+  return phases
+
+def run_once(simdir, params, scarab_args):
+  """Run scarab once in simdir and return (wall seconds, peak RSS in KB, returncode)."""
+  if os.path.exists(simdir):
+    shutil.rmtree(simdir)
+  os.makedirs(simdir)
+  shutil.copy2(params, os.path.join(simdir, "PARAMS.in"))
+  with open(os.path.join(simdir, "scarab.log"), "w") as log:
+    start = time.perf_counter()
+    proc = subprocess.Popen([os.path.abspath(args.scarab)] + scarab_args, cwd=simdir, stdout=log,
+                            stderr=subprocess.STDOUT)
+    _, status, rusage = os.wait4(proc.pid, 0)
+    wall = time.perf_counter() - start
+  return wall, rusage.ru_maxrss, os.waitstatus_to_exitcode(status)
+
+def git_revision():
+  try:
+    return subprocess.check_output(["git", "-C", scarab_paths.sim_dir, "rev-parse", "--short", "HEAD"],
+                                   stderr=subprocess.DEVNULL).decode().strip()
+  except Exception:
+    return "unknown"
+
+def main():
+  with open(args.suite) as f:
+    suite = json.load(f)
+  workloads = suite["workloads"]
+  if args.workloads:
+    selected = args.workloads.split(",")
+    workloads = [w for w in workloads if w["name"] in selected]
+  params_files = suite["params"]
+  if args.params:
+    selected = args.params.split(",")
+    params_files = [p for p in params_files if p in selected or os.path.basename(p) in selected]
+
+  results = []
+  for workload in workloads:
+    wl_args = workload_args(args.rundir, workload)
+    if wl_args is None:
+      scarab_utils.warn("Skipping workload {}: its trace is not available".format(workload["name"]))
+      continue
+    if not args.no_host_prof:
+      wl_args += ["--host_prof", "1"]
+    wl_args += args.scarab_args.split()
+
+    for params in params_files:
+      params_name = os.path.basename(params)
+      simdir = os.path.join(os.path.abspath(args.rundir), workload["name"], params_name)
+      walls = []
+      peak_rss = 0
+      phases = {}
+      for _ in range(args.repeat):
+        wall, rss, returncode = run_once(simdir, os.path.join(scarab_paths.sim_dir, params), wl_args)
+        if returncode != 0:
+          scarab_utils.error("Scarab failed on {} with {}, see {}/scarab.log".format(workload["name"], params_name, simdir))
+        # each repetition replaces simdir, so keep the profile of the fastest run
+        if not walls or wall < min(walls):
+          phases = {phase: frac * wall for phase, frac in read_host_prof(simdir).items()}
+        walls.append(wall)
+        peak_rss = max(peak_rss, rss)
+
+      cycles, insts = read_counts(simdir)
+      result = {
+        "workload": workload["name"],
+        "params": params_name,
+        "insts": insts,
+        "cycles": cycles,
+        "wall_s": walls,
+        "kips": insts / min(walls) / 1000.0 if insts else 0.0,
+        "peak_rss_kb": peak_rss,
+        "phase_s": phases,
+      }
+      results.append(result)
+      print("{:<14} {:<20} {:>12} insts {:>10.1f} KIPS {:>10} KB".format(
+        result["workload"], result["params"], result["insts"], result["kips"], result["peak_rss_kb"]))
+
+  output = {
+    "meta": {
+      "revision": git_revision(),
+      "host": platform.node(),
+      "date": datetime.datetime.now().isoformat(),
+      "scarab": os.path.abspath(args.scarab),
+      "repeat": args.repeat,
+    },
+    "results": results,
+  }
+  with open(args.out, "w") as f:
+    json.dump(output, f, indent=2)
+  print("Wrote {}".format(args.out))
+
+if __name__ == "__main__":
+  args = parser.parse_args()
+  main()
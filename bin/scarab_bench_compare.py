@@ -0,0 +1,83 @@
+#  Copyright 2020 HPS/SAFARI Research Groups
+#
+#  Permission is hereby granted, free of charge, to any person obtaining a copy of
+#  this software and associated documentation files (the "Software"), to deal in
+#  the Software without restriction, including without limitation the rights to
+#  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+#  of the Software, and to permit persons to whom the Software is furnished to do
+#  so, subject to the following conditions:
+#
+#  The above copyright notice and this permission notice shall be included in all
+#  copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+#  SOFTWARE.
+
+
+"""Compare two result files of scarab_bench.py and flag throughput regressions.
+
+Exits with status 1 if the KIPS of any workload/PARAMS pair present in both files dropped by more than the threshold.
+"""
+
+from __future__ import print_function
+import argparse
+import json
+import sys
+
+parser = argparse.ArgumentParser(description="Compare two Scarab throughput benchmark results")
+parser.add_argument('base', help="Results JSON of the baseline.")
+parser.add_argument('new', help="Results JSON of the change under test.")
+parser.add_argument('--threshold', type=float, default=5.0, help="Allowed KIPS drop in percent.")
+parser.add_argument('--rss_threshold', type=float, default=10.0, help="Allowed peak RSS growth in percent.")
+
+def load(path):
+  with open(path) as f:
+    data = json.load(f)
+  return data["meta"], {(r["workload"], r["params"]): r for r in data["results"]}
+
+def pct_change(old, new):
+  return 100.0 * (new - old) / old if old else 0.0
+
+def main(args):
+  base_meta, base = load(args.base)
+  new_meta, new = load(args.new)
+  print("base: {} ({})  new: {} ({})".format(base_meta["revision"], base_meta["date"], new_meta["revision"],
+                                             new_meta["date"]))
+  print("{:<14} {:<20} {:>10} {:>10} {:>8} {:>8}  {}".format("workload", "params", "base KIPS", "new KIPS", "KIPS %",
+                                                             "RSS %", ""))
+
+  regressions = 0
+  for key in sorted(base):
+    if key not in new:
+      continue
+    b, n = base[key], new[key]
+    kips = pct_change(b["kips"], n["kips"])
+    rss = pct_change(b["peak_rss_kb"], n["peak_rss_kb"])
+    notes = []
+    if kips < -args.threshold:
+      notes.append("SLOWER")
+    if rss > args.rss_threshold:
+      notes.append("MORE MEMORY")
+    if notes:
+      regressions += 1
+    if b["insts"] != n["insts"]:
+      notes.append("(simulated insts differ)")
+    print("{:<14} {:<20} {:>10.1f} {:>10.1f} {:>+8.1f} {:>+8.1f}  {}".format(key[0], key[1], b["kips"], n["kips"], kips,
+                                                                        rss, " ".join(notes)))
+
+  missing = sorted(set(base) ^ set(new))
+  for key in missing:
+    print("{:<14} {:<20} only in {}".format(key[0], key[1], "base" if key in base else "new"))
+
+  if regressions:
+    print("{} throughput regression(s)".format(regressions))
+    return 1
+  return 0
+
+if __name__ == "__main__":
+  sys.exit(main(parser.parse_args()))
@@ -214,7 +214,15 @@ class StatFrame:
     """Parse stat file. Generate two pandas dataframes:
         1. stat_df: each row is a stat, each column is a core. Each cell contains the float value of the stat
         2. stat_metadata_df: each row is a stat. Columns are metadata about stat (e.g., what file the stat is from)
+
+    If the run was made with --dump_stats_binary, the binary stat file is mapped directly instead of parsing
+    the text stat files.
     """
+    stat_binary_file = StatBinaryFile.find(self.results_dir)
+    if stat_binary_file:
+      self.stat_df, self.stat_metadata_df = stat_binary_file.build_dfs()
+      return
+
     stat_file_parser = StatFileParser(self.results_dir)
     self.stat_metadata_df = pd.DataFrame(data=stat_file_parser.stat_names)
     self.stat_df = pd.DataFrame(data=self.stat_metadata_df.loc[:, StatConfig.stat_name_header].copy())
@@ -348,22 +356,28 @@ class StatFrame:
         stat_name (string): The new stat to add to the DF
         equation (string containing = sign): The equation to compute the new stat
     """
-    # Create a dictionary containing all stats, where the stat_name is the key
-    # Dictionary format: {'col1': {'row1': 1, 'row2': 2}, 'col2': {'row1': 0.5, 'row2': 0.75}}
-    stat_values = self.stat_df.to_dict()
-
-    if len(stat_values) == 0:
+    if len(self.stat_df.columns) == 0:
       return #StatFrame is empty, nothing to compute
 
-    new_stat_row = {}
     new_stat_metadata_row = {}
 
-    # Iterate over columns (i.e. cores), and compute equation for each
-    for core_id in stat_values:
-      # Compute equation, placing result as entry in dictionary
-      exec(equation, stat_values[core_id], stat_values[core_id])
-
-      new_stat_row[core_id] = stat_values[core_id][stat_name]
+    # Evaluate the equation once with every stat bound to its row (an array over all cores). Equations
+    # that only work on scalars (e.g., use python control flow) fall back to evaluating core by core.
+    try:
+      result = eval_equation_vectorized(equation, stat_name, self.stat_df.index, self.stat_df.values)
+      new_stat_row = dict(zip(self.stat_df.columns, np.broadcast_to(result, (len(self.stat_df.columns),))))
+    except (ValueError, TypeError):
+      # Create a dictionary containing all stats, where the stat_name is the key
+      # Dictionary format: {'col1': {'row1': 1, 'row2': 2}, 'col2': {'row1': 0.5, 'row2': 0.75}}
+      stat_values = self.stat_df.to_dict()
+      new_stat_row = {}
+
+      # Iterate over columns (i.e. cores), and compute equation for each
+      for core_id in stat_values:
+        # Compute equation, placing result as entry in dictionary
+        exec(equation, stat_values[core_id], stat_values[core_id])
+
+        new_stat_row[core_id] = stat_values[core_id][stat_name]
     new_stat_metadata_row[StatConfig.stat_file_header] = "Equation"
 
     # Update stat in Pandas DF
@@ -488,6 +502,227 @@ class StatFileParser:
       self.stat_names[StatConfig.stat_file_header].append(statsfile)
 
 
+#####################################################################
+# Binary Stats
+#####################################################################
+
+def eval_equation_vectorized(equation, stat_name, names, values):
+  """Evaluate a stat equation (<stat_name>=...) with numpy arrays.
+
+  Args:
+      equation (string): The equation to evaluate
+      stat_name (string): The stat defined by the equation
+      names (iterable of strings): Stat names, one per row of values
+      values (ndarray): Stat values, the first axis is the stat. The remaining axes (e.g., cores or runs) are
+        carried through the equation element-wise.
+
+  Returns:
+      ndarray: The value of stat_name with the trailing shape of values
+  """
+  namespace = dict(zip(names, values.astype(np.float64, copy=False)))
+  with np.errstate(divide='ignore', invalid='ignore'):
+    exec(equation, namespace, namespace)
+  return np.asarray(namespace[stat_name], dtype=np.float64)
+
+class StatBinaryFile:
+  """Zero-copy reader for the binary stat file written by Scarab with --dump_stats_binary.
+
+     The file holds one fixed-size record per dump_stats() call (all cores, all periodic/warmup/roi/simpoint/mix
+     intervals), so the records are exposed as a numpy memmap without parsing. Files written with
+     --stats_binary_sparse only hold the stats that changed in each record and are expanded on load.
+     See statistics.c for the layout.
+  """
+  file_glob = "*stats.bin"
+  magic = b"SCARABST"
+  header_dtype = np.dtype([
+    ('magic', 'S8'), ('version', '<u4'), ('num_cores', '<u4'), ('num_stats', '<u4'), ('record_size', '<u4'),
+    ('names_offset', '<u8'), ('names_size', '<u8'), ('files_offset', '<u8'), ('files_size', '<u8'),
+    ('types_offset', '<u8'), ('data_offset', '<u8')])
+
+  sparse_version = 2
+  sparse_head_dtype = np.dtype([
+    ('proc_id', '<u4'), ('flags', '<u4'), ('interval_id', '<u8'), ('cycle_count', '<u8'), ('inst_count', '<u8'),
+    ('num_entries', '<u8')])
+  sparse_entry_dtype = np.dtype([('idx', '<u8'), ('count', '<u8'), ('total', '<u8')])
+
+  # Stat_Type values from statistics.h
+  float_type = 1
+  line_type = 9
+
+  # Record flags
+  warmup_flag = 0x1
+  periodic_flag = 0x2
+  roi_flag = 0x4
+  simpoint_flag = 0x8
+  mix_flag = 0x10
+
+  def __init__(self, path):
+    self.path = path
+    header = np.fromfile(path, dtype=self.header_dtype, count=1)
+    if len(header) != 1 or header['magic'][0] != self.magic:
+      raise ValueError("{} is not a Scarab binary stat file".format(path))
+    header = header[0]
+    self.num_cores = int(header['num_cores'])
+    self.num_stats = int(header['num_stats'])
+
+    raw = np.memmap(path, dtype=np.uint8, mode='r')
+    def strings(offset, size):
+      return bytes(raw[offset:offset + size]).decode().split('\0')[:-1]
+    self.names = strings(int(header['names_offset']), int(header['names_size']))
+    self.files = strings(int(header['files_offset']), int(header['files_size']))
+    self.types = np.array(raw[int(header['types_offset']):int(header['types_offset']) + self.num_stats])
+
+    record_dtype = np.dtype([
+      ('proc_id', '<u4'), ('flags', '<u4'), ('interval_id', '<u8'), ('cycle_count', '<u8'), ('inst_count', '<u8'),
+      ('count', '<u8', (self.num_stats,)), ('total', '<u8', (self.num_stats,))])
+    data_offset = int(header['data_offset'])
+    if int(header['version']) == self.sparse_version:
+      self.records = self.expand_sparse_records(raw, data_offset, record_dtype)
+    else:
+      assert record_dtype.itemsize == int(header['record_size'])
+      num_records = (len(raw) - data_offset) // record_dtype.itemsize
+      self.records = np.memmap(path, dtype=record_dtype, mode='r', offset=data_offset, shape=(num_records,))
+
+    self.stat_mask = self.types != self.line_type
+    self.float_mask = self.types == self.float_type
+
+  def expand_sparse_records(self, raw, offset, record_dtype):
+    """Expand the variable-size records of a sparse file into dense records.
+
+    A stat without an entry has a zero count and keeps the total of the previous record of its core.
+    """
+    records = []
+    totals = np.zeros((self.num_cores, self.num_stats), dtype=np.uint64)
+    while offset + self.sparse_head_dtype.itemsize <= len(raw):
+      head = np.frombuffer(raw, dtype=self.sparse_head_dtype, count=1, offset=offset)[0]
+      offset += self.sparse_head_dtype.itemsize
+      num_entries = int(head['num_entries'])
+      if offset + num_entries * self.sparse_entry_dtype.itemsize > len(raw):
+        break  # record cut short by an interrupted run
+      entries = np.frombuffer(raw, dtype=self.sparse_entry_dtype, count=num_entries, offset=offset)
+      offset += num_entries * self.sparse_entry_dtype.itemsize
+
+      record = np.zeros((), dtype=record_dtype)
+      for field in ('proc_id', 'flags', 'interval_id', 'cycle_count', 'inst_count'):
+        record[field] = head[field]
+      idx = entries['idx'].astype(np.int64)
+      record['count'][idx] = entries['count']
+      totals[head['proc_id'], idx] = entries['total']
+      record['total'] = totals[head['proc_id']]
+      records.append(record)
+    return np.array(records, dtype=record_dtype)
+
+  @staticmethod
+  def find(results_dir):
+    """Return the StatBinaryFile of a results directory, or None if the run did not write one."""
+    files = glob.glob(os.path.join(results_dir, StatBinaryFile.file_glob))
+    if len(files) == 0:
+      return None
+    try:
+      return StatBinaryFile(files[0])
+    except Exception as e:
+      if print_warnings:
+        warn("Unable to read binary stats file {} : ".format(files[0]) + str(e))
+      return None
+
+  def values(self, records=None, column='total'):
+    """Decode stat values of the selected records into a float array of shape (num records, num stats).
+
+    Args:
+        records (array of record indices, optional): Defaults to all records.
+        column (string): 'total' (cumulative, matches the text stat files) or 'count' (current interval).
+    """
+    raw = self.records[column] if records is None else self.records[column][records]
+    values = raw.astype(np.float64)
+    values[:, self.float_mask] = raw[:, self.float_mask].view(np.float64)
+    return values
+
+  def final_records(self):
+    """Index of the last non-warmup record of each core, in core order (-1 if the core never dumped)."""
+    final = np.full(self.num_cores, -1, dtype=np.int64)
+    proc_ids = np.asarray(self.records['proc_id'])
+    not_warmup = (np.asarray(self.records['flags']) & self.warmup_flag) == 0
+    for core_id in range(self.num_cores):
+      idx = np.flatnonzero((proc_ids == core_id) & not_warmup)
+      if len(idx) > 0:
+        final[core_id] = idx[-1]
+    return final
+
+  def build_dfs(self):
+    """Build the (stat_df, stat_metadata_df) pair used by StatFrame from the final record of each core."""
+    final = self.final_records()
+    names = [name for name, keep in zip(self.names, self.stat_mask) if keep]
+    base = os.path.basename(self.path)
+    file_tag = base[:-len("stats.bin")] if base.endswith("stats.bin") else ""
+    files = [os.path.join(os.path.dirname(self.path), file_tag + f + "0.out")
+             for f, keep in zip(self.files, self.stat_mask) if keep]
+
+    stat_df = pd.DataFrame(index=pd.Index(names, name=StatConfig.stat_name_header))
+    valid = final[final >= 0]
+    values = self.values(valid)[:, self.stat_mask]
+    for column, core_id in enumerate(np.flatnonzero(final >= 0)):
+      stat_df[StatConfig.get_core_header(core_id)] = values[column]
+
+    stat_metadata_df = pd.DataFrame(data={StatConfig.stat_file_header: files},
+                                    index=pd.Index(names, name=StatConfig.stat_name_header))
+    return stat_df, stat_metadata_df
+
+  def intervals(self, core_id=0, column='count'):
+    """Return a DataFrame with one row per dump of a core (e.g., each PERIODIC_DUMP period) and one column per stat."""
+    idx = np.flatnonzero(np.asarray(self.records['proc_id']) == core_id)
+    df = pd.DataFrame(self.values(idx, column)[:, self.stat_mask],
+                      columns=[name for name, keep in zip(self.names, self.stat_mask) if keep])
+    df.insert(0, 'cycle_count', np.asarray(self.records['cycle_count'][idx]))
+    df.insert(1, 'inst_count', np.asarray(self.records['inst_count'][idx]))
+    return df
+
+class StatBatch:
+  """Final stats of many runs stacked into one (runs x stats x cores) array.
+
+     Requires every run to have a binary stat file written by the same Scarab build (same stat list). Stats and
+     equations are evaluated once over the whole array instead of run by run.
+  """
+  def __init__(self, results_dirs):
+    self.run_names = []
+    self.names = None
+    values = []
+    for results_dir in results_dirs:
+      stat_binary_file = StatBinaryFile.find(results_dir)
+      if not stat_binary_file:
+        if print_warnings:
+          warn("No binary stat file for {} : Skipping...".format(results_dir))
+        continue
+      if self.names is None:
+        self.names = stat_binary_file.names
+        self.num_cores = stat_binary_file.num_cores
+      elif stat_binary_file.names != self.names or stat_binary_file.num_cores != self.num_cores:
+        error("Binary stat file of {} does not match the stat layout of the batch".format(results_dir))
+
+      final = stat_binary_file.final_records()
+      run_values = np.full((len(self.names), self.num_cores), np.nan)
+      run_values[:, final >= 0] = stat_binary_file.values(final[final >= 0]).T
+      values.append(run_values)
+      self.run_names.append(results_dir)
+
+    self.values = np.stack(values) if values else np.empty((0, 0, 0))
+    self.index = {name: ii for ii, name in enumerate(self.names or [])}
+
+  def get(self, stat_name, core_id=0):
+    """Returns a DataFrame with one row per requested stat (or equation) and one column per run.
+
+    Args:
+        stat_name (list of strings): Stat names or equations (<stat_name>=...).
+        core_id (int): The core to select.
+    """
+    rows = {}
+    for stat in stat_name:
+      if "=" in stat:
+        name = stat.split("=")[0].strip()
+        rows[name] = eval_equation_vectorized(stat, name, self.names, np.moveaxis(self.values, 1, 0))[:, core_id]
+      else:
+        rows[stat] = self.values[:, self.index[stat], core_id]
+    return pd.DataFrame.from_dict(rows, orient='index', columns=self.run_names)
+
 #####################################################################
 #####################################################################
 
@@ -0,0 +1,194 @@
+#  Copyright 2020 HPS/SAFARI Research Groups
+#
+#  Permission is hereby granted, free of charge, to any person obtaining a copy of
+#  this software and associated documentation files (the "Software"), to deal in
+#  the Software without restriction, including without limitation the rights to
+#  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+#  of the Software, and to permit persons to whom the Software is furnished to do
+#  so, subject to the following conditions:
+#
+#  The above copyright notice and this permission notice shall be included in all
+#  copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+#  SOFTWARE.
+
+
+"""Generate the header of a PARAMS-specialized Scarab build.
+
+Reads a PARAMS file and writes specialized_params.h, which turns every numeric or Flag parameter set in that file into
+a compile-time constant (see src/globals/param_spec.h). The model parameters the file does not set are compiled in with
+their DEF_PARAM defaults when those are constant expressions; the run control and debug parameters (general.param.def,
+debug.param.def) keep their defaults as runtime values so they can still be given on the command line. --params-only
+limits the build to the parameters set in the PARAMS file. String and table-lookup parameters (bp_mech, frontend, ...)
+stay runtime parameters. The parameter list is taken from src/param_files.def through the C preprocessor, so the
+DEF_PARAM tables stay the only place parameters are declared.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+parser = argparse.ArgumentParser(description="Generate specialized_params.h from a PARAMS file")
+parser.add_argument('params_file', help="PARAMS file whose values are compiled in.")
+parser.add_argument('-o', '--out', required=True, help="Path of the generated header.")
+parser.add_argument('--src', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src"),
+                    help="Scarab src directory.")
+parser.add_argument('--cc', default=os.environ.get("CC", "cc"), help="C compiler used to expand param_files.def.")
+parser.add_argument('--params-only', action='store_true',
+                    help="Only compile in the parameters set in the PARAMS file, not the model defaults.")
+
+# Parameter parse functions (the DEF_PARAM func column) whose values can be compiled in.
+numeric_funcs = {"int", "uns", "uns8", "uns64", "Flag", "float"}
+
+# Parameters the simulator writes after parsing; they must stay variables.
+runtime_written = {"SEGMENT_INSTR_COUNT"}
+
+# .param.def files whose defaults stay runtime values: run control and debugging options are usually given per run.
+runtime_default_files = {"general.param.def", "debug/debug.param.def"}
+
+int_re = re.compile(r"[-+]?(0[xX][0-9a-fA-F]+|\d*)")
+float_re = re.compile(r"[-+]?(\d+\.?\d*([eE][-+]?\d+)?|\.\d+([eE][-+]?\d+)?)?")
+
+def read_param_defs(src, cc):
+  """Returns {option name: (variable, type, func, default, file)} for every DEF_PARAM in the files included by
+  param_files.def."""
+  with open(os.path.join(src, "param_files.def")) as f:
+    param_files = [os.path.normpath(path) for path in re.findall(r'^\s*#include\s+"([^"]+)"', f.read(), re.M)]
+  params = {}
+  for param_file in param_files:
+    stub = ("#define DEF_PARAM(name, variable, type, func, def, const) @@PARAM name|variable|type|func|def@@\n"
+            "#include \"%s\"\n" % param_file)
+    proc = subprocess.run([cc, "-E", "-P", "-I", src, "-x", "c", "-"], input=stub, stdout=subprocess.PIPE,
+                          universal_newlines=True, check=True, cwd=src)
+    for match in re.finditer(r"@@PARAM\s*([^@]*?)\s*@@", proc.stdout):
+      name, variable, ctype, func, default = [field.strip() for field in match.group(1).split("|")]
+      params[name] = (variable, ctype, func, default, param_file)
+  return params
+
+def read_params_file(path):
+  """Returns {option name: value} in the order of the file; later settings win like in param_parser.c."""
+  values = {}
+  with open(path) as f:
+    for line in f:
+      tokens = line.split()
+      if not tokens or tokens[0].startswith("#"):
+        continue
+      if tokens[0] == "--exe":
+        break
+      if not tokens[0].startswith("--"):
+        continue
+      if "=" in tokens[0]:
+        name, value = tokens[0][2:].split("=", 1)
+        values[name] = value
+      else:
+        values[tokens[0][2:]] = tokens[1] if len(tokens) > 1 else None
+  return values
+
+def parse_int(text):
+  """int() with the base rules of strtoul(text, NULL, 0)."""
+  digits = text.lstrip("+-")
+  sign = -1 if text.startswith("-") else 1
+  if not digits:
+    return 0
+  if digits[:2] in ("0x", "0X"):
+    return sign * int(digits, 16)
+  if digits.startswith("0"):
+    return sign * int(digits, 8)
+  return sign * int(digits)
+
+def lookup_param(params, name):
+  """Resolves an option name like getopt_long: an exact match or an unambiguous prefix."""
+  if name in params:
+    return name
+  matches = [option for option in params if option.startswith(name)]
+  if len(matches) != 1:
+    sys.exit("%s parameter '%s'" % ("Ambiguous" if matches else "Unknown", name))
+  return matches[0]
+
+def c_literal(name, func, value):
+  """Converts a PARAMS value the way the get_*_param functions do (strtoul and friends parse the longest numeric
+  prefix and yield 0 without one), warning when part of the value is ignored."""
+  if value is None:
+    sys.exit("Parameter '%s' in the PARAMS file has no value" % name)
+  pattern = float_re if func == "float" else int_re
+  match = pattern.match(value)
+  if match.group(0) != value:
+    print("Warning: parameter '%s' value '%s' read as '%s'" % (name, value, match.group(0) or "0"), file=sys.stderr)
+  if func == "float":
+    return repr(float(match.group(0) or 0))
+  number = parse_int(match.group(0))
+  if func == "Flag":
+    return "1" if number else "0"
+  if func == "int":
+    return str(number)
+  return str(number) + ("ULL" if func == "uns64" else "U")
+
+def default_literal(name, func, default):
+  """Returns the C literal of a DEF_PARAM default made of numbers, TRUE/FALSE and arithmetic, or None if the default
+  depends on anything else (other parameters, enum values, ...)."""
+  text = re.sub(r"\bTRUE\b", "1", re.sub(r"\bFALSE\b", "0", default))
+  if not re.match(r"^[\d\s()*+\-.eExX]*\d[\d\s()*+\-.eExXa-fA-F]*$", text) or re.search(r"\b0\d", text):
+    return None
+  try:
+    value = eval(text, {"__builtins__": {}})
+  except (SyntaxError, NameError, TypeError):
+    return None
+  if func != "float":
+    if value != int(value):
+      return None
+    value = int(value)
+  return c_literal(name, func, str(value))
+
+def main():
+  args = parser.parse_args()
+  params = read_param_defs(os.path.abspath(args.src), args.cc)
+  values = read_params_file(args.params_file)
+
+  specialized = {}
+  skipped = []
+  for name, value in values.items():
+    variable, ctype, func, default, param_file = params[lookup_param(params, name)]
+    if func in numeric_funcs and variable not in runtime_written:
+      specialized[variable] = c_literal(name, func, value)
+    else:
+      skipped.append(variable)
+  from_file = len(specialized)
+
+  if not args.params_only:
+    for name, (variable, ctype, func, default, param_file) in params.items():
+      if (variable in specialized or variable in skipped or func not in numeric_funcs or
+          variable in runtime_written or param_file in runtime_default_files):
+        continue
+      literal = default_literal(name, func, default)
+      if literal is not None:
+        specialized[variable] = literal
+
+  lines = ["/* Generated by bin/scarab_specialize_params.py from %s -- do not edit. */" %
+           os.path.basename(args.params_file), "",
+           "#ifndef __SPECIALIZED_PARAMS_H__", "#define __SPECIALIZED_PARAMS_H__", ""]
+  for variable, literal in specialized.items():
+    lines.append("#define PARAM_SPEC_%s 1" % variable)
+    lines.append("#define PARAM_SPEC_VALUE_%s %s" % (variable, literal))
+  if skipped:
+    lines += ["", "/* Left as runtime parameters: %s */" % " ".join(skipped)]
+  lines += ["", "#endif /* #ifndef __SPECIALIZED_PARAMS_H__ */", ""]
+
+  contents = "\n".join(lines)
+  if os.path.exists(args.out) and open(args.out).read() == contents:
+    return
+  with open(args.out, "w") as f:
+    f.write(contents)
+  print("Specialized %d parameters from %s and %d defaults (%d left as runtime parameters)" %
+        (from_file, args.params_file, len(specialized) - from_file, len(skipped)))
+
+if __name__ == "__main__":
+  main()
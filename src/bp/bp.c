@@ -55,6 +55,7 @@
 #include "frontend/pin_trace_fe.h"
 #include "statistics.h"
 #include "sim.h"
+#include "pc_prof.h"
 
 #include "prefetcher/pref.param.h"
 #include "prefetcher/fdip_new.h"
@@ -82,8 +83,8 @@ extern void tc_do_stat(Op*, Flag);
 /******************************************************************************/
 /* Global Variables */
 
-Bp_Recovery_Info* bp_recovery_info = NULL;
-Bp_Data*          g_bp_data        = NULL;
+CORE_LOCAL Bp_Recovery_Info* bp_recovery_info = NULL;
+CORE_LOCAL Bp_Data*          g_bp_data        = NULL;
 Flag              USE_LATE_BP      = FALSE;
 extern List       op_buf;
 extern uns        operating_mode;
@@ -155,6 +156,9 @@ void bp_sched_recovery(Bp_Recovery_Info* bp_recovery_info, Op* op,
       unsstr64(op->op_num), hexstr64s(op->inst_info->addr),
       hexstr64s(next_fetch_addr), op->off_path);
     inc_bstat_miss(op);
+    if(!op->off_path)
+      PC_PROF_EVENT(op->proc_id, PP_BR_RECOVERY, op->inst_info->addr,
+                    cycle + latency - op->recovery_info.predict_cycle);
     ASSERT(op->proc_id, !op->oracle_info.recovery_sch);
     op->oracle_info.recovery_sch          = TRUE;
     bp_recovery_info->recovery_cycle      = cycle + latency;
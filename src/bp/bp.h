@@ -29,6 +29,7 @@
 #ifndef __BP_H__
 #define __BP_H__
 
+#include "globals/global_defs.h"
 #include "globals/global_types.h"
 #include "libs/cache_lib.h"
 #include "libs/hash_lib.h"
@@ -262,8 +263,8 @@ typedef struct Br_Conf_struct {
 extern Bp                bp_table[];
 extern Bp_Btb            bp_btb_table[];
 extern Bp_Ibtb           bp_ibtb_table[];
-extern Bp_Data*          g_bp_data;
-extern Bp_Recovery_Info* bp_recovery_info;
+extern CORE_LOCAL Bp_Data*          g_bp_data;
+extern CORE_LOCAL Bp_Recovery_Info* bp_recovery_info;
 extern Br_Conf           br_conf_table[];
 
 /**************************************************************************************/
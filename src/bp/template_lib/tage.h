@@ -23,8 +23,14 @@
 #define __TAGE_H_
 
 #include <cmath>
+#include <cstdint>
 #include <vector>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define TAGE_AVX2_FOLDING
+#endif
+
 #include "utils.h"
 
 /* The main history register suitable for very large history. The history is
@@ -139,6 +145,159 @@ class Folded_History {
   int     outpoint_;
 };
 
+/* All the folded histories of a TAGE predictor, stored lane by lane (index
+ * folds, then the two tag folds of every history) so that one update handles
+ * every table at once. Values are bit-identical to Folded_History. Updates
+ * use AVX2 when the host supports it and a plain loop over the lanes
+ * otherwise. */
+template <class TAGE_CONFIG>
+class Folded_History_Bank {
+ public:
+  static constexpr int N     = TAGE_CONFIG::NUM_HISTORIES;
+  static constexpr int LANES = (3 * N + 7) & ~7;  // whole AVX2 vectors
+
+  // allow_avx2 = false forces the lane loop even on AVX2 hosts (for testing).
+  explicit Folded_History_Bank(bool allow_avx2 = true) :
+      value_(), outpoint_(), length_(), length_m1_(), mask_() {
+    for(int lane = 3 * N; lane < LANES; ++lane)
+      length_[lane] = 1;  // padding lanes stay 0
+#ifdef TAGE_AVX2_FOLDING
+    use_avx2_ = allow_avx2 && __builtin_cpu_supports("avx2");
+#else
+    (void)allow_avx2;
+#endif
+  }
+
+  bool uses_avx2() const {
+#ifdef TAGE_AVX2_FOLDING
+    return use_avx2_;
+#else
+    return false;
+#endif
+  }
+
+  void init(int history, int original_length, int index_length,
+            int tag_0_length, int tag_1_length) {
+    original_length_[history] = original_length;
+    init_lane(history, original_length, index_length);
+    init_lane(N + history, original_length, tag_0_length);
+    init_lane(2 * N + history, original_length, tag_1_length);
+  }
+
+  int64_t index(int history) const { return value_[history]; }
+  int64_t tag_0(int history) const { return value_[N + history]; }
+  int64_t tag_1(int history) const { return value_[2 * N + history]; }
+
+  void update(
+    const Long_History_Register<TAGE_CONFIG::MAX_HISTORY_SIZE>& history_register) {
+    alignas(32) int32_t out_bits[LANES];
+    int32_t             in_bit = history_register[0];
+    gather_out_bits(history_register, out_bits);
+#ifdef TAGE_AVX2_FOLDING
+    if(use_avx2_) {
+      update_avx2(in_bit, out_bits);
+      return;
+    }
+#endif
+    for(int lane = 0; lane < LANES; ++lane) {
+      int32_t value = (value_[lane] << 1) ^ in_bit;
+      value ^= out_bits[lane] << outpoint_[lane];
+      value ^= value >> length_[lane];
+      value_[lane] = value & mask_[lane];
+    }
+  }
+
+  void update_reverse(
+    const Long_History_Register<TAGE_CONFIG::MAX_HISTORY_SIZE>& history_register) {
+    alignas(32) int32_t out_bits[LANES];
+    int32_t             in_bit = history_register[0];
+    gather_out_bits(history_register, out_bits);
+#ifdef TAGE_AVX2_FOLDING
+    if(use_avx2_) {
+      update_reverse_avx2(in_bit, out_bits);
+      return;
+    }
+#endif
+    for(int lane = 0; lane < LANES; ++lane) {
+      int32_t value = value_[lane] ^ in_bit;
+      value ^= out_bits[lane] << outpoint_[lane];
+      value = ((value & 1) << length_m1_[lane]) | (value >> 1);
+      value_[lane] = value & mask_[lane];
+    }
+  }
+
+ private:
+  void init_lane(int lane, int original_length, int compressed_length) {
+    outpoint_[lane]  = original_length % compressed_length;
+    length_[lane]    = compressed_length;
+    length_m1_[lane] = compressed_length - 1;
+    mask_[lane]      = (1 << compressed_length) - 1;
+  }
+
+  // The bit leaving each history; the three folds of a history share it.
+  void gather_out_bits(
+    const Long_History_Register<TAGE_CONFIG::MAX_HISTORY_SIZE>& history_register,
+    int32_t* out_bits) const {
+    for(int history = 0; history < N; ++history) {
+      int32_t bit = history_register[original_length_[history]];
+      out_bits[history] = out_bits[N + history] = out_bits[2 * N + history] = bit;
+    }
+    for(int lane = 3 * N; lane < LANES; ++lane)
+      out_bits[lane] = 0;
+  }
+
+#ifdef TAGE_AVX2_FOLDING
+  __attribute__((target("avx2"))) void update_avx2(int32_t        in_bit,
+                                                   const int32_t* out_bits) {
+    __m256i in = _mm256_set1_epi32(in_bit);
+    for(int lane = 0; lane < LANES; lane += 8) {
+      __m256i value = _mm256_load_si256((__m256i*)&value_[lane]);
+      __m256i out   = _mm256_load_si256((const __m256i*)&out_bits[lane]);
+      value = _mm256_xor_si256(_mm256_slli_epi32(value, 1), in);
+      value = _mm256_xor_si256(
+        value, _mm256_sllv_epi32(
+                 out, _mm256_load_si256((__m256i*)&outpoint_[lane])));
+      value = _mm256_xor_si256(
+        value, _mm256_srlv_epi32(
+                 value, _mm256_load_si256((__m256i*)&length_[lane])));
+      value = _mm256_and_si256(value,
+                               _mm256_load_si256((__m256i*)&mask_[lane]));
+      _mm256_store_si256((__m256i*)&value_[lane], value);
+    }
+  }
+
+  __attribute__((target("avx2"))) void update_reverse_avx2(
+    int32_t in_bit, const int32_t* out_bits) {
+    __m256i in  = _mm256_set1_epi32(in_bit);
+    __m256i one = _mm256_set1_epi32(1);
+    for(int lane = 0; lane < LANES; lane += 8) {
+      __m256i value = _mm256_load_si256((__m256i*)&value_[lane]);
+      __m256i out   = _mm256_load_si256((const __m256i*)&out_bits[lane]);
+      value = _mm256_xor_si256(value, in);
+      value = _mm256_xor_si256(
+        value, _mm256_sllv_epi32(
+                 out, _mm256_load_si256((__m256i*)&outpoint_[lane])));
+      value = _mm256_or_si256(
+        _mm256_sllv_epi32(_mm256_and_si256(value, one),
+                          _mm256_load_si256((__m256i*)&length_m1_[lane])),
+        _mm256_srli_epi32(value, 1));
+      value = _mm256_and_si256(value,
+                               _mm256_load_si256((__m256i*)&mask_[lane]));
+      _mm256_store_si256((__m256i*)&value_[lane], value);
+    }
+  }
+
+  bool use_avx2_ = false;
+#endif
+
+  alignas(32) int32_t value_[LANES];
+  alignas(32) int32_t outpoint_[LANES];
+  alignas(32) int32_t length_[LANES];
+  alignas(32) int32_t length_m1_[LANES];
+  alignas(32) int32_t mask_[LANES];
+  int original_length_[N];
+};
+
 template <class TAGE_CONFIG>
 struct Tage_History_Sizes {
   static constexpr int N = TAGE_CONFIG::NUM_HISTORIES;
@@ -266,18 +425,61 @@ class Tage_Histories {
       path_history_ = (path_history_ << 1) ^ (path_hash & 127);
       path_hash >>= 1;
 
+      update_folded_histories();
+    }
+
+    path_history_ = path_history_ &
+                    ((1 << TAGE_CONFIG::PATH_HISTORY_WIDTH) - 1);
+  }
+
+  void intialize_folded_history(void);
+
+  // Folds the bit just pushed into the history (update_folded_histories) or
+  // folds out the bit about to be rewound (update_folded_histories_reverse).
+  void update_folded_histories(void) {
+    if constexpr(TAGE_CONFIG::VECTOR_FOLDED_HISTORIES) {
+      folded_history_bank_.update(history_register_);
+    } else {
       for(int j = 0; j < TAGE_CONFIG::NUM_HISTORIES; ++j) {
         folded_histories_for_indices_[j].update(history_register_);
         folded_histories_for_tags_0_[j].update(history_register_);
         folded_histories_for_tags_1_[j].update(history_register_);
       }
     }
+  }
 
-    path_history_ = path_history_ &
-                    ((1 << TAGE_CONFIG::PATH_HISTORY_WIDTH) - 1);
+  void update_folded_histories_reverse(void) {
+    if constexpr(TAGE_CONFIG::VECTOR_FOLDED_HISTORIES) {
+      folded_history_bank_.update_reverse(history_register_);
+    } else {
+      for(int j = 0; j < TAGE_CONFIG::NUM_HISTORIES; ++j) {
+        folded_histories_for_indices_[j].update_reverse(history_register_);
+        folded_histories_for_tags_0_[j].update_reverse(history_register_);
+        folded_histories_for_tags_1_[j].update_reverse(history_register_);
+      }
+    }
   }
 
-  void intialize_folded_history(void);
+  int64_t folded_index(int j) const {
+    if constexpr(TAGE_CONFIG::VECTOR_FOLDED_HISTORIES)
+      return folded_history_bank_.index(j);
+    else
+      return folded_histories_for_indices_[j].get_value();
+  }
+
+  int64_t folded_tag_0(int j) const {
+    if constexpr(TAGE_CONFIG::VECTOR_FOLDED_HISTORIES)
+      return folded_history_bank_.tag_0(j);
+    else
+      return folded_histories_for_tags_0_[j].get_value();
+  }
+
+  int64_t folded_tag_1(int j) const {
+    if constexpr(TAGE_CONFIG::VECTOR_FOLDED_HISTORIES)
+      return folded_history_bank_.tag_1(j);
+    else
+      return folded_histories_for_tags_1_[j].get_value();
+  }
 
   // Hash function for the path history used in creating table indices.
   int64_t compute_path_hash(int64_t path_history, int max_width, int bank,
@@ -296,6 +498,7 @@ class Tage_Histories {
     folded_histories_for_tags_0_;
   std::vector<Folded_History<TAGE_CONFIG::MAX_HISTORY_SIZE>>
     folded_histories_for_tags_1_;
+  Folded_History_Bank<TAGE_CONFIG> folded_history_bank_;  // if VECTOR_FOLDED_HISTORIES
 
   int64_t path_history_;
   int64_t head_old_;
@@ -587,14 +790,7 @@ class Tage {
       (prediction_info.global_history_head_checkpoint_ -
        tage_histories_.history_register_.head_idx());
     for(int i = 0; i < num_flushed_bits; ++i) {
-      for(int j = 0; j < TAGE_CONFIG::NUM_HISTORIES; ++j) {
-        tage_histories_.folded_histories_for_indices_[j].update_reverse(
-          tage_histories_.history_register_);
-        tage_histories_.folded_histories_for_tags_0_[j].update_reverse(
-          tage_histories_.history_register_);
-        tage_histories_.folded_histories_for_tags_1_[j].update_reverse(
-          tage_histories_.history_register_);
-      }
+      tage_histories_.update_folded_histories_reverse();
       tage_histories_.history_register_.rewind(1);
     }
     tage_histories_.path_history_ = prediction_info.path_history_checkpoint;
@@ -696,6 +892,11 @@ void Tage_Histories<TAGE_CONFIG>::intialize_folded_history(void) {
     // REVISIT: since I got rid of LOG_ENTRIES_PER_BANK as a constant, this
     // should be fine now.
     const int LOG_ENTRIES_PER_BANK2 = TAGE_CONFIG::LOG_ENTRIES_PER_BANK;
+    if constexpr(TAGE_CONFIG::VECTOR_FOLDED_HISTORIES) {
+      folded_history_bank_.init(i, history_sizes_.arr[i], LOG_ENTRIES_PER_BANK2,
+                                tag_bits_.arr[i], tag_bits_.arr[i] - 1);
+      continue;
+    }
     folded_histories_for_indices_.emplace_back(history_sizes_.arr[i],
                                                LOG_ENTRIES_PER_BANK2);
     folded_histories_for_tags_0_.emplace_back(history_sizes_.arr[i],
@@ -757,18 +958,14 @@ void Tage<TAGE_CONFIG>::fill_table_indices_tags(
         TAGE_CONFIG::LOG_ENTRIES_PER_BANK);
       int64_t index = br_pc;
       index ^= br_pc >> (std::abs(TAGE_CONFIG::LOG_ENTRIES_PER_BANK - i) + 1);
-      index ^=
-        tage_histories_.folded_histories_for_indices_[(i - 1) / 2].get_value();
+      index ^= tage_histories_.folded_index((i - 1) / 2);
       index ^= path_hash;
       output->indices[i] = index &
                            ((1 << TAGE_CONFIG::LOG_ENTRIES_PER_BANK) - 1);
 
       int64_t tag = br_pc;
-      tag ^=
-        tage_histories_.folded_histories_for_tags_0_[(i - 1) / 2].get_value();
-      tag ^=
-        tage_histories_.folded_histories_for_tags_1_[(i - 1) / 2].get_value()
-        << 1;
+      tag ^= tage_histories_.folded_tag_0((i - 1) / 2);
+      tag ^= tage_histories_.folded_tag_1((i - 1) / 2) << 1;
       output->tags[i] = tag &
                         ((1 << tage_histories_.tag_bits_.arr[(i - 1) / 2]) - 1);
 
@@ -48,6 +48,8 @@ struct TAGE_SC_L_CONFIG_64KB {
     static constexpr int ALT_SELECTOR_ENTRY_WIDTH    = 5;
     static constexpr int BIMODAL_HYSTERESIS_SHIFT    = 2;
     static constexpr int BIMODAL_LOG_TABLES_SIZE     = 13;
+    // fold all histories at once (Folded_History_Bank) instead of one by one
+    static constexpr bool VECTOR_FOLDED_HISTORIES    = true;
   };
 
   struct LOOP {
@@ -158,6 +160,8 @@ struct TAGE_SC_L_CONFIG_80KB {
     static constexpr int ALT_SELECTOR_ENTRY_WIDTH    = 5;
     static constexpr int BIMODAL_HYSTERESIS_SHIFT    = 2;
     static constexpr int BIMODAL_LOG_TABLES_SIZE     = 13;
+    // fold all histories at once (Folded_History_Bank) instead of one by one
+    static constexpr bool VECTOR_FOLDED_HISTORIES    = true;
   };
 
   struct LOOP {
@@ -41,25 +41,26 @@
 #include "globals/assert.h"
 #include "memory/cache_part.h"
 #include "memory/memory.param.h"
+#include "memory/tlb.h"
 #include "op_pool.h"
 #include "prefetcher/pref.param.h"
 #include "prefetcher/pref_common.h"
 /*#include "prefetcher/fdip.h"*/
 #include "prefetcher/fdip_new.h"
-#include "prefetcher/eip.h"
-#include "prefetcher/D_JOLT.h"
-#include "prefetcher/FNL+MMA.h"
+#include "prefetcher/pref_plugin.h"
 #include "sim.h"
 #include "statistics.h"
 
 #include "freq.h"
+#include "host_prof.h"
 #include "uop_queue_stage.h"
 #include "decoupled_frontend.h"
 
 /**************************************************************************************/
 /* Global vars */
 
-Cmp_Model cmp_model;
+Cmp_Model                cmp_model;
+CORE_LOCAL Core_Context* core_context = NULL;
 Flag perf_pred_started = FALSE;
 
 /**************************************************************************************/
@@ -121,6 +122,8 @@ void cmp_init(uns mode) {
 
     init_dcache_stage(proc_id, "DCACHE");
 
+    init_tlb(proc_id);
+
     /* initialize the common data structures */
     init_bp_recovery_info(proc_id, &cmp_model.bp_recovery_info[proc_id]);
     init_bp_data(proc_id, &cmp_model.bp_data[proc_id]);
@@ -129,9 +132,7 @@ void cmp_init(uns mode) {
     init_decoupled_fe(proc_id, "DCFE");
 
     init_fdip(proc_id);
-    init_eip(proc_id);
-    init_djolt(proc_id);
-    init_fnlmma(proc_id);
+    init_pref_plugin(proc_id);
   }
 
   cmp_model.window_size = NODE_TABLE_SIZE;
@@ -167,6 +168,7 @@ void cmp_reset() {
     reset_node_stage();
     reset_exec_stage();
     reset_dcache_stage();
+    reset_tlb(proc_id);
   }
   reset_memory();
 }
@@ -194,16 +196,15 @@ void cmp_istreams(void) {
       continue;
 
     if(freq_is_ready(FREQ_DOMAIN_CORES[proc_id])) {
-      cycle_count = freq_cycle_count(FREQ_DOMAIN_CORES[proc_id]);
+      Core_Context* core = &cmp_model.core_contexts[proc_id];
+      cycle_count        = freq_cycle_count(FREQ_DOMAIN_CORES[proc_id]);
 
-      set_bp_recovery_info(&cmp_model.bp_recovery_info[proc_id]);
-      if(cycle_count >= bp_recovery_info->recovery_cycle) {
-        set_bp_data(&cmp_model.bp_data[proc_id]);
-        cmp_set_all_stages(proc_id);
+      if(cycle_count >= core->bp_recovery_info->recovery_cycle) {
+        cmp_set_core_context(core);
         cmp_recover();
       }
-      if(cycle_count >= bp_recovery_info->redirect_cycle) {
-        set_icache_stage(&cmp_model.icache_stage[proc_id]);
+      if(cycle_count >= core->bp_recovery_info->redirect_cycle) {
+        cmp_set_core_context(core);
         ASSERT(proc_id, proc_id == bp_recovery_info->redirect_op->proc_id);
         ASSERT_PROC_ID_IN_ADDR(
           proc_id, bp_recovery_info->redirect_op->oracle_info.pred_npc);
@@ -220,14 +221,12 @@ void cmp_cores(void) {
 
     if(freq_is_ready(FREQ_DOMAIN_CORES[proc_id])) {
       cycle_count = freq_cycle_count(FREQ_DOMAIN_CORES[proc_id]);
+      cmp_set_core_context(&cmp_model.core_contexts[proc_id]);
 
-      set_bp_data(&cmp_model.bp_data[proc_id]);
-      set_bp_recovery_info(&cmp_model.bp_recovery_info[proc_id]);
-      cmp_set_all_stages(proc_id);
-
-      update_dcache_stage(&exec->sd);
-      update_exec_stage(&node->sd);
-      update_node_stage(map->last_sd);
+      update_tlb(proc_id);
+      HOST_PROF_TIME(HP_DCACHE, update_dcache_stage(&exec->sd));
+      HOST_PROF_TIME(HP_EXEC, update_exec_stage(&node->sd));
+      HOST_PROF_TIME(HP_NODE, update_node_stage(map->last_sd));
       // Map stage can get ops from either the uop queue following the uop cache
       // or the decoder.
       Stage_Data* map_stage_uop_cache_src = NULL;
@@ -236,15 +235,15 @@ void cmp_cores(void) {
       }
       // doesnt work: decode_stage_process_op must be called once per op. For uop cache, one cycle after fetch.
       // I can add a flag: decode_cycle (cycle decoded).
-      update_map_stage(dec->last_sd, map_stage_uop_cache_src);
-      update_uop_queue_stage(&ic->uopc_sd);
-      update_decode_stage(&ic->sd);
-      update_decoupled_fe();
-      update_fdip();
-      update_eip();
-      update_icache_stage();
+      HOST_PROF_TIME(HP_MAP, update_map_stage(dec->last_sd, map_stage_uop_cache_src));
+      HOST_PROF_TIME(HP_UOP_QUEUE, update_uop_queue_stage(&ic->uopc_sd));
+      HOST_PROF_TIME(HP_DECODE, update_decode_stage(&ic->sd));
+      HOST_PROF_TIME(HP_DECOUPLED_FE, update_decoupled_fe());
+      HOST_PROF_TIME(HP_FDIP, update_fdip());
+      HOST_PROF_TIME(HP_ICACHE, update_icache_stage());
+      HOST_PROF_TIME(HP_PREF_PLUGIN, update_pref_plugin(proc_id));
 
-      node_sched_ops();
+      HOST_PROF_TIME(HP_NODE_SCHED, node_sched_ops());
 
       cmp_measure_chip_util();
     }
@@ -458,6 +457,7 @@ void cmp_warmup(Op* op) {
   if(WP_COLLECT_STATS)
     line_info = (Icache_Data*)cache_access(&ic->icache_line_info, ia, &dummy_line_addr2, TRUE);
 
+  tlb_warmup(proc_id, TLB_INST, ia, warmup_uncore);
   if(ic_data == NULL) {
     warmup_uncore(proc_id, ia, FALSE);
     Addr repl_line_addr;
@@ -483,6 +483,7 @@ void cmp_warmup(Op* op) {
   Flag is_load  = op->table_info->mem_type == MEM_LD;
   Flag is_store = op->table_info->mem_type == MEM_ST;
   if(is_load || is_store) {
+    tlb_warmup(proc_id, TLB_DATA, va, warmup_uncore);
     Cache*       dcache  = &(cmp_model.dcache_stage[proc_id].dcache);
     Dcache_Data* dc_data = cache_access(dcache, va, &dummy_line_addr, TRUE);
     if(dc_data) {
@@ -47,6 +47,23 @@
 /**************************************************************************************/
 /* cmp model data  */
 
+/* Core_Context: the state of one core. The stage functions work on the core
+   selected with cmp_set_core_context(), whose state pointers (td, ic, dc,
+   node, ...) are thread local, so different host threads can work on
+   different cores. */
+typedef struct Core_Context_struct {
+  uns8              proc_id;
+  Thread_Data*      thread_data;
+  Bp_Data*          bp_data;
+  Bp_Recovery_Info* bp_recovery_info;
+  Icache_Stage*     icache_stage;
+  Decode_Stage*     decode_stage;
+  Map_Stage*        map_stage;
+  Node_Stage*       node_stage;
+  Exec_Stage*       exec_stage;
+  Dcache_Stage*     dcache_stage;
+} Core_Context;
+
 typedef struct Cmp_Model_struct {
   Thread_Data* thread_data;  // cmp: one thread for each core,
   // "single_td" in sim.c is only for single core
@@ -64,6 +81,8 @@ typedef struct Cmp_Model_struct {
   Exec_Stage*   exec_stage;
   Dcache_Stage* dcache_stage;
 
+  Core_Context* core_contexts;
+
   uns window_size;
 
 } Cmp_Model;
@@ -72,6 +91,9 @@ typedef struct Cmp_Model_struct {
 /* Global vars */
 
 extern Cmp_Model cmp_model;
+/* core selected by this host thread, NULL after a single stage of another
+   core was selected (see set_icache_stage and friends) */
+extern CORE_LOCAL Core_Context* core_context;
 
 /**************************************************************************************/
 /* Prototypes */
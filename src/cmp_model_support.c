@@ -35,9 +35,7 @@
 #include "globals/utils.h"
 #include "statistics.h"
 #include "prefetcher/fdip_new.h"
-#include "prefetcher/eip.h"
-#include "prefetcher/D_JOLT.h"
-#include "prefetcher/FNL+MMA.h"
+#include "prefetcher/pref_plugin.h"
 
 /**************************************************************************************/
 /* cmp_init_cmp_model  */
@@ -62,38 +60,65 @@ void cmp_init_cmp_model() {
                                                  NUM_CORES);
   alloc_mem_decoupled_fe(NUM_CORES);
   alloc_mem_fdip(NUM_CORES);
-  alloc_mem_eip(NUM_CORES);
-  alloc_mem_djolt(NUM_CORES);
-  alloc_mem_fnlmma(NUM_CORES);
+  alloc_mem_pref_plugin(NUM_CORES);
   alloc_mem_uop_cache(NUM_CORES);
+
+  cmp_model.core_contexts = (Core_Context*)malloc(sizeof(Core_Context) *
+                                                  NUM_CORES);
+  for(uns8 proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    Core_Context* core     = &cmp_model.core_contexts[proc_id];
+    core->proc_id          = proc_id;
+    core->thread_data      = &cmp_model.thread_data[proc_id];
+    core->bp_data          = &cmp_model.bp_data[proc_id];
+    core->bp_recovery_info = &cmp_model.bp_recovery_info[proc_id];
+    core->icache_stage     = &cmp_model.icache_stage[proc_id];
+    core->decode_stage     = &cmp_model.decode_stage[proc_id];
+    core->map_stage        = &cmp_model.map_stage[proc_id];
+    core->node_stage       = &cmp_model.node_stage[proc_id];
+    core->exec_stage       = &cmp_model.exec_stage[proc_id];
+    core->dcache_stage     = &cmp_model.dcache_stage[proc_id];
+  }
 }
 
 
 void cmp_init_thread_data(uns8 proc_id) {
   td->proc_id = proc_id;
   init_map(proc_id);
+  init_lsq(proc_id);
   init_list(&td->seq_op_list, "SEQ_OP_LIST", sizeof(Op*), TRUE);
 }
 
 
 /**************************************************************************************/
-/* cmp_set_all_stages  */
-void cmp_set_all_stages(uns8 proc_id) {
-  set_thread_data(&cmp_model.thread_data[proc_id]);
+/* cmp_set_core_context: makes core the one the stage functions of this host
+   thread work on. Nothing needs to be done if it is already selected. */
+void cmp_set_core_context(Core_Context* core) {
+  if(core_context == core)
+    return;
+
+  set_thread_data(core->thread_data);
   set_map_data(&td->map_data);
+  set_lsq_data(&td->lsq_data);
+  set_bp_data(core->bp_data);
+  set_bp_recovery_info(core->bp_recovery_info);
+
+  set_fdip(core->proc_id, core->icache_stage);
+  set_decoupled_fe(core->proc_id);
+  set_uop_cache(core->proc_id);
+  set_icache_stage(core->icache_stage);
+  set_decode_stage(core->decode_stage);
+  set_map_stage(core->map_stage);
+  set_node_stage(core->node_stage);
+  set_exec_stage(core->exec_stage);
+  set_dcache_stage(core->dcache_stage);
+
+  core_context = core;
+}
 
-  set_eip(proc_id);
-  set_djolt(proc_id);
-  set_fnlmma(proc_id);
-  set_fdip(proc_id, &cmp_model.icache_stage[proc_id]);
-  set_decoupled_fe(proc_id);
-  set_uop_cache(proc_id);
-  set_icache_stage(&cmp_model.icache_stage[proc_id]);
-  set_decode_stage(&cmp_model.decode_stage[proc_id]);
-  set_map_stage(&cmp_model.map_stage[proc_id]);
-  set_node_stage(&cmp_model.node_stage[proc_id]);
-  set_exec_stage(&cmp_model.exec_stage[proc_id]);
-  set_dcache_stage(&cmp_model.dcache_stage[proc_id]);
+/**************************************************************************************/
+/* cmp_set_all_stages  */
+void cmp_set_all_stages(uns8 proc_id) {
+  cmp_set_core_context(&cmp_model.core_contexts[proc_id]);
 }
 
 /**************************************************************************************/
@@ -120,6 +145,7 @@ void cmp_init_bogus_sim(uns8 proc_id) {
 
   reset_seq_op_list(td);
   reset_map();
+  reset_lsq();
 
   reset_all_ops_icache_stage();
   reset_decode_stage();
@@ -32,12 +32,18 @@
 
 #include "globals/global_types.h"
 
+/**************************************************************************************/
+/* Forward Declarations */
+
+struct Core_Context_struct;
+
 /**************************************************************************************/
 /* Prototypes */
 
 void cmp_init_cmp_model(void);
 void cmp_init_thread_data(uns8);
 void cmp_set_all_stages(uns8);
+void cmp_set_core_context(struct Core_Context_struct*);
 void cmp_init_bogus_sim(uns8);
 /**************************************************************************************/
 /* External variables */
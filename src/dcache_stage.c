@@ -36,6 +36,8 @@
 
 #include "bp/bp.h"
 #include "dcache_stage.h"
+#include "lsq.h"
+#include "memory/tlb.h"
 #include "map.h"
 #include "model.h"
 
@@ -45,6 +47,7 @@
 #include "prefetcher//stream.param.h"
 #include "prefetcher/pref.param.h"
 #include "prefetcher/pref_common.h"
+#include "prefetcher/pref_plugin.h"
 #include "prefetcher/stream_pref.h"
 #include "statistics.h"
 
@@ -61,12 +64,14 @@
 /**************************************************************************************/
 /* Global Variables */
 
-Dcache_Stage* dc = NULL;
+CORE_LOCAL Dcache_Stage* dc = NULL;
 
 /**************************************************************************************/
 /* set_dcache_stage: */
 
 void set_dcache_stage(Dcache_Stage* new_dc) {
+  if(new_dc != dc)
+    core_context = NULL; /* only one stage of another core is selected */
   dc = new_dc;
 }
 
@@ -88,6 +93,7 @@ void init_dcache_stage(uns8 proc_id, const char* name) {
 
   dc->sd.max_op_count = STAGE_MAX_OP_COUNT;
   dc->sd.ops          = (Op**)malloc(sizeof(Op*) * STAGE_MAX_OP_COUNT);
+  dc->age_order       = (uns*)malloc(sizeof(uns) * STAGE_MAX_OP_COUNT);
 
   /* initialize the cache structure */
   init_cache(&dc->dcache, "DCACHE", DCACHE_SIZE, DCACHE_ASSOC, DCACHE_LINE_SIZE,
@@ -95,6 +101,8 @@ void init_dcache_stage(uns8 proc_id, const char* name) {
 
   reset_dcache_stage();
 
+  /* full ports are tracked in one bit per bank */
+  ASSERTM(proc_id, DCACHE_BANKS <= 64, "At most 64 dcache banks supported\n");
   dc->ports = (Ports*)malloc(sizeof(Ports) * DCACHE_BANKS);
   for(ii = 0; ii < DCACHE_BANKS; ii++) {
     char name[MAX_STR_LENGTH + 1];
@@ -156,9 +164,7 @@ void debug_dcache_stage() {
 /* update_dcache_stage: */
 void update_dcache_stage(Stage_Data* src_sd) {
   Dcache_Data* line;
-  Counter      oldest_op_num, last_oldest_op_num;
-  uns          oldest_index;
-  int          start_op_count;
+  uns          num_ordered = 0;
   Addr         line_addr;
   uns          ii, jj;
 
@@ -227,30 +233,30 @@ void update_dcache_stage(Stage_Data* src_sd) {
     }
     ASSERTM(dc->proc_id, cycle_count >= op->exec_cycle, "o:%s  %s\n",
             unsstr64(op->op_num), Op_State_str(op->state));
+
+    /* insert the slot into the age order (the stage holds at most NUM_FUS
+       ops, so insertion sort is cheapest) */
+    for(jj = num_ordered; jj > 0 &&
+                          dc->sd.ops[dc->age_order[jj - 1]]->op_num > op->op_num;
+        jj--)
+      dc->age_order[jj] = dc->age_order[jj - 1];
+    dc->age_order[jj] = ii;
+    num_ordered++;
   }
+  ASSERT(dc->proc_id, (int)num_ordered == dc->sd.op_count);
   // }}}
 
   // {{{ phase 2 - update in program order (make things easier)
-  start_op_count     = dc->sd.op_count;
-  last_oldest_op_num = 0;
-  for(ii = 0; ii < start_op_count; ii++) {
-    Op*  op;
-    uns  bank;
-    Flag wrongpath_dcmiss = FALSE;
-
-    oldest_index  = 0;
-    oldest_op_num = MAX_CTR;
-    for(jj = 0; jj < dc->sd.max_op_count; jj++)
-      if(dc->sd.ops[jj] && dc->sd.ops[jj]->op_num > last_oldest_op_num &&
-         dc->sd.ops[jj]->op_num < oldest_op_num) {
-        oldest_op_num = dc->sd.ops[jj]->op_num;
-        oldest_index  = jj;
-      }
-    last_oldest_op_num = oldest_op_num;
-
-    ASSERT(dc->proc_id, oldest_op_num < MAX_CTR);
-
-    op = dc->sd.ops[oldest_index];
+  /* port usage only grows within a cycle, so a bank that ran out of ports
+     stays out of them for the rest of the cycle */
+  dc->read_ports_full  = 0;
+  dc->write_ports_full = 0;
+  for(ii = 0; ii < num_ordered; ii++) {
+    uns   oldest_index = dc->age_order[ii];
+    Op*   op           = dc->sd.ops[oldest_index];
+    uns   bank;
+    uns64 bank_bit;
+    Flag  wrongpath_dcmiss = FALSE;
 
     if(op->replay && op->exec_cycle == MAX_CTR) {
       // the op is replaying, squish it
@@ -267,10 +273,17 @@ void update_dcache_stage(Stage_Data* src_sd) {
     DEBUG(dc->proc_id,
           "check_read and write port availiabilty mem_type:%s bank:%d \n",
           (op->table_info->mem_type == MEM_ST) ? "ST" : "LD", bank);
-    if(!PERFECT_DCACHE && ((op->table_info->mem_type == MEM_ST &&
-                            !get_write_port(&dc->ports[bank])) ||
-                           (op->table_info->mem_type != MEM_ST &&
-                            !get_read_port(&dc->ports[bank])))) {
+    bank_bit = 1ULL << bank;
+    if(!PERFECT_DCACHE && op->table_info->mem_type == MEM_ST &&
+       ((dc->write_ports_full & bank_bit) ||
+        !get_write_port(&dc->ports[bank]))) {
+      dc->write_ports_full |= bank_bit;
+      op->state = OS_WAIT_DCACHE;
+      continue;
+    } else if(!PERFECT_DCACHE && op->table_info->mem_type != MEM_ST &&
+              ((dc->read_ports_full & bank_bit) ||
+               !get_read_port(&dc->ports[bank]))) {
+      dc->read_ports_full |= bank_bit;
       op->state = OS_WAIT_DCACHE;
       continue;
     } else {
@@ -278,6 +291,30 @@ void update_dcache_stage(Stage_Data* src_sd) {
                                  // they can be removed from the node->rdy_list
     }
 
+    /* translate the address; on a TLB miss the op keeps its slot and retries
+       until the page walk is done */
+    if(TLB_ENABLE && !tlb_translate(dc->proc_id, TLB_DATA, op->oracle_info.va,
+                                    op->off_path, op->tlb_miss)) {
+      STAT_EVENT(op->proc_id, DCACHE_STAGE_TLB_STALL);
+      op->tlb_miss = TRUE;
+      op->state    = OS_WAIT_DCACHE;
+      continue;
+    }
+
+    /* loads contained in an older in-flight store get their data from the
+       store queue; partial overlaps and order violations access the cache
+       with op->lsq_penalty added on top */
+    if(LSQ_ENABLE && !PERFECT_DCACHE && op->table_info->mem_type == MEM_LD) {
+      uns lsq_latency;
+      if(lsq_load_exec(op, &lsq_latency)) {
+        op->dcache_cycle = cycle_count;
+        op->done_cycle   = cycle_count + lsq_latency;
+        op->wake_cycle   = op->done_cycle;
+        wake_up_ops(op, REG_DATA_DEP, model->wake_hook);
+        continue;
+      }
+    }
+
     // ideal l2 l1 prefetcher bring l1 data immediately
     if(IDEAL_L2_L1_PREFETCHER)
       ideal_l2l1_prefetcher(op);
@@ -315,6 +352,9 @@ void update_dcache_stage(Stage_Data* src_sd) {
         wake_up_ops(op, REG_DATA_DEP, model->wake_hook);
       }
     } else if(line) {  // data cache hit
+      pref_plugin_operate(dc->proc_id, PREF_PLUGIN_L1D, op->oracle_info.va,
+                          op->inst_info->addr, TRUE, line->HW_prefetch,
+                          op->off_path);
 
       if(PREF_FRAMEWORK_ON &&  // if framework is on use new prefetcher.
                                // otherwise old one
@@ -352,7 +392,7 @@ void update_dcache_stage(Stage_Data* src_sd) {
         STAT_EVENT(op->proc_id, DCACHE_HIT_OFFPATH);
 
       op->done_cycle = cycle_count + DCACHE_CYCLES +
-                       op->inst_info->extra_ld_latency;
+                       op->inst_info->extra_ld_latency + op->lsq_penalty;
 
       if(!op->off_path) {
         line->dirty |= op->table_info->mem_type == MEM_ST;
@@ -386,18 +426,21 @@ void update_dcache_stage(Stage_Data* src_sd) {
           } else
             STAT_EVENT(op->proc_id, DCACHE_ST_BUFFER_HIT_OFFPATH);
           op->done_cycle = cycle_count + DCACHE_CYCLES +
-                           op->inst_info->extra_ld_latency;
-          op->wake_cycle = cycle_count + DCACHE_CYCLES +
-                           op->inst_info->extra_ld_latency;
+                           op->inst_info->extra_ld_latency + op->lsq_penalty;
+          op->wake_cycle = op->done_cycle;
           wake_up_ops(op, REG_DATA_DEP, model->wake_hook);
         } else if(((model->mem == MODEL_MEM) &&
-                   new_mem_req(
-                     MRT_DFETCH, dc->proc_id, line_addr, DCACHE_LINE_SIZE,
-                     DCACHE_CYCLES - 1 + op->inst_info->extra_ld_latency, op,
-                     dcache_fill_line, op->unique_num, 0))) {
+                   new_mem_req(MRT_DFETCH, dc->proc_id, line_addr,
+                               DCACHE_LINE_SIZE,
+                               DCACHE_CYCLES - 1 +
+                                 op->inst_info->extra_ld_latency +
+                                 op->lsq_penalty,
+                               op, dcache_fill_line, op->unique_num, 0))) {
           if(PREF_UPDATE_ON_WRONGPATH || !op->off_path) {
             pref_dl0_miss(line_addr, op->inst_info->addr);
           }
+          pref_plugin_operate(dc->proc_id, PREF_PLUGIN_L1D, op->oracle_info.va,
+                              op->inst_info->addr, FALSE, FALSE, op->off_path);
 
           if(ONE_MORE_CACHE_LINE_ENABLE) {
             Addr         one_more_addr;
@@ -512,6 +555,8 @@ void update_dcache_stage(Stage_Data* src_sd) {
             new_mem_req(MRT_DSTORE, dc->proc_id, line_addr, DCACHE_LINE_SIZE,
                         DCACHE_CYCLES - 1 + op->inst_info->extra_ld_latency, op,
                         dcache_fill_line, op->unique_num, 0))) {
+          pref_plugin_operate(dc->proc_id, PREF_PLUGIN_L1D, op->oracle_info.va,
+                              op->inst_info->addr, FALSE, FALSE, op->off_path);
           if(ONE_MORE_CACHE_LINE_ENABLE) {
             Addr         one_more_addr;
             Addr         extra_line_addr;
@@ -677,6 +722,8 @@ Flag dcache_fill_line(Mem_Req* req) {
 
     data = (Dcache_Data*)cache_insert(&dc->dcache, dc->proc_id, req->addr,
                                       &line_addr, &repl_line_addr);
+    pref_plugin_cache_fill(dc->proc_id, PREF_PLUGIN_L1D, req->addr,
+                           repl_line_addr);
     DEBUG(dc->proc_id,
           "Filling dcache  off_path:%d addr:0x%s  :%7d index:%7d op_count:%d "
           "oldest:%lld\n",
@@ -29,6 +29,7 @@
 #ifndef __DCACHE_STAGE_H__
 #define __DCACHE_STAGE_H__
 
+#include "globals/global_defs.h"
 #include "libs/cache_lib.h"
 #include "stage_data.h"
 
@@ -49,6 +50,11 @@ typedef struct Dcache_Stage_struct {
   Ports* ports;       /* read and write ports to the data cache (per bank) */
   Cache  pref_dcache; /* prefetcher cache for data cache */
 
+  uns* age_order; /* slots of sd.ops holding an op, oldest op first (rebuilt
+                    every cycle by update_dcache_stage) */
+  uns64 read_ports_full;  /* banks with no read port left this cycle */
+  uns64 write_ports_full; /* banks with no write port left this cycle */
+
   Counter idle_cycle;  /* Cycle the cache will be idle */
   Flag    mem_blocked; /* Are memory request buffers (aka MSHRs) full? */
 
@@ -82,7 +88,7 @@ typedef struct Dcache_Data_struct {
 /**************************************************************************************/
 /* External variables */
 
-extern Dcache_Stage* dc;
+extern CORE_LOCAL Dcache_Stage* dc;
 
 /**************************************************************************************/
 /* Prototypes */
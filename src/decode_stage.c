@@ -63,7 +63,7 @@
 /**************************************************************************************/
 /* Global Variables */
 
-Decode_Stage* dec = NULL;
+CORE_LOCAL Decode_Stage* dec = NULL;
 bool decode_off_path;
 
 /**************************************************************************************/
@@ -29,6 +29,7 @@
 #ifndef __DECODE_STAGE_H__
 #define __DECODE_STAGE_H__
 
+#include "globals/global_defs.h"
 #include "stage_data.h"
 
 
@@ -47,7 +48,7 @@ typedef struct Decode_Stage_struct {
 /**************************************************************************************/
 /* External Variables */
 
-extern Decode_Stage* dec;
+extern CORE_LOCAL Decode_Stage* dec;
 
 
 /**************************************************************************************/
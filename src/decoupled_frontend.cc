@@ -6,6 +6,7 @@
 #include "isa/isa_macros.h"
 #include "prefetcher/pref.param.h"
 #include "memory/memory.param.h"
+#include "host_prof.h"
 
 #include <deque>
 #include <vector>
@@ -47,13 +48,15 @@ std::vector<uint64_t> per_core_recovery_addr;
 std::vector<uint64_t> per_core_redirect_cycle;
 std::vector<bool> per_core_stalled;
 std::vector<uint64_t> per_core_ftq_ft_num;
+// stop fetching new FTs, used to drain the pipeline (e.g. between samples)
+std::vector<bool> per_core_fetch_gated;
 
 //per_core pointers
-std::deque<FT> *df_ftq;
-int *off_path;
-int *sched_off_path;
-int set_proc_id;
-std::vector<decoupled_fe_iter> *ftq_iterator;
+CORE_LOCAL std::deque<FT> *df_ftq;
+CORE_LOCAL int *off_path;
+CORE_LOCAL int *sched_off_path;
+CORE_LOCAL int set_proc_id;
+CORE_LOCAL std::vector<decoupled_fe_iter> *ftq_iterator;
 //need to overwrite op->op_num with decoupeld fe
 
 bool trace_mode;
@@ -70,6 +73,7 @@ void alloc_mem_decoupled_fe(uns numCores) {
   per_core_redirect_cycle.resize(numCores);
   per_core_stalled.resize(numCores);
   per_core_ftq_ft_num.resize(numCores);
+  per_core_fetch_gated.resize(numCores);
 }
 
 void init_decoupled_fe(uns proc_id, const char*) {
@@ -85,6 +89,7 @@ void init_decoupled_fe(uns proc_id, const char*) {
   per_core_recovery_addr[proc_id] = 0;
   per_core_redirect_cycle[proc_id] = 0;
   per_core_ftq_ft_num[proc_id] = FE_FTQ_BLOCK_NUM;
+  per_core_fetch_gated[proc_id] = false;
 
 }
 
@@ -97,7 +102,26 @@ void set_decoupled_fe(int proc_id) {
 }
 
 
-void reset_decoupled_fe() {}
+/* Only valid on a drained pipeline: op numbering resumes after the last retired op */
+void reset_decoupled_fe() {
+  for (auto it = df_ftq->begin(); it != df_ftq->end(); it++) {
+    it->ft_free_ops_and_clear();
+  }
+  df_ftq->clear();
+  per_core_current_ft_to_push[set_proc_id].ft_free_ops_and_clear();
+  per_core_current_ft_in_use[set_proc_id].ft_free_ops_and_clear();
+  for (auto it = ftq_iterator->begin(); it != ftq_iterator->end(); it++) {
+    it->ft_pos = 0;
+    it->op_pos = 0;
+    it->flattened_op_pos = 0;
+  }
+
+  *off_path = false;
+  *sched_off_path = false;
+  per_core_stalled[set_proc_id] = false;
+  per_core_redirect_cycle[set_proc_id] = 0;
+  per_core_op_count[set_proc_id] = uop_count[set_proc_id] + 1;
+}
 
 void recover_decoupled_fe(int proc_id) {
   per_core_off_path[proc_id] = false;
@@ -214,6 +238,12 @@ void update_decoupled_fe() {
         STAT_EVENT(set_proc_id, FTQ_BREAK_BAR_FETCH_ONPATH);
       break;
     }
+    // only stop between FTs so that the frontend is left at an instruction boundary
+    if (per_core_fetch_gated[set_proc_id] && per_core_current_ft_to_push[set_proc_id].ops.empty()) {
+      DEBUG(set_proc_id, "Break due to gated fetch\n");
+      fwd_progress = 0;
+      break;
+    }
     if (!frontend_can_fetch_op(set_proc_id)) {
       std::cout << "Warning could not fetch inst from frontend" << std::endl;
       break;
@@ -222,7 +252,7 @@ void update_decoupled_fe() {
     fwd_progress = 0;
     uint64_t pred_addr = 3;
     Op* op = alloc_op(set_proc_id);
-    frontend_fetch_op(set_proc_id, op);
+    HOST_PROF_TIME(HP_FE_FETCH, frontend_fetch_op(set_proc_id, op));
     op->op_num = per_core_op_count[set_proc_id]++;
     op->off_path = *off_path;
 
@@ -495,6 +525,10 @@ void decoupled_fe_set_ftq_num(int proc_id, uint64_t ftq_ft_num) {
   per_core_ftq_ft_num[proc_id] = ftq_ft_num;
 }
 
+void decoupled_fe_set_fetch_gated(int proc_id, bool gated) {
+  per_core_fetch_gated[proc_id] = gated;
+}
+
 uint64_t decoupled_fe_get_ftq_num(int proc_id) {
   return per_core_ftq_ft_num[proc_id];
 }
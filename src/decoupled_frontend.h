@@ -100,6 +100,7 @@ extern "C" {
   uint64_t decoupled_fe_ftq_num_fts();
   void decoupled_fe_set_ftq_num(int proc_id, uint64_t ftq_ft_num);
   uint64_t decoupled_fe_get_ftq_num(int proc_id);
+  void decoupled_fe_set_fetch_gated(int proc_id, bool gated);
 #ifdef __cplusplus
 }
 #endif
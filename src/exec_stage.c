@@ -59,7 +59,7 @@
 /**************************************************************************************/
 /* Global Variables */
 
-Exec_Stage* exec = NULL;
+CORE_LOCAL Exec_Stage* exec = NULL;
 int         op_type_delays[NUM_OP_TYPES];
 int         exec_off_path;
 /**************************************************************************************/
@@ -29,6 +29,7 @@
 #ifndef __EXEC_STAGE_H__
 #define __EXEC_STAGE_H__
 
+#include "globals/global_defs.h"
 #include "stage_data.h"
 
 /**************************************************************************************/
@@ -63,7 +64,7 @@ typedef struct Exec_Stage_struct {
 /**************************************************************************************/
 /* External Variables */
 
-extern Exec_Stage* exec;
+extern CORE_LOCAL Exec_Stage* exec;
 
 
 /**************************************************************************************/
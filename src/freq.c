@@ -112,16 +112,16 @@ void freq_init(void) {
     sprintf(buf, "CORE_%d", proc_id);
     FREQ_DOMAIN_CORES[proc_id]                     = freq_domain_create(buf,
                                                     core_cycle_times[proc_id]);
-    GET_STAT_EVENT(proc_id, PARAM_CORE_CYCLE_TIME) = core_cycle_times[proc_id];
+    SET_STAT_EVENT(proc_id, PARAM_CORE_CYCLE_TIME, core_cycle_times[proc_id]);
   }
   FREQ_DOMAIN_L1 = freq_domain_create("L1", l1_cycle_time);
   // FREQ_DOMAIN_MEMORY = freq_domain_create("MEMORY", MEMORY_CYCLE_TIME);
   FREQ_DOMAIN_MEMORY = freq_domain_create("MEMORY", RAMULATOR_TCK);
   /* These stats simplify data analysis by allowing cycle times to
      be used in get_cmp_data stat formulas */
-  GET_STAT_EVENT(0, PARAM_L1_CYCLE_TIME) = l1_cycle_time;
-  // GET_STAT_EVENT(0, PARAM_MEMORY_CYCLE_TIME) = MEMORY_CYCLE_TIME;
-  GET_STAT_EVENT(0, PARAM_MEMORY_CYCLE_TIME) = RAMULATOR_TCK;
+  SET_STAT_EVENT(0, PARAM_L1_CYCLE_TIME, l1_cycle_time);
+  // SET_STAT_EVENT(0, PARAM_MEMORY_CYCLE_TIME, MEMORY_CYCLE_TIME);
+  SET_STAT_EVENT(0, PARAM_MEMORY_CYCLE_TIME, RAMULATOR_TCK);
 }
 
 static Freq_Domain_Id freq_domain_create(char* name, uns cycle_time) {
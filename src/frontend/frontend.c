@@ -139,6 +139,13 @@ void frontend_retire(uns proc_id, uns64 inst_uid) {
   DEBUG(proc_id, "Retiring inst_uid %lld end\n", inst_uid);
 }
 
+Counter frontend_skip_insts(uns proc_id, Counter num_insts) {
+  DEBUG(proc_id, "Skipping %lld instructions\n", num_insts);
+  Counter skipped = frontend->skip_insts(proc_id, num_insts);
+  DEBUG(proc_id, "Skipped %lld instructions\n", skipped);
+  return skipped;
+}
+
 static void collect_op_stats(Op* op) {
   if(!ic || !ic->off_path) {
     STAT_EVENT(op->proc_id, ST_OP_ONPATH);
@@ -59,6 +59,9 @@ void frontend_recover(uns proc_id, uns64 inst_uid);
 /* Let the frontend know that this instruction is retired) */
 void frontend_retire(uns proc_id, uns64 inst_uid);
 
+/* Skip instructions without generating ops */
+Counter frontend_skip_insts(uns proc_id, Counter num_insts);
+
 #ifdef ENABLE_PT_MEMTRACE
 /* Trace post-processing to extract basic block vectors */
 void frontend_extract_basic_block_vectors(void);
@@ -46,7 +46,8 @@ Frontend_Impl frontend_table[] = {
    prefix##_fetch_op,                   \
    prefix##_redirect,                   \
    prefix##_recover,                    \
-   prefix##_retire},
+   prefix##_retire,                     \
+   prefix##_skip_insts},
 #include "frontend/frontend_table.def"
 #undef FRONTEND_IMPL
 };
@@ -64,6 +64,12 @@ typedef struct Frontend_Intf_struct {
 
   /* Let the frontend know that this instruction is retired) */
   void (*retire)(uns proc_id, uns64 inst_uid);
+
+  /* Skip the next num_insts on-path instructions without generating their
+     ops (the frontend must be at an instruction boundary). Returns the number
+     of instructions skipped, which is smaller than num_insts only if the
+     application ended. */
+  Counter (*skip_insts)(uns proc_id, Counter num_insts);
 } Frontend_Impl;
 
 typedef enum Frontend_Id_enum {
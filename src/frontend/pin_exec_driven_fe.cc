@@ -45,7 +45,7 @@ extern "C" {
 
 #include <time.h>
 
-extern int *off_path;
+extern CORE_LOCAL int *off_path;
 
 #define DEBUG(proc_id, args...) _DEBUG(proc_id, DEBUG_PIN_EXEC_DRIVEN, ##args)
 
@@ -86,6 +86,24 @@ Addr get_fetch_address(uns proc_id, compressed_op* cop) {
   return convert_to_cmp_addr(proc_id, cop->instruction_addr);
 }
 
+/* handles the stat dump markers of an on-path instruction */
+static void check_roi_markers(uns proc_id, compressed_op* cop) {
+  if(cop->scarab_marker_roi_begin == true) {
+    ASSERT(proc_id, !roi_dump_began);
+    // reset stats
+    printf("Reached roi dump begin marker, reset stats\n");
+    reset_stats(TRUE);
+    roi_dump_began = TRUE;
+  } else if(cop->scarab_marker_roi_end == true) {
+    ASSERT(proc_id, roi_dump_began);
+    // dump stats
+    printf("Reached roi dump end marker, dump stats between\n");
+    dump_stats(proc_id, TRUE, global_stat_array[proc_id], NUM_GLOBAL_STATS);
+    roi_dump_began = FALSE;
+    roi_dump_ID++;
+  }
+}
+
 /**********************************************************
  * PIN Exec Driven Interface Functions
  **********************************************************/
@@ -137,22 +155,8 @@ void pin_exec_driven_fetch_op(uns proc_id, Op* op) {
   Flag eom = uop_generator_extract_op(proc_id, op,
                                       &cached_cop_buffers[proc_id].front());
   if(eom) {
-    if(!*off_path) {
-      if(cached_cop_buffers[proc_id].front().scarab_marker_roi_begin == true) {
-        ASSERT(proc_id, !roi_dump_began);
-        // reset stats
-        printf("Reached roi dump begin marker, reset stats\n");
-        reset_stats(TRUE);
-        roi_dump_began = TRUE;
-      } else if(cached_cop_buffers[proc_id].front().scarab_marker_roi_end == true) {
-        ASSERT(proc_id, roi_dump_began);
-        // dump stats
-        printf("Reached roi dump end marker, dump stats between\n");
-        dump_stats(proc_id, TRUE, global_stat_array[proc_id], NUM_GLOBAL_STATS);
-        roi_dump_began = FALSE;
-        roi_dump_ID ++;
-      }
-    }
+    if(!*off_path)
+      check_roi_markers(proc_id, &cached_cop_buffers[proc_id].front());
     cached_cop_buffers[proc_id].pop_front();
   }
 
@@ -199,3 +203,29 @@ void pin_exec_driven_retire(uns proc_id, uns64 inst_uid) {
   server->send(proc_id, (Message<Scarab_To_Pin_Msg>)msg);  // blocking
   DEBUG(proc_id, "Fetch Retire end: %llu\n", inst_uid);
 }
+
+/* The ops buffered from PIN are dropped without uop generation, and PIN is
+   told once at the end that everything up to the last skipped instruction
+   retired. */
+Counter pin_exec_driven_skip_insts(uns proc_id, Counter num_insts) {
+  DEBUG(proc_id, "Skip insts begin: %llu\n", num_insts);
+  ASSERT(proc_id, uop_generator_get_eom(proc_id));
+  Counter skipped  = 0;
+  uns64   last_uid = 0;
+  Flag    exit     = FALSE;
+  while(skipped < num_insts && !exit) {
+    update_op_buffer_if_empty(proc_id);
+    compressed_op* cop = &cached_cop_buffers[proc_id].front();
+    if(is_sentinal_op(cop))
+      break;
+    check_roi_markers(proc_id, cop);
+    last_uid = cop->inst_uid;
+    exit     = cop->exit;
+    cached_cop_buffers[proc_id].pop_front();
+    skipped++;
+  }
+  if(skipped)
+    pin_exec_driven_retire(proc_id, last_uid);
+  DEBUG(proc_id, "Skip insts end: %llu\n", skipped);
+  return skipped;
+}
@@ -62,6 +62,9 @@ void pin_exec_driven_recover(uns proc_id, uns64 inst_uid);
 /* Retire instruction at unique op id */
 void pin_exec_driven_retire(uns proc_id, uns64 inst_uid);
 
+/* Skip instructions without generating their ops */
+Counter pin_exec_driven_skip_insts(uns proc_id, Counter num_insts);
+
 #ifdef __cplusplus
 }
 #endif
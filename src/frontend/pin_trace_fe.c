@@ -34,6 +34,8 @@
 #include "globals/utils.h"
 
 #include "bp/bp.h"
+#include "general.param.h"
+#include "sim.h"
 #include "statistics.h"
 
 #include "./pin/pin_lib/uop_generator.h"
@@ -94,6 +96,14 @@ void trace_init() {
     trace_files[proc_id] = tmp_trace_files[proc_id];
   }
   for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    if(SIM_MODE == MIX_SIM_MODE) {
+      /* the mix driver assigns the traces with trace_switch */
+      trace_files[proc_id]     = NULL;
+      trace_read_done[proc_id] = TRUE;
+      continue;
+    }
+    ASSERTM(0, trace_files[proc_id], "No trace file given for core %u\n",
+            proc_id);
     trace_setup(proc_id);
   }
 }
@@ -124,6 +134,22 @@ void trace_close_trace_file(uns proc_id) {
   pin_trace_close(proc_id);
 }
 
+/**************************************************************************************/
+/* trace_switch: Replaces the trace of proc_id with the trace file 'name' from
+   its start, or leaves the core without instructions if name is NULL. The core
+   must be drained and at an instruction boundary. Used by the mix driver. */
+
+void trace_switch(uns proc_id, const char* name) {
+  ASSERT(proc_id, uop_generator_get_eom(proc_id));
+  pin_trace_close(proc_id);
+  trace_files[proc_id]     = (char*)name;
+  trace_read_done[proc_id] = name == NULL;
+  reached_exit[proc_id]    = FALSE;
+  retired_exit[proc_id]    = FALSE;
+  if(name)
+    trace_setup(proc_id);
+}
+
 Flag trace_can_fetch_op(uns proc_id) {
   return !(uop_generator_get_eom(proc_id) && trace_read_done[proc_id]);
 }
@@ -163,3 +189,21 @@ void trace_retire(uns proc_id, uns64 inst_uid) {
   // Trace frontend does not need to communicate to PIN which instruction are
   // retired.
 }
+
+/**************************************************************************************/
+/* trace_skip_insts: the trace is a compressed stream that cannot be seeked,
+   so the records are read and dropped without cracking them into uops. */
+
+Counter trace_skip_insts(uns proc_id, Counter num_insts) {
+  Counter skipped = 0;
+  ASSERT(proc_id, uop_generator_get_eom(proc_id));
+  while(skipped < num_insts && !trace_read_done[proc_id]) {
+    Flag exit = next_pi[proc_id].exit;
+    skipped++;
+    if(exit || !pin_trace_read(proc_id, &next_pi[proc_id])) {
+      trace_read_done[proc_id] = TRUE;
+      reached_exit[proc_id]    = TRUE;
+    }
+  }
+  return skipped;
+}
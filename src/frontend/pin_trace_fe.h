@@ -50,10 +50,12 @@ void trace_fetch_op(uns proc_id, Op* op);
 void trace_redirect(uns proc_id, uns64 inst_uid, Addr fetch_addr);
 void trace_recover(uns proc_id, uns64 inst_uid);
 void trace_retire(uns proc_id, uns64 inst_uid);
+Counter trace_skip_insts(uns proc_id, Counter num_insts);
 
 /* For restarting of traces */
 void trace_done(void);
 void trace_close_trace_file(uns proc_id);
 void trace_setup(uns proc_id);
+void trace_switch(uns proc_id, const char* name);
 
 #endif
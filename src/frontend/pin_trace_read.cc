@@ -27,6 +27,7 @@
  ****************************************************************************************/
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <inttypes.h>
 #include <iostream>
 #include <string>
@@ -42,10 +43,15 @@ extern "C" {
 #define CMP_ADDR_MASK (((uint64_t)-1) << 58)
 
 FILE** pin_file;
+/* trace name and number of records read, to reopen a trace in a forked process */
+static char**    pin_trace_name;
+static uint64_t* pin_trace_records;
 
 // static Reg_Id convert_pin_reg_to_scarab_reg(uns pin_reg);
 void pin_trace_file_pointer_init(unsigned char num_cores) {
-  pin_file = (FILE**)malloc(num_cores * sizeof(FILE*));
+  pin_file          = (FILE**)calloc(num_cores, sizeof(FILE*));
+  pin_trace_name    = (char**)calloc(num_cores, sizeof(char*));
+  pin_trace_records = (uint64_t*)calloc(num_cores, sizeof(uint64_t));
 }
 
 void pin_trace_open(unsigned char proc_id, const char* name) {
@@ -57,10 +63,32 @@ void pin_trace_open(unsigned char proc_id, const char* name) {
     printf("Cannot open trace file: %s\n", name);
     exit(1);
   }
+  if(pin_trace_name[proc_id] != name) {
+    free(pin_trace_name[proc_id]);
+    pin_trace_name[proc_id] = strdup(name);
+  }
+  pin_trace_records[proc_id] = 0;
+}
+
+/* pin_trace_reopen: restarts the decompressor of the trace of proc_id and
+   skips to the current record. A forked process calls it so that it does not
+   read from the pipe it shares with its parent. */
+void pin_trace_reopen(unsigned char proc_id) {
+  if(!pin_file[proc_id])
+    return;
+  uint64_t       records = pin_trace_records[proc_id];
+  ctype_pin_inst pi;
+  pin_trace_close(proc_id);
+  pin_trace_open(proc_id, pin_trace_name[proc_id]);
+  for(uint64_t ii = 0; ii < records; ii++)
+    ASSERTM(proc_id, pin_trace_read(proc_id, &pi),
+            "Trace %s ended while reopening it\n", pin_trace_name[proc_id]);
 }
 
 void pin_trace_close(unsigned char proc_id) {
-  pclose(pin_file[proc_id]);
+  if(pin_file[proc_id])
+    pclose(pin_file[proc_id]);
+  pin_file[proc_id] = NULL;
 }
 
 int pin_trace_read(unsigned char proc_id, ctype_pin_inst* pi) {
@@ -70,5 +98,6 @@ int pin_trace_read(unsigned char proc_id, ctype_pin_inst* pi) {
   if(read_size != 1) {
     return 0;
   }
+  pin_trace_records[proc_id]++;
   return 1;
 }
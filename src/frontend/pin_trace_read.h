@@ -39,6 +39,7 @@ void pin_trace_file_pointer_init(unsigned char);
 int  pin_trace_read(unsigned char, ctype_pin_inst*);
 void pin_trace_open(unsigned char, const char*);
 void pin_trace_close(unsigned char);
+void pin_trace_reopen(unsigned char);
 
 #ifdef __cplusplus
 }
@@ -123,13 +123,14 @@ void fill_in_dynamic_info(ctype_pin_inst* info, const InstInfo* insi) {
   }
 }
 
-int ffwd(const xed_decoded_inst_t* ins) {
+int roi(const xed_decoded_inst_t* ins);
+
+/* XED is only queried for the rare marker candidates flagged by the reader */
+int ffwd(const InstInfo* insi) {
   if(!FAST_FORWARD) {
     return 0;
   }
-  if(XED_INS_Opcode(ins) == XED_ICLASS_XCHG &&
-     XED_INS_OperandReg(ins, 0) == XED_REG_RCX &&
-     XED_INS_OperandReg(ins, 1) == XED_REG_RCX) {
+  if(insi->scarab_marker && roi(insi->ins)) {
     return 0;
   }
   if((USE_FETCHED_COUNT ? ins_id_fetched : ins_id) == FAST_FORWARD_TRACE_INS) {
@@ -190,7 +191,8 @@ int memtrace_trace_read(int proc_id, ctype_pin_inst* next_onpath_pi) {
   }
 }
 
-int memtrace_trace_read_internal(int proc_id, ctype_pin_inst* next_onpath_pi) {
+/* next instruction of the traced thread, NULL at the end of the trace */
+static InstInfo* memtrace_next_inst(int proc_id) {
   InstInfo* insi;
 
   do {
@@ -210,10 +212,15 @@ int memtrace_trace_read_internal(int proc_id, ctype_pin_inst* next_onpath_pi) {
         ins_id_fetched++;
       }
     } else {
-      return 0;  // end of trace
+      return NULL;  // end of trace
     }
   } while(insi->pid != prior_pid || insi->tid != prior_tid);
+  return insi;
+}
 
+/* converts insi to next_onpath_pi, returns 0 at the end of the roi */
+static int memtrace_convert_inst(int proc_id, InstInfo* insi,
+                                 ctype_pin_inst* next_onpath_pi) {
   memset(next_onpath_pi, 0, sizeof(ctype_pin_inst));
   fill_in_dynamic_info(next_onpath_pi, insi);
   fill_in_basic_info(next_onpath_pi, insi->ins);
@@ -250,6 +257,46 @@ int memtrace_trace_read_internal(int proc_id, ctype_pin_inst* next_onpath_pi) {
   return 1;
 }
 
+int memtrace_trace_read_internal(int proc_id, ctype_pin_inst* next_onpath_pi) {
+  InstInfo* insi = memtrace_next_inst(proc_id);
+  if(!insi)
+    return 0;
+  return memtrace_convert_inst(proc_id, insi, next_onpath_pi);
+}
+
+/* memtrace_trace_skip: skips num_insts instructions of the traced thread. Only
+   instructions with a stat dump or roi marker are converted, for their side
+   effects; the reader flags the marker candidates when it first decodes their
+   PC, so other instructions are not looked at. With MEMTRACE_BUF_SIZE, the
+   skipped part of the lookahead buffer is refilled after the skip. Returns the
+   number skipped, smaller than num_insts if the trace or the roi ended (or, as
+   in memtrace_trace_read, if the lookahead reached that end). */
+uint64_t memtrace_trace_skip(int proc_id, uint64_t num_insts) {
+  uint64_t skipped  = 0;
+  uint64_t buffered = MIN2(num_insts, (uint64_t)MEMTRACE_BUF_SIZE);
+  for(; skipped < buffered; skipped++)
+    buf_map_remove();
+
+  while(skipped < num_insts) {
+    InstInfo* insi = memtrace_next_inst(proc_id);
+    if(!insi)
+      break;
+    if(insi->scarab_marker) {
+      ctype_pin_inst pi;
+      if(!memtrace_convert_inst(proc_id, insi, &pi))
+        break;
+    }
+    skipped++;
+  }
+
+  for(uint64_t ii = 0; ii < buffered; ii++) {
+    if(!memtrace_trace_read_internal(proc_id, &circ_buf[wrptr]))
+      return MIN2(skipped, num_insts - 1);
+    buf_map_insert();
+  }
+  return skipped;
+}
+
 
 /**************************************************************************************/
 /* trace_init() */
@@ -318,7 +365,7 @@ void memtrace_setup(uns proc_id) {
       if((inst_count_to_use % 10000000) == 0)
         std::cout << "Fast forwarded " << inst_count_to_use << " instructions."
         << (insi->valid ? " Valid" : " Invalid") << " instr." << std::endl;
-    } while(ffwd(insi->ins));
+    } while(ffwd(insi));
     std::cout << "Exit fast forward " << inst_count_to_use << std::endl;
   }
 
@@ -47,6 +47,7 @@ extern "C" {
   
 void memtrace_init(void);
 int  memtrace_trace_read(int proc_id, ctype_pin_inst* pt_next_pi);
+uint64_t memtrace_trace_skip(int proc_id, uint64_t num_insts);
 void memtrace_setup(uns proc_id);
 bool buf_map_find(uns64 line_addr);
 
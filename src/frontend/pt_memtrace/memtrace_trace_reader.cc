@@ -116,6 +116,7 @@ void TraceReader::init(const std::string& _trace) {
   invalid_info_.taken        = false;
   invalid_info_.unknown_type = false;
   invalid_info_.valid        = false;
+  invalid_info_.scarab_marker = false;
 
   if(_trace.size())
     traceFileIs(_trace);
@@ -221,7 +222,7 @@ void TraceReader::fillCache(uint64_t _vAddr, uint8_t _reported_size,
   uint64_t size;
   uint8_t* loc;
   if(inst_bytes != NULL || locationForVAddr(_vAddr, &loc, &size)) {
-    xed_map_.emplace(_vAddr, make_tuple(0, false, false, false,
+    xed_map_.emplace(_vAddr, make_tuple(0, false, false, false, false,
                                         make_unique<xed_decoded_inst_t>()));
     xed_decoded_inst_t* ins = get<MAP_XED>(xed_map_.at(_vAddr)).get();
     xed_decoded_inst_zero_set_mode(ins, &xed_state_);
@@ -269,6 +270,14 @@ void TraceReader::fillCache(uint64_t _vAddr, uint8_t _reported_size,
     // variable number of memory records for input formats like memtrace
     bool is_rep = xed_decoded_inst_get_attribute(ins, XED_ATTRIBUTE_REP) > 0;
     get<MAP_REP>(xed_tuple) = is_rep;
+
+    // Record if this instruction may be a Scarab marker (roi or stat dump),
+    // which are all 'xchg' of a register with itself
+    bool is_marker = XED_INS_Opcode(ins) == XED_ICLASS_XCHG &&
+                     XED_INS_OperandCount(ins) >= 2 &&
+                     XED_INS_OperandReg(ins, 0) != XED_REG_INVALID &&
+                     XED_INS_OperandReg(ins, 0) == XED_INS_OperandReg(ins, 1);
+    get<MAP_MARKER>(xed_tuple) = is_marker;
   } else {
     if(warn_not_found_ > 0) {
       warn_not_found_ -= 1;
@@ -284,7 +293,7 @@ void TraceReader::fillCache(uint64_t _vAddr, uint8_t _reported_size,
     // NOTE: Unknown memory records are skipped, so 'rep' needs no special
     // handling here
     xed_map_.emplace(
-      _vAddr, make_tuple(0, true, false, false, makeNop(_reported_size)));
+      _vAddr, make_tuple(0, true, false, false, false, makeNop(_reported_size)));
   }
 }
 
@@ -59,7 +59,8 @@ static constexpr int MAP_MEMOPS  = 0;
 static constexpr int MAP_UNKNOWN = 1;
 static constexpr int MAP_COND    = 2;
 static constexpr int MAP_REP     = 3;
-static constexpr int MAP_XED     = 4;
+static constexpr int MAP_MARKER  = 4;
+static constexpr int MAP_XED     = 5;
 
 class TraceReader {
  public:
@@ -111,7 +112,7 @@ class TraceReader {
   xed_state_t                                                    xed_state_;
   std::unordered_map<std::string, std::pair<uint8_t*, uint64_t>> binaries_;
   std::vector<std::tuple<uint64_t, uint64_t, uint8_t*>>          sections_;
-  std::unordered_map<uint64_t, std::tuple<int, bool, bool, bool,
+  std::unordered_map<uint64_t, std::tuple<int, bool, bool, bool, bool,
                                           std::unique_ptr<xed_decoded_inst_t>>>
                        xed_map_;
   int                  warn_not_found_;
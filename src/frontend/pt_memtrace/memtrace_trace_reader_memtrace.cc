@@ -356,7 +356,7 @@ void TraceReaderMemtrace::processInst(InstInfo* _info) {
   xed_decoded_inst_t* xed_ins;
   auto&               xed_tuple = (*xed_map_iter).second;
 
-  tie(mt_mem_ops_, unknown_type, cond_branch, std::ignore,
+  tie(mt_mem_ops_, unknown_type, cond_branch, std::ignore, std::ignore,
       std::ignore) = xed_tuple;
   mt_prior_isize_  = mt_ref_.instr.size;
   xed_ins          = std::get<MAP_XED>(xed_tuple).get();
@@ -378,6 +378,7 @@ void TraceReaderMemtrace::processInst(InstInfo* _info) {
   _info->mem_used[0]  = false;
   _info->mem_used[1]  = false;
   _info->unknown_type = unknown_type;
+  _info->scarab_marker = std::get<MAP_MARKER>(xed_tuple);
   // correct this later at getNextInstruction if it is the last instruction
   _info->last_inst_from_trace = false;
   // non-fetched instructions will be set within FSM
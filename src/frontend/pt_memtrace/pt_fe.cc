@@ -117,13 +117,14 @@ void pt_fill_in_dynamic_info(ctype_pin_inst* info, const InstInfo *insi) {
     }
 }
 
-int pt_ffwd(const xed_decoded_inst_t* ins) {
+int pt_roi(const xed_decoded_inst_t* ins);
+
+/* XED is only queried for the rare marker candidates flagged by the reader */
+int pt_ffwd(const InstInfo* insi) {
   if (!FAST_FORWARD) {
     return 0;
   }
-  if(XED_INS_Opcode(ins) == XED_ICLASS_XCHG &&
-     XED_INS_OperandReg(ins, 0) == XED_REG_RCX &&
-     XED_INS_OperandReg(ins, 1) == XED_REG_RCX) {
+  if(insi->scarab_marker && pt_roi(insi->ins)) {
     return 0;
   }
   return 1;
@@ -174,6 +175,22 @@ int pt_trace_read(int proc_id, ctype_pin_inst* pt_next_pi) {
   return 1;
 }
 
+/* pt_trace_skip: skips num_insts instructions of the traced thread without
+   converting them. Returns the number skipped, smaller than num_insts if the
+   trace or the roi ended. */
+uint64_t pt_trace_skip(int proc_id, uint64_t num_insts) {
+  uint64_t skipped = 0;
+  while(skipped < num_insts) {
+    const InstInfo *insi = pt_trace_readers[proc_id]->nextInstruction();
+    pt_ins_id++;
+    if (!insi->valid || (insi->scarab_marker && pt_roi(insi->ins)))
+      break;
+    if (insi->pid == pt_prior_pid && insi->tid == pt_prior_tid)
+      skipped++;
+  }
+  return skipped;
+}
+
 void pt_init(void) {
   uop_generator_init(NUM_CORES);
   init_x86_decoder(nullptr);
@@ -227,7 +244,7 @@ void pt_setup(uns proc_id) {
     std::cout << "Enter fast forward " << pt_ins_id << std::endl;
   }
 
-  while (!insi->valid || pt_ffwd(insi->ins)) {
+  while (!insi->valid || pt_ffwd(insi)) {
     insi = pt_trace_readers[proc_id]->nextInstruction();
     pt_ins_id++;
     if ((pt_ins_id % 10000000) == 0)
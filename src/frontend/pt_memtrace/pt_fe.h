@@ -47,6 +47,7 @@ extern "C" {
 
 void pt_init(void);
 int  pt_trace_read(int proc_id, ctype_pin_inst* pt_next_pi);
+uint64_t pt_trace_skip(int proc_id, uint64_t num_insts);
 void pt_setup(uns proc_id);
 
 #ifdef __cplusplus
@@ -0,0 +1,287 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : frontend/pt_memtrace/pt_trace_format.h
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Readers and writer of the PT trace formats, without any
+ *                simulator dependency (also used by utils/pt_convert).
+ *
+ * Text format (gzip): one instruction per line,
+ *   "<pc hex>  <size dec> <byte hex> <byte hex> ..."
+ *
+ * Binary format (gzip or plain): PT_BIN_MAGIC, a uint32 version and a uint32
+ * reserved word, then one record per instruction:
+ *   uint8   size | PT_BIN_HAS_BYTES
+ *   varint  zigzag(pc - (previous pc + previous size))
+ *   uint8   bytes[size], only when PT_BIN_HAS_BYTES is set
+ * The bytes are stored the first time a pc is seen (and again if they change,
+ * e.g. for jitted code); later records reuse them.
+ *
+ * Both readers decompress large blocks and parse them in place, so reading
+ * an instruction does not allocate.
+ ***************************************************************************************/
+
+#ifndef __PT_TRACE_FORMAT_H__
+#define __PT_TRACE_FORMAT_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+struct PTInst {
+  uint64_t pc;
+  uint8_t  size;
+  uint8_t  inst_bytes[16];
+};
+
+#define PT_BIN_MAGIC "SCARABPT"
+#define PT_BIN_VERSION 1
+#define PT_BIN_HAS_BYTES 0x80
+#define PT_BLOCK_SIZE (1 << 20)
+#define PT_MAX_RECORD 256  // longer than any text line or binary record
+
+/**************************************************************************************/
+/* PTTraceParser: reads either format, detected from the file header */
+
+class PTTraceParser {
+ public:
+  ~PTTraceParser() {
+    if(file)
+      gzclose(file);
+  }
+
+  bool open(const char* path) {
+    file = gzopen(path, "rb");
+    if(!file)
+      return false;
+    gzbuffer(file, PT_BLOCK_SIZE);
+    buf.resize(PT_BLOCK_SIZE + PT_MAX_RECORD);
+    ensure(16);
+    binary = len - pos >= 16 && !memcmp(&buf[pos], PT_BIN_MAGIC, 8);
+    if(binary) {
+      uint32_t version;
+      memcpy(&version, &buf[pos + 8], sizeof(version));
+      if(version != PT_BIN_VERSION) {
+        fprintf(stderr, "PT trace %s has version %u, expected %u\n", path,
+                version, PT_BIN_VERSION);
+        return false;
+      }
+      pos += 16;
+    }
+    return true;
+  }
+
+  bool is_binary() const { return binary; }
+
+  /* returns false at the end of the trace */
+  bool next(PTInst& inst) { return binary ? next_binary(inst) : next_text(inst); }
+
+ private:
+  gzFile               file = NULL;
+  std::vector<uint8_t> buf;
+  size_t               pos    = 0;
+  size_t               len    = 0;
+  bool                 eof    = false;
+  bool                 binary = false;
+
+  uint64_t                                              next_pc = 0;
+  std::unordered_map<uint64_t, std::array<uint8_t, 16>> pc_bytes;
+
+  /* makes at least n bytes available from pos, unless the file ends first */
+  size_t ensure(size_t n) {
+    if(len - pos < n && !eof) {
+      memmove(&buf[0], &buf[pos], len - pos);
+      len -= pos;
+      pos = 0;
+      while(len < n && !eof) {
+        int bytes = gzread(file, &buf[len], buf.size() - len);
+        if(bytes <= 0)
+          eof = true;
+        else
+          len += bytes;
+      }
+    }
+    return len - pos;
+  }
+
+  static int hex_digit(uint8_t c) {
+    static const struct Hex_Table {
+      int8_t val[256];
+      Hex_Table() {
+        memset(val, -1, sizeof(val));
+        for(int i = 0; i < 10; i++)
+          val['0' + i] = i;
+        for(int i = 0; i < 6; i++)
+          val['a' + i] = val['A' + i] = 10 + i;
+      }
+    } table;
+    return table.val[c];
+  }
+
+  bool next_text(PTInst& inst) {
+    const uint8_t* line;
+    const uint8_t* end;
+    do {  // skips empty lines
+      size_t avail = ensure(PT_MAX_RECORD);
+      if(!avail)
+        return false;
+      line              = &buf[pos];
+      const uint8_t* nl = (const uint8_t*)memchr(line, '\n', avail);
+      end               = nl ? nl : line + avail;
+      pos += end - line + (nl ? 1 : 0);
+    } while(end == line || (end == line + 1 && *line == '\r'));
+
+    const uint8_t* p = line;
+    int            d;
+    if(p < end && p[0] == '0' && p + 1 < end && (p[1] | 0x20) == 'x')
+      p += 2;
+    inst.pc = 0;
+    for(; p < end && (d = hex_digit(*p)) >= 0; p++)
+      inst.pc = (inst.pc << 4) | d;
+    while(p < end && *p == ' ')
+      p++;
+    inst.size = 0;
+    for(; p < end && *p >= '0' && *p <= '9'; p++)
+      inst.size = inst.size * 10 + (*p - '0');
+    if(!inst.size || inst.size > sizeof(inst.inst_bytes)) {
+      fprintf(stderr, "PT trace: bad instruction size in line '%.*s'\n",
+              (int)(end - line), line);
+      return false;
+    }
+    for(uint8_t found = 0; found < inst.size; found++) {
+      while(p < end && *p == ' ')
+        p++;
+      if(p == end || hex_digit(*p) < 0) {
+        fprintf(stderr, "PT trace: line has fewer than %u bytes\n", inst.size);
+        return false;
+      }
+      uint8_t byte = 0;
+      for(; p < end && (d = hex_digit(*p)) >= 0; p++)
+        byte = (byte << 4) | d;
+      inst.inst_bytes[found] = byte;
+    }
+    return true;
+  }
+
+  bool next_binary(PTInst& inst) {
+    size_t avail = ensure(PT_MAX_RECORD);
+    if(!avail)
+      return false;
+    const uint8_t* p    = &buf[pos];
+    const uint8_t* end  = p + avail;
+    uint8_t        head = *p++;
+
+    uint64_t zigzag   = 0;
+    bool     complete = false;  // stays false if the trace ends mid-varint
+    for(int shift = 0; p < end && shift < 64; shift += 7) {
+      uint8_t byte = *p++;
+      zigzag |= (uint64_t)(byte & 0x7f) << shift;
+      if(!(byte & 0x80)) {
+        complete = true;
+        break;
+      }
+    }
+    int64_t delta = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+
+    inst.pc   = next_pc + delta;
+    inst.size = head & ~PT_BIN_HAS_BYTES;
+    if(!complete || !inst.size || inst.size > sizeof(inst.inst_bytes) ||
+       ((head & PT_BIN_HAS_BYTES) && end - p < inst.size)) {
+      fprintf(stderr, "PT trace: corrupt binary record\n");
+      return false;
+    }
+    if(head & PT_BIN_HAS_BYTES) {
+      memcpy(pc_bytes[inst.pc].data(), p, inst.size);
+      p += inst.size;
+    }
+    auto it = pc_bytes.find(inst.pc);
+    if(it == pc_bytes.end()) {
+      fprintf(stderr, "PT trace: no bytes for pc %llx\n",
+              (unsigned long long)inst.pc);
+      return false;
+    }
+    memcpy(inst.inst_bytes, it->second.data(), inst.size);
+    next_pc = inst.pc + inst.size;
+    pos     = p - &buf[0];
+    return true;
+  }
+};
+
+/**************************************************************************************/
+/* PTTraceWriter: writes the binary format */
+
+class PTTraceWriter {
+ public:
+  ~PTTraceWriter() { close(); }
+
+  bool open(const char* path, bool compress) {
+    file = gzopen(path, compress ? "wb6" : "wbT");
+    if(!file)
+      return false;
+    uint32_t header[2] = {PT_BIN_VERSION, 0};
+    gzwrite(file, PT_BIN_MAGIC, 8);
+    gzwrite(file, header, sizeof(header));
+    return true;
+  }
+
+  void write(const PTInst& inst) {
+    uint8_t  rec[PT_MAX_RECORD];
+    uint8_t* p        = rec;
+    auto     it       = pc_bytes.find(inst.pc);
+    bool     new_code = it == pc_bytes.end() ||
+                    memcmp(it->second.data(), inst.inst_bytes, inst.size);
+
+    *p++           = inst.size | (new_code ? PT_BIN_HAS_BYTES : 0);
+    int64_t  delta = (int64_t)(inst.pc - next_pc);
+    uint64_t zigzag = ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63);
+    do {
+      *p++ = (zigzag & 0x7f) | (zigzag > 0x7f ? 0x80 : 0);
+      zigzag >>= 7;
+    } while(zigzag);
+    if(new_code) {
+      memcpy(pc_bytes[inst.pc].data(), inst.inst_bytes, inst.size);
+      memcpy(p, inst.inst_bytes, inst.size);
+      p += inst.size;
+    }
+    gzwrite(file, rec, p - rec);
+    next_pc = inst.pc + inst.size;
+  }
+
+  void close() {
+    if(file)
+      gzclose(file);
+    file = NULL;
+  }
+
+ private:
+  gzFile                                                file    = NULL;
+  uint64_t                                              next_pc = 0;
+  std::unordered_map<uint64_t, std::array<uint8_t, 16>> pc_bytes;
+};
+
+#endif  // __PT_TRACE_FORMAT_H__
@@ -26,34 +26,26 @@
  * Notes        : This code has been adapted from zsim which was released under
  *                GNU General Public License as published by the Free Software
  *                Foundation, version 2.
- * Description  : Interface to read gziped Intel processor trace
+ * Description  : Interface to read gziped Intel processor trace, in the text
+ *                or the binary format of pt_trace_format.h
  ***************************************************************************************/
 #ifndef __PT_TRACE_READER_PT_H__
 #define __PT_TRACE_READER_PT_H__
 #include <stdlib.h>
-#include <zlib.h>
 
 #include <map>
 #include <string>
-#include <sstream>
-#include <vector>
 
 #include "frontend/pt_memtrace/memtrace_trace_reader.h"
+#include "frontend/pt_memtrace/pt_trace_format.h"
 
 #include "general.param.h"
 
-#define GZ_BUFFER_SIZE 80
 #define panic(...) printf(__VA_ARGS__)
 
-struct PTInst {
-  uint64_t pc;
-  uint8_t size;
-  uint8_t inst_bytes[16];
-};
-
 class TraceReaderPT : public TraceReader {
 private:
-  gzFile raw_file = NULL;
+  PTTraceParser parser;
   InstInfo inst_info_a;
   InstInfo inst_info_b;
   PTInst   pt_inst_a, pt_inst_b;
@@ -62,7 +54,6 @@ private:
   std::map<uint64_t, uint64_t> *prev_to_new_bbl_address_map = nullptr;
   uint64_t num_nops_in_trace = 0, num_inserted_nops = 0;
   uint64_t num_direct_brs_in_trace = 0, num_inserted_direct_brs = 0;
-  std::vector <std::string> parsed;
 public:
   bool read_next_line(PTInst &inst) {
       static uns64 num_nops_at_start = 0;
@@ -72,34 +63,8 @@ public:
           inst.inst_bytes[0] = 0x90;
           return true;
       }
-    if (raw_file == NULL)
+    if (!parser.next(inst))
       return false;
-    char buffer[GZ_BUFFER_SIZE];
-    if (gzgets(raw_file, buffer, GZ_BUFFER_SIZE) == Z_NULL)
-      return false;
-    std::string line = buffer;
-
-    parsed.clear();
-    std::stringstream check1(line);
-    std::string intermediate;
-    while(getline(check1, intermediate, ' '))
-    {
-        parsed.emplace_back(intermediate);
-    }
-    if (parsed.size() < 3)
-      panic("TraceReaderPT: GZ File line has less than 3 items");
-    assert(parsed[1].length()==0);
-    inst.pc = strtoul(parsed[0].c_str(), NULL, 16);
-    inst.size = strtoul(parsed[2].c_str(), NULL, 10);
-
-    int found = 0;
-    assert(inst.size);
-    for (uint8_t i = 3; found < inst.size; i++) {
-      if (parsed[i].length()==0) {
-        continue;
-      }
-      inst.inst_bytes[found++] = strtoul(parsed[i].c_str(), NULL, 16);
-    }
 
     if (enable_code_bloat_effect && (prev_to_new_bbl_address_map != nullptr)) {
       uint64_t result = inst.pc;
@@ -153,8 +118,8 @@ public:
       int mem_ops_;
       xed_decoded_inst_t *xed_ins;
       auto &xed_tuple = (*xed_map_iter).second;
-      tie(mem_ops_, unknown_type, cond_branch, std::ignore, std::ignore) =
-          xed_tuple;
+      tie(mem_ops_, unknown_type, cond_branch, std::ignore, std::ignore,
+          std::ignore) = xed_tuple;
       xed_ins = std::get<MAP_XED>(xed_tuple).get();
       InstInfo& _info = (use_info_a ? inst_info_a : inst_info_b);
       InstInfo& _prior = (use_info_a ? inst_info_b : inst_info_a);
@@ -229,6 +194,7 @@ public:
     _info.mem_used[0] = false;
     _info.mem_used[1] = false;
     _info.unknown_type = unknown_type;
+    _info.scarab_marker = std::get<MAP_MARKER>(xed_tuple);
     _info.valid = true;
 
     for (int i = 0; i < mem_ops_; i++) {
@@ -244,8 +210,7 @@ public:
   TraceReaderPT(
       const std::string &_trace, bool _enable_code_bloat_effect = false,
       std::map<uint64_t, uint64_t> *_prev_to_new_bbl_address_map = nullptr) {
-    raw_file = gzopen(_trace.c_str(), "rb");
-    if (!raw_file) {
+    if (!parser.open(_trace.c_str())) {
       panic("TraceReaderPT: Invalid GZ File");
       throw "Could not open file";
     }
@@ -288,8 +253,6 @@ public:
   ~TraceReaderPT() {
       std::cout << std::dec << "num trace nops: " << num_nops_in_trace << " , num added nops: " << num_inserted_nops << ", ratio: " << double(num_inserted_nops) / double(num_nops_in_trace) << std::endl;
       std::cout << "num trace direct brs: " << num_direct_brs_in_trace << " , num added direct brs: " << num_inserted_direct_brs << ", ratio: " << double(num_inserted_direct_brs) / double(num_direct_brs_in_trace) << std::endl;
-    if (raw_file != NULL)
-      gzclose(raw_file);
   }
 };
 
@@ -250,6 +250,36 @@ void ext_trace_retire(uns proc_id, uns64 inst_uid) {
   // retired.
 }
 
+/* next_onpath_pi is the first skipped instruction; the skipped instructions
+   are not added to pc_to_inst, so wrong-path fetches into code seen only
+   while skipping become dummy nops */
+Counter ext_trace_skip_insts(uns proc_id, Counter num_insts) {
+  ASSERT(proc_id, uop_generator_get_eom(proc_id) && !off_path_mode[proc_id]);
+  if(!num_insts || trace_read_done[proc_id])
+    return 0;
+
+  Counter skipped = 1;
+  if(num_insts > 1) {
+    if (FRONTEND == FE_PT)
+      skipped += pt_trace_skip(proc_id, num_insts - 1);
+    else if (FRONTEND == FE_MEMTRACE)
+      skipped += memtrace_trace_skip(proc_id, num_insts - 1);
+  }
+
+  int success = false;
+  if(skipped == num_insts) {
+    if (FRONTEND == FE_PT)
+      success = pt_trace_read(proc_id, &next_onpath_pi[proc_id]);
+    else if (FRONTEND == FE_MEMTRACE)
+      success = memtrace_trace_read(proc_id, &next_onpath_pi[proc_id]);
+  }
+  if(!success) {
+    trace_read_done[proc_id] = TRUE;
+    reached_exit[proc_id]    = TRUE;
+  }
+  return skipped;
+}
+
 Addr ext_trace_next_fetch_addr(uns proc_id) {
   return next_onpath_pi[proc_id].instruction_addr;
 }
@@ -59,6 +59,7 @@ void ext_trace_fetch_op(uns proc_id, Op* op);
 void ext_trace_redirect(uns proc_id, uns64 inst_uid, Addr fetch_addr);
 void ext_trace_recover(uns proc_id, uns64 inst_uid);
 void ext_trace_retire(uns proc_id, uns64 inst_uid);
+Counter ext_trace_skip_insts(uns proc_id, Counter num_insts);
 void ext_trace_init();
 void ext_trace_done(void);
 void ext_trace_extract_basic_block_vectors();
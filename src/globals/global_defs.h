@@ -65,6 +65,11 @@
 #undef UNUSED
 #define UNUSED(X) (void)(X)
 
+/* Storage class of the pointers to the state of the core being simulated
+   (td, ic, dc, node, ...). Each host thread selects its core with
+   cmp_set_core_context(). */
+#define CORE_LOCAL __thread
+
 /**************************************************************************************/
 
 #ifndef NULL
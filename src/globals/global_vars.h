@@ -55,6 +55,10 @@ extern Counter  unique_pws_since_recovery;
 extern Counter* period_last_inst_count;
 extern Counter  period_last_cycle_count;
 extern Counter  period_ID;
+extern Flag     simpoint_dump_began;
+extern Counter  simpoint_dump_ID;
+extern Flag     mix_dump_began;
+extern Counter  mix_dump_ID;
 
 extern Flag* warmup_dump_done;
 
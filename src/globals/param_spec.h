@@ -0,0 +1,87 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : globals/param_spec.h
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Declaration of parameters for PARAMS-specialized builds.
+ *
+ * A specialized build ('make spec SPEC_PARAMS=PARAMS.sunny_cove') is compiled
+ * with SCARAB_SPECIALIZED_PARAMS and a specialized_params.h generated by
+ * bin/scarab_specialize_params.py, which defines PARAM_SPEC_<VARIABLE> to 1
+ * and PARAM_SPEC_VALUE_<VARIABLE> to the value from the PARAMS file for every
+ * parameter it compiles in.  The .param.h files declare their parameters with
+ * PARAM_EXTERN, which turns those parameters into compile-time constants and
+ * leaves the others as the usual globals set by param_parser.c.
+ ***************************************************************************************/
+
+#ifndef __PARAM_SPEC_H__
+#define __PARAM_SPEC_H__
+
+#ifdef SCARAB_SPECIALIZED_PARAMS
+#include "specialized_params.h"
+#endif
+
+
+/**************************************************************************************/
+/* PARAM_IS_SPECIALIZED(variable) expands to 1 if PARAM_SPEC_<variable> is
+   defined to 1 and to 0 otherwise, so it can select between macros per
+   parameter inside the DEF_PARAM tables. */
+
+#define PARAM_SPEC_PLACEHOLDER_1 ~,
+#define PARAM_SPEC_SECOND(ignored, val, ...) val
+#define PARAM_SPEC_TEST(arg_or_junk) PARAM_SPEC_SECOND(arg_or_junk 1, 0, ~)
+#define PARAM_SPEC_TEST_(val) PARAM_SPEC_TEST(PARAM_SPEC_PLACEHOLDER_##val)
+#define PARAM_SPEC_TEST__(val) PARAM_SPEC_TEST_(val)
+#define PARAM_IS_SPECIALIZED(variable) PARAM_SPEC_TEST__(PARAM_SPEC_##variable)
+
+#define PARAM_SPEC_CAT_(a, b) a##b
+#define PARAM_SPEC_CAT(a, b) PARAM_SPEC_CAT_(a, b)
+/* PARAM_SPEC_SELECT(PREFIX_, variable) is PREFIX_1 for specialized parameters
+   and PREFIX_0 for the others */
+#define PARAM_SPEC_SELECT(prefix, variable) \
+  PARAM_SPEC_CAT(prefix, PARAM_IS_SPECIALIZED(variable))
+
+#define PARAM_SPEC_STR_(x) #x
+#define PARAM_SPEC_STR(x) PARAM_SPEC_STR_(x)
+
+
+/**************************************************************************************/
+/* PARAM_EXTERN: declaration used by the .param.h files.  'qual' is the const
+   column of DEF_PARAM. */
+
+#define PARAM_EXTERN(variable, type, qual) \
+  PARAM_SPEC_SELECT(PARAM_EXTERN_, variable)(variable, type, qual)
+
+#define PARAM_EXTERN_0(variable, type, qual) extern qual type variable;
+#ifdef __cplusplus
+#define PARAM_EXTERN_1(variable, type, qual) \
+  static constexpr type variable = PARAM_SPEC_VALUE_##variable;
+#else
+#define PARAM_EXTERN_1(variable, type, qual) \
+  static const type variable = PARAM_SPEC_VALUE_##variable;
+#endif
+
+
+/**************************************************************************************/
+
+#endif /* #ifndef __PARAM_SPEC_H__ */
@@ -26,7 +26,12 @@
  * Description  : Utility functions.
  ***************************************************************************************/
 
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "globals/global_defs.h"
 #include "globals/global_types.h"
 #include "globals/global_vars.h"
@@ -655,6 +660,76 @@ FILE* file_tag_fopen(char const* const dir, char const* const name,
   return fopen(file_name, mode);
 }
 
+/**************************************************************************************/
+// decouple_open_files: reopens every regular file open in this process at its
+// current offset, so that a forked process no longer shares file offsets with
+// its parent.
+
+void decouple_open_files(void) {
+  const uns MAX_FDS = 1024;
+  uns       fds[MAX_FDS];
+  uns       num_fds = 0;
+
+  char fdinfo_path[MAX_STR_LENGTH + 1];
+  uns  len = snprintf(fdinfo_path, MAX_STR_LENGTH, "/proc/%d/fdinfo", getpid());
+  ASSERT(0, len < MAX_STR_LENGTH);
+  DIR* dir = opendir(fdinfo_path);
+
+  while(dir) {
+    struct dirent* entry = readdir(dir);
+    if(entry) {
+      if(entry->d_name[0] != '.') {  // not a "." or ".."
+        ASSERT(0, num_fds < MAX_FDS);
+        fds[num_fds] = atoi(entry->d_name);
+        ++num_fds;
+      }
+    } else {
+      break;
+    }
+  }
+
+  // by closing the directory, we invalidate the FDs opened by opendir/readdir
+  closedir(dir);
+
+  for(int i = 0; i < num_fds; ++i) {
+    struct stat fd_stat;
+    if(fcntl(fds[i], F_GETFL, 0) !=
+       -1) {  // valid FD (not related to /proc/pid/fdinfo traversal)
+      int fd = fds[i];
+      if(fd <= 2)
+        continue;  // do not decouple standard input/output/error
+      if(fstat(fd, &fd_stat) || !S_ISREG(fd_stat.st_mode))
+        continue;  // pipes, sockets, ... cannot be reopened
+      char fd_path[MAX_STR_LENGTH + 1];
+      uns  len = snprintf(fd_path, MAX_STR_LENGTH, "/proc/%d/fd/%d", getpid(),
+                         fd);
+      ASSERT(0, len < MAX_STR_LENGTH);
+      char path[MAX_STR_LENGTH + 1];
+      uns  path_len = readlink(fd_path, path, MAX_STR_LENGTH);
+      ASSERT(0, path_len < MAX_STR_LENGTH);
+      path[path_len] = 0;  // null terminator
+      int64 offset   = lseek(fd, 0, SEEK_CUR);
+      int   flags    = fcntl(fd, F_GETFL, 0) & ~O_CREAT & ~O_EXCL & ~O_NOCTTY &
+                  ~O_TRUNC;  // clear file creation flags for safety
+      int close_rc = close(fd);
+      ASSERT(0, close_rc == 0);
+      int open_fd = open(path, flags);
+      ASSERT(0, open_fd != -1);
+      if(open_fd != fd) {
+        int new_fd = dup2(open_fd, fd);
+        ASSERT(0, new_fd == fd);
+        int close_rc = close(open_fd);
+        ASSERT(0, close_rc == 0);
+      }
+      int ret_offset = lseek(fd, offset, SEEK_SET);
+      ASSERT(0, ret_offset == offset);
+    } else {
+      ASSERT(0, errno == EBADF);
+      errno = 0;
+    }
+  }
+}
+
 /**************************************************************************************/
 // factorial:
 
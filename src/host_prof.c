@@ -0,0 +1,133 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : host_prof.c
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Host-side profiler: measures how much of the simulator's own run
+ *                time each pipeline stage and memory phase takes
+ ***************************************************************************************/
+
+#include "host_prof.h"
+#include <stdio.h>
+#include <string.h>
+#include "globals/assert.h"
+#include "globals/global_defs.h"
+#include "globals/global_vars.h"
+#include "globals/utils.h"
+
+/**************************************************************************************/
+/* Global Variables */
+
+uns64 host_prof_ticks[NUM_HOST_PROF_PHASES];
+
+static const char* const host_prof_names[NUM_HOST_PROF_PHASES] = {
+  "cycle",   "dcache",    "exec",      "node",      "map",       "uop_queue",
+  "decode",  "dfe",       "fe_fetch",  "fdip",      "icache",    "pref_plugin",
+  "sched",   "mem_pref",  "mem_queue", "mem_fill",  "ramulator", "mem_reqs",
+  "mem_core_fill",
+};
+
+static FILE*   file;
+static uns64   interval_start_ticks[NUM_HOST_PROF_PHASES];
+static Counter interval_start_cycle;
+static uns64   run_start_ticks;
+
+/**************************************************************************************/
+/* Local Prototypes */
+
+static void print_interval(void);
+
+/**************************************************************************************/
+/* host_prof_init: */
+
+void host_prof_init(void) {
+  if(!HOST_PROF)
+    return;
+
+  if(file)  // reopened in the OUTPUT_DIR of a sweep point
+    fclose(file);
+  file = file_tag_fopen(OUTPUT_DIR, HOST_PROF_FILE, "w");
+  ASSERTM(0, file, "Could not open %s\n", HOST_PROF_FILE);
+
+  /* one line per interval with the host ticks spent in each phase */
+  fprintf(file, "%-12s", "cycles");
+  for(uns ii = 0; ii < NUM_HOST_PROF_PHASES; ii++)
+    fprintf(file, " %14s", host_prof_names[ii]);
+  fprintf(file, "\n");
+
+  memset(host_prof_ticks, 0, sizeof(host_prof_ticks));
+  memset(interval_start_ticks, 0, sizeof(interval_start_ticks));
+  interval_start_cycle = cycle_count;
+  run_start_ticks      = host_prof_now();
+}
+
+/**************************************************************************************/
+/* host_prof_cycle: */
+
+void host_prof_cycle(void) {
+  if(!HOST_PROF)
+    return;
+
+  if(cycle_count - interval_start_cycle >= HOST_PROF_INTERVAL)
+    print_interval();
+}
+
+/**************************************************************************************/
+/* host_prof_done: */
+
+void host_prof_done(void) {
+  if(!HOST_PROF)
+    return;
+
+  print_interval();
+
+  uns64 run_ticks   = host_prof_now() - run_start_ticks;
+  uns64 cycle_ticks = host_prof_ticks[HP_CYCLE];
+  fprintf(file, "\n%-16s %18s %8s %8s %14s\n", "phase", "ticks", "%cycle",
+          "%run", "ticks/cycle");
+  for(uns ii = 0; ii < NUM_HOST_PROF_PHASES; ii++) {
+    fprintf(file, "%-16s %18llu %8.2f %8.2f %14.1f\n", host_prof_names[ii],
+            host_prof_ticks[ii],
+            cycle_ticks ? 100.0 * host_prof_ticks[ii] / cycle_ticks : 0.0,
+            run_ticks ? 100.0 * host_prof_ticks[ii] / run_ticks : 0.0,
+            cycle_count ? (double)host_prof_ticks[ii] / cycle_count : 0.0);
+  }
+  fprintf(file, "%-16s %18llu %8s %8.2f\n", "run", run_ticks, "",
+          run_ticks ? 100.0 : 0.0);
+
+  fclose(file);
+  file = NULL;
+}
+
+/**************************************************************************************/
+/* print_interval: */
+
+static void print_interval(void) {
+  fprintf(file, "%-12llu", cycle_count);
+  for(uns ii = 0; ii < NUM_HOST_PROF_PHASES; ii++) {
+    fprintf(file, " %14llu", host_prof_ticks[ii] - interval_start_ticks[ii]);
+    interval_start_ticks[ii] = host_prof_ticks[ii];
+  }
+  fprintf(file, "\n");
+  interval_start_cycle = cycle_count;
+}
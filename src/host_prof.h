@@ -0,0 +1,110 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : host_prof.h
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Host-side profiler: measures how much of the simulator's own run
+ *                time each pipeline stage and memory phase takes
+ ***************************************************************************************/
+
+#ifndef __HOST_PROF_H__
+#define __HOST_PROF_H__
+
+#include "globals/global_types.h"
+#include "general.param.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+/**************************************************************************************/
+/* Types */
+
+typedef enum Host_Prof_Phase_enum {
+  HP_CYCLE, /* whole model cycle, the other phases are part of it */
+  HP_DCACHE,
+  HP_EXEC,
+  HP_NODE,
+  HP_MAP,
+  HP_UOP_QUEUE,
+  HP_DECODE,
+  HP_DECOUPLED_FE,
+  HP_FE_FETCH, /* part of HP_DECOUPLED_FE */
+  HP_FDIP,
+  HP_ICACHE,
+  HP_PREF_PLUGIN, /* prefetcher plugin cycle_operate and issue */
+  HP_NODE_SCHED,
+  HP_MEM_PREF,
+  HP_MEM_QUEUES,
+  HP_MEM_FILL,
+  HP_RAMULATOR,
+  HP_MEM_REQS,
+  HP_MEM_CORE_FILL,
+  NUM_HOST_PROF_PHASES
+} Host_Prof_Phase;
+
+/**************************************************************************************/
+/* Global Variables */
+
+extern uns64 host_prof_ticks[NUM_HOST_PROF_PHASES];
+
+/**************************************************************************************/
+/* Inline functions */
+
+static inline uns64 host_prof_now(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uns64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+/* Runs stmt, charging its host time to phase when HOST_PROF is on */
+#define HOST_PROF_TIME(phase, stmt)                                 \
+  do {                                                              \
+    if(HOST_PROF) {                                                 \
+      uns64 host_prof_start_ = host_prof_now();                     \
+      stmt;                                                         \
+      host_prof_ticks[phase] += host_prof_now() - host_prof_start_; \
+    } else {                                                        \
+      stmt;                                                         \
+    }                                                               \
+  } while(0)
+
+/**************************************************************************************/
+/* Prototypes */
+
+/* Open the host profile file */
+void host_prof_init(void);
+
+/* Call every cycle */
+void host_prof_cycle(void);
+
+/* Write the run totals and clean up */
+void host_prof_done(void);
+
+#endif  // __HOST_PROF_H__
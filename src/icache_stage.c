@@ -39,6 +39,7 @@
 #include "icache_stage.h"
 #include "map.h"
 #include "op_pool.h"
+#include "pc_prof.h"
 #include "thread.h"
 #include "sim.h"
 
@@ -50,6 +51,7 @@
 #include "frontend/pin_trace_fe.h"
 #include "memory/memory.h"
 #include "memory/memory.param.h"
+#include "memory/tlb.h"
 #include "prefetcher/l2l1pref.h"
 #include "prefetcher/stream_pref.h"
 #include "statistics.h"
@@ -57,9 +59,7 @@
 
 /*#include "prefetcher/fdip.h"*/
 #include "prefetcher/fdip_new.h"
-#include "prefetcher/eip.h"
-#include "prefetcher/D_JOLT.h"
-#include "prefetcher/FNL+MMA.h"
+#include "prefetcher/pref_plugin.h"
 #include "prefetcher/pref.param.h"
 #include "uop_queue_stage.h"
 #include "decode_stage.h"
@@ -74,7 +74,7 @@
 
 /**************************************************************************************/
 
-Icache_Stage* ic = NULL;
+CORE_LOCAL Icache_Stage* ic = NULL;
 
 extern Cmp_Model              cmp_model;
 extern Memory*                mem;
@@ -90,6 +90,7 @@ static inline void         prefetcher_update_on_icache_access(Flag icache_hit);
 static inline void         icache_hit_events(Flag uop_cache_hit);
 static inline void         icache_miss_events(Flag uop_cache_hit);
 static inline Flag         mem_req_on_icache_miss(void);
+static inline Flag         icache_translate_next_ft(void);
 static inline void         uop_cache_to_icache_switch_stats(void);
 static Inst_Info**         ic_pref_cache_access(void);
 int32_t                    inst_lost_get_full_window_reason(void);
@@ -102,6 +103,8 @@ static inline void         update_stats_bf_retired(void);
 /* set_icache_stage: */
 
 void set_icache_stage(Icache_Stage* new_ic) {
+  if(new_ic != ic)
+    core_context = NULL; /* only one stage of another core is selected */
   ic = new_ic;
 }
 
@@ -182,7 +185,7 @@ void reset_icache_stage() {
 
   ic->off_path                       = FALSE;
   ic->back_on_path                   = FALSE;
-  op_count[ic->proc_id]              = 1;
+  op_count[ic->proc_id]              = uop_count[ic->proc_id] + 1;
   unique_count_per_core[ic->proc_id] = 1;
 }
 
@@ -239,6 +242,7 @@ void recover_icache_stage() {
     }
   }
   op_count[ic->proc_id] = bp_recovery_info->recovery_op_num + 1;
+  ic->itlb_miss         = FALSE;
 
   uop_cache_clear_lookup_buffer();
 }
@@ -323,12 +327,8 @@ Inst_Info** lookup_cache() {
 }
 
 void prefetcher_update_on_icache_access(Flag icache_hit) {
-  if(EIP_ENABLE)
-    eip_prefetch(ic->proc_id, ic->fetch_addr, icache_hit, 0, ic->off_path);
-  if(DJOLT_ENABLE)
-    djolt_prefetch(ic->proc_id, ic->fetch_addr, icache_hit, 0);
-  if(FNLMMA_ENABLE)
-    fnlmma_prefetch(ic->proc_id, ic->fetch_addr, icache_hit, 0);
+  pref_plugin_operate(ic->proc_id, PREF_PLUGIN_L1I, ic->fetch_addr,
+                      ic->fetch_addr, icache_hit, 0, ic->off_path);
 }
 
 void icache_hit_events(Flag uop_cache_hit) {
@@ -362,6 +362,21 @@ void icache_miss_events(Flag uop_cache_hit) {
     prefetcher_update_on_icache_access(/*icache_hit*/ FALSE);
     log_stats_ic_miss();
     log_stats_mshr_hit(ic->line_addr);
+    if(!ic->off_path)
+      PC_PROF_EVENT(ic->proc_id, PP_ICACHE_MISS, ic->line_addr, 1);
+}
+
+/**************************************************************************************/
+/* icache_translate_next_ft: looks up the ITLB for the start of the next
+   fetch target. Returns FALSE while the translation misses. */
+
+Flag icache_translate_next_ft() {
+  FT_Info next_ft = decoupled_fe_peek_ft(ic->proc_id);
+  Flag    hit     = tlb_translate(ic->proc_id, TLB_INST,
+                                  next_ft.static_info.start, ic->off_path,
+                                  ic->itlb_miss);
+  ic->itlb_miss   = !hit;
+  return hit;
 }
 
 Flag mem_req_on_icache_miss() {
@@ -502,6 +517,14 @@ void update_icache_stage() {
         ASSERT(ic->proc_id, get_stat(ic->proc_id, "ST_BREAK_APP_EXIT"));
         break_fetch = BREAK_FT_UNAVAILABLE;
         ic->next_state = SERVING_INIT;
+      } else if (TLB_ENABLE && !icache_translate_next_ft()) {
+        // wait for the ITLB miss, then fetch the FT
+        break_fetch = BREAK_WAIT_FOR_ITLB;
+        if (ic->state == ICACHE_FINISHED_FT_EXPECTING_NEXT) {
+          ic->next_state = ICACHE_FINISHED_FT;
+        } else {
+          ic->next_state = ic->state;
+        }
       } else {
         ic->current_ft_info = decoupled_fe_fetch_ft(ic->proc_id);
 
@@ -881,8 +904,9 @@ static inline void icache_process_ops(Stage_Data* cur_data) {
 
     if(op->table_info->cf_type) {
       //TODO: can we move this prefetch update to decoupled front-end or need it be here?
-      if(DJOLT_ENABLE)
-        update_djolt(ic->proc_id, op->inst_info->addr, op->table_info->cf_type, op->oracle_info.pred_npc);
+      pref_plugin_branch_operate(ic->proc_id, op->inst_info->addr,
+                                 op->table_info->cf_type,
+                                 op->oracle_info.pred_npc);
 
       ASSERT(ic->proc_id,
              (op->oracle_info.mispred << 2 | op->oracle_info.misfetch << 1 |
@@ -963,6 +987,8 @@ Flag icache_fill_line(Mem_Req* req)  // cmp FIXME maybe needed to be optimized
     ic->line = (Inst_Info**)cache_insert(&ic->icache, ic->proc_id,
                                          ic->fetch_addr, &ic->line_addr,
                                          &repl_line_addr);
+    pref_plugin_cache_fill(ic->proc_id, PREF_PLUGIN_L1I, req->addr,
+                           repl_line_addr);
     DEBUG(ic->proc_id, "Got line switch into ic fetch %llx\n", ic->line_addr);
     STAT_EVENT(ic->proc_id, ICACHE_FILL);
 
@@ -972,8 +998,6 @@ Flag icache_fill_line(Mem_Req* req)  // cmp FIXME maybe needed to be optimized
                                              &repl_line_addr2);
       if (line_info) {
         wp_process_icache_evicted(line_info, req, &repl_line_addr2);
-        if(EIP_ENABLE)
-          eip_cache_fill(ic->proc_id, req->addr, repl_line_addr2);
         line_info->fetched_by_offpath = USE_CONFIRMED_OFF ?
           req->off_path_confirmed :
           req->off_path;
@@ -1035,6 +1059,8 @@ Flag icache_fill_line(Mem_Req* req)  // cmp FIXME maybe needed to be optimized
 
     line = (Inst_Info**)cache_insert(&ic->icache, ic->proc_id, req->addr,
                                      &dummy_addr, &repl_line_addr);
+    pref_plugin_cache_fill(ic->proc_id, PREF_PLUGIN_L1I, req->addr,
+                           repl_line_addr);
 
     if(WP_COLLECT_STATS) {  // cmp IGNORE
       line_info = (Icache_Data*)cache_insert(&ic->icache_line_info, ic->proc_id,
@@ -1044,8 +1070,6 @@ Flag icache_fill_line(Mem_Req* req)  // cmp FIXME maybe needed to be optimized
         STAT_EVENT(ic->proc_id, ICACHE_FILL);
 
         wp_process_icache_evicted(line_info, req, &repl_line_addr2);
-        if(EIP_ENABLE)
-          eip_cache_fill(ic->proc_id, req->addr, repl_line_addr2);
         line_info->fetched_by_offpath = USE_CONFIRMED_OFF ?
           req->off_path_confirmed :
           req->off_path;
@@ -29,6 +29,7 @@
 #ifndef __ICACHE_STAGE_H__
 #define __ICACHE_STAGE_H__
 
+#include "globals/global_defs.h"
 #include "globals/global_types.h"
 #include "libs/cache_lib.h"
 #include "stage_data.h"
@@ -71,6 +72,7 @@ typedef enum Break_Reason_enum {
   BREAK_ICACHE_MISS_REQ_SUCCESS,     // break because of an icache miss where the mem req succeeds
   BREAK_ICACHE_MISS_REQ_FAILURE,     // break because of an icache miss where the mem req fails
   BREAK_WAIT_FOR_MISS,
+  BREAK_WAIT_FOR_ITLB, // break because the fetch target's translation missed in the ITLB
   BREAK_UOP_CACHE_READ_LIMIT,        // break because the uop cache has limited read capability
   BREAK_UOP_CACHE_READ_LIMIT_AND_ISSUE_WIDTH,       // break because the uop cache has limited read capability and the issue width has been reached
   BREAK_ICACHE_READ_LIMIT,           // break because the uop cache has limited read capability
@@ -105,6 +107,7 @@ typedef struct Icache_Stage_struct {
 
   Counter rdy_cycle; /* cycle that the henry icache will return data (only used
                         in henry model) */
+  Flag itlb_miss;    /* waiting for the ITLB to translate the next FT */
 
   Cache icache;           /* the cache storage structure (caches Inst_Info *) */
   Cache icache_line_info; /* contains info about the icache lines */
@@ -132,7 +135,7 @@ typedef struct Icache_Data_struct {
 /**************************************************************************************/
 /* External Variables */
 
-extern Icache_Stage* ic;
+extern CORE_LOCAL Icache_Stage* ic;
 
 /**************************************************************************************/
 /* Prototypes */
@@ -1,7 +1,24 @@
 // CPP implementation of a cache.
+//
+// Cpp_Cache<Key, Data, Index_Policy, Repl_Policy_Type> is policy based: the set
+// index hash and the replacement policy are template parameters, so lookups are
+// resolved at compile time and inlined. All sets live in one contiguous entry
+// array (set s occupies entries [s * assoc, (s + 1) * assoc)).
+//
+// Index_Policy is constructed with (num_sets, line_bytes) and maps a key to a
+// set index with 'uns operator()(const Key&) const'. Cpp_Cache_Addr_Index is
+// provided for keys that convert to an Addr; non-power-of-two set counts are
+// supported through Cpp_Cache_Fast_Mod.
+//
+// Repl_Policy_Type is constructed with (num_sets, assoc, Repl_Policy) and
+// provides touch(set_idx, ways, way) and victim(set_idx, ways, assoc). The
+// default, Cpp_Cache_Repl_Dynamic, picks LRU, random or round-robin at run
+// time; Cpp_Cache_Repl_LRU, Cpp_Cache_Repl_Random and
+// Cpp_Cache_Repl_Round_Robin fix the policy at compile time.
 
 #include "libs/cpp_cache.h"
 #include <iostream>
+#include <limits>
 #include <list>
 #include <unordered_map>
 #include <vector>
@@ -26,148 +43,221 @@ struct Entry {
   Counter accessed_cycle;
 };
 
-template <typename User_Key_Type, typename User_Data_Type>
-class Set {
+// Cpp_Cache_Fast_Mod: x % divisor for a divisor fixed at construction, using a
+// precomputed 128-bit reciprocal (Lemire et al., "Faster Remainder by Direct
+// Computation") instead of a 64-bit division. Exact for all 64-bit x.
+class Cpp_Cache_Fast_Mod {
+  uns64             divisor;
+  unsigned __int128 reciprocal;
+
  public:
-  std::vector<Entry<User_Key_Type, User_Data_Type>> entries;
-  // for round-robin replacement policy
-  uns next_evict;
+  Cpp_Cache_Fast_Mod(uns64 d = 1) : divisor(d), reciprocal(~(unsigned __int128)0 / d + 1) {
+    ASSERT(0, d > 0);
+  }
+
+  inline uns64 mod(uns64 x) const {
+    unsigned __int128 low_bits = reciprocal * x;
+    // high 64 bits of the 192-bit product low_bits * divisor
+    unsigned __int128 bottom = ((low_bits & ~(uns64)0) * divisor) >> 64;
+    unsigned __int128 top    = (low_bits >> 64) * divisor;
+    return (uns64)((bottom + top) >> 64);
+  }
 };
 
-template <typename User_Key_Type, typename User_Data_Type>
-class Cpp_Cache {
- protected:
-  std::vector<Set<User_Key_Type, User_Data_Type>> sets;
-  Repl_Policy      repl_policy;
-  uns              assoc;
-  uns              num_sets;
-  uns              line_bytes;
+// Cpp_Cache_Addr_Index: set index of an address-like key, (key >> log2(line_bytes)) % num_sets
+template <typename User_Key_Type>
+class Cpp_Cache_Addr_Index {
+  uns                offset_bits;
+  Cpp_Cache_Fast_Mod set_mod;
+
+ public:
+  Cpp_Cache_Addr_Index(uns num_sets, uns line_bytes) : offset_bits(LOG2(line_bytes)), set_mod(num_sets) {}
 
-  // defines how to hash the key to the set index, need to be implemented by the user
-  virtual uns set_idx_hash(User_Key_Type key) = 0;
+  inline uns operator()(const User_Key_Type& key) const { return set_mod.mod((Addr)key >> offset_bits); }
+};
 
-  // replacement policy functions
-  virtual void update_repl_states(Set<User_Key_Type, User_Data_Type>& set, uns hit_idx);
-  virtual uns get_repl_idx(Set<User_Key_Type, User_Data_Type>& set);
+// replacement policies
 
+class Cpp_Cache_Repl_LRU {
  public:
-  Cpp_Cache() = default;
-  Cpp_Cache(uns nl, uns asc, uns lb, Repl_Policy rp) {
-    assoc           = asc;
-    num_sets        = nl / assoc;
-    line_bytes      = lb;
-    repl_policy     = rp;
-
-    sets            = std::vector<Set<User_Key_Type, User_Data_Type>>(num_sets);
-    for (uns i = 0; i < num_sets; i++) {
-      sets[i].entries.resize(assoc);
+  Cpp_Cache_Repl_LRU(uns num_sets, uns assoc, Repl_Policy rp) {}
+
+  template <typename Entry_Type>
+  inline void touch(uns set_idx, Entry_Type* ways, uns way) {
+    ways[way].accessed_cycle = cycle_count;
+  }
+
+  template <typename Entry_Type>
+  inline uns victim(uns set_idx, Entry_Type* ways, uns assoc) {
+    uns     repl_idx  = 0;
+    Counter lru_cycle = std::numeric_limits<Counter>::max();
+    for (uns i = 0; i < assoc; i++) {
+      // find smallest access cycle
+      if (ways[i].accessed_cycle < lru_cycle) {
+        repl_idx  = i;
+        lru_cycle = ways[i].accessed_cycle;
+      }
     }
+    return repl_idx;
   }
+};
+
+class Cpp_Cache_Repl_Random {
+ public:
+  Cpp_Cache_Repl_Random(uns num_sets, uns assoc, Repl_Policy rp) {}
+
+  template <typename Entry_Type>
+  inline void touch(uns set_idx, Entry_Type* ways, uns way) {}
 
-  User_Data_Type* access(User_Key_Type key, bool update_repl);
-  Entry<User_Key_Type, User_Data_Type> insert(User_Key_Type key, User_Data_Type data);
-  Entry<User_Key_Type, User_Data_Type> invalidate(User_Key_Type key);
+  template <typename Entry_Type>
+  inline uns victim(uns set_idx, Entry_Type* ways, uns assoc) {
+    return rand() % assoc;
+  }
 };
 
-template <typename User_Key_Type, typename User_Data_Type>
-void Cpp_Cache<User_Key_Type, User_Data_Type>::update_repl_states(Set<User_Key_Type, User_Data_Type>& set, uns hit_idx) {
-  switch(repl_policy) {
-    case REPL_TRUE_LRU: {
-      set.entries[hit_idx].accessed_cycle = cycle_count;
-    } break;
-    case REPL_RANDOM: {
-    } break;
-    case REPL_ROUND_ROBIN: {
-    } break;
-    default:
-      ASSERT(0, FALSE);  // unsupported
+class Cpp_Cache_Repl_Round_Robin {
+  std::vector<uns> next_evict;
+
+ public:
+  Cpp_Cache_Repl_Round_Robin(uns num_sets, uns assoc, Repl_Policy rp) : next_evict(num_sets, 0) {}
+
+  template <typename Entry_Type>
+  inline void touch(uns set_idx, Entry_Type* ways, uns way) {}
+
+  template <typename Entry_Type>
+  inline uns victim(uns set_idx, Entry_Type* ways, uns assoc) {
+    uns repl_idx        = (next_evict[set_idx] + 1) % assoc;
+    next_evict[set_idx] = repl_idx;
+    return repl_idx;
   }
-}
+};
 
-template <typename User_Key_Type, typename User_Data_Type>
-uns Cpp_Cache<User_Key_Type, User_Data_Type>::get_repl_idx(Set<User_Key_Type, User_Data_Type>& set) {
-  // if there are invalid entries, replace them
-  for (uns i = 0; i < assoc; i++) {
-    Entry<User_Key_Type, User_Data_Type> entry = set.entries[i];
-    if (!entry.valid) {
-      return i;
-    }
+// Cpp_Cache_Repl_Dynamic: one of the policies above, selected by a Repl_Policy parameter
+class Cpp_Cache_Repl_Dynamic {
+  Repl_Policy                repl_policy;
+  Cpp_Cache_Repl_LRU         lru;
+  Cpp_Cache_Repl_Random      random;
+  Cpp_Cache_Repl_Round_Robin round_robin;
+
+ public:
+  Cpp_Cache_Repl_Dynamic(uns num_sets, uns assoc, Repl_Policy rp)
+      : repl_policy(rp),
+        lru(num_sets, assoc, rp),
+        random(num_sets, assoc, rp),
+        round_robin(rp == REPL_ROUND_ROBIN ? num_sets : 0, assoc, rp) {
+    ASSERT(0, rp == REPL_TRUE_LRU || rp == REPL_RANDOM || rp == REPL_ROUND_ROBIN);  // unsupported
   }
 
-  // otherwise, replace according to the policy
-  uns repl_idx = 0;
-  switch(repl_policy) {
-    case REPL_TRUE_LRU: {
-      Counter lru_cycle = std::numeric_limits<Counter>::max();
-      for (uns i = 0; i < assoc; i++) {
-        Entry<User_Key_Type, User_Data_Type> entry = set.entries[i];
-        // find smallest access cycle
-        if (entry.accessed_cycle < lru_cycle) {
-          repl_idx = i;
-          lru_cycle = entry.accessed_cycle;
-        }
-      }
-    } break;
-    case REPL_RANDOM: {
-      repl_idx = rand() % assoc;
-    } break;
-    case REPL_ROUND_ROBIN: {
-      repl_idx = (set.next_evict + 1) % assoc;
-      set.next_evict = repl_idx;
-    } break;
-    default:
-      ASSERT(0, FALSE);  // unsupported
+  template <typename Entry_Type>
+  inline void touch(uns set_idx, Entry_Type* ways, uns way) {
+    if (repl_policy == REPL_TRUE_LRU)
+      lru.touch(set_idx, ways, way);
   }
-  return repl_idx;
-}
+
+  template <typename Entry_Type>
+  inline uns victim(uns set_idx, Entry_Type* ways, uns assoc) {
+    switch (repl_policy) {
+      case REPL_TRUE_LRU:
+        return lru.victim(set_idx, ways, assoc);
+      case REPL_RANDOM:
+        return random.victim(set_idx, ways, assoc);
+      case REPL_ROUND_ROBIN:
+        return round_robin.victim(set_idx, ways, assoc);
+      default:
+        ASSERT(0, FALSE);  // unsupported
+        return 0;
+    }
+  }
+};
+
+template <typename User_Key_Type, typename User_Data_Type, typename Index_Policy = Cpp_Cache_Addr_Index<User_Key_Type>,
+          typename Repl_Policy_Type = Cpp_Cache_Repl_Dynamic>
+class Cpp_Cache {
+ public:
+  typedef Entry<User_Key_Type, User_Data_Type> Entry_Type;
+
+ protected:
+  std::vector<Entry_Type> entries;  // num_sets * assoc, set-major
+  uns              assoc;
+  uns              num_sets;
+  uns              line_bytes;
+  Index_Policy     set_idx_hash;
+  Repl_Policy_Type repl;
+
+  inline Entry_Type* set_ways(uns set_idx) { return &entries[(size_t)set_idx * assoc]; }
+
+ public:
+  Cpp_Cache(uns nl, uns asc, uns lb, Repl_Policy rp)
+      : entries((size_t)nl / asc * asc),
+        assoc(asc),
+        num_sets(nl / asc),
+        line_bytes(lb),
+        set_idx_hash(num_sets, lb),
+        repl(num_sets, asc, rp) {}
+
+  User_Data_Type* access(const User_Key_Type& key, bool update_repl);
+  Entry_Type insert(const User_Key_Type& key, const User_Data_Type& data);
+  Entry_Type invalidate(const User_Key_Type& key);
+};
 
 // access: Looks up the cache based on key. Returns pointer to line data if found
-template <typename User_Key_Type, typename User_Data_Type>
-User_Data_Type* Cpp_Cache<User_Key_Type, User_Data_Type>::access(User_Key_Type key, bool update_repl) {
-  User_Data_Type* data = NULL;
-  uns set_idx = set_idx_hash(key);
+template <typename User_Key_Type, typename User_Data_Type, typename Index_Policy, typename Repl_Policy_Type>
+inline User_Data_Type* Cpp_Cache<User_Key_Type, User_Data_Type, Index_Policy, Repl_Policy_Type>::access(
+    const User_Key_Type& key, bool update_repl) {
+  uns         set_idx = set_idx_hash(key);
+  Entry_Type* ways    = set_ways(set_idx);
   for (uns i = 0; i < assoc; i++) {
-    Entry<User_Key_Type, User_Data_Type>& entry = sets[set_idx].entries[i];
-    if (entry.valid && entry.key == key) {  // hit
-      data = &entry.data;
+    if (ways[i].valid && ways[i].key == key) {  // hit
       if (update_repl) {
-        update_repl_states(sets[set_idx], i);
+        repl.touch(set_idx, ways, i);
       }
-      break;
+      return &ways[i].data;
     }
   }
-  return data;
+  return NULL;
 }
 
-template <typename User_Key_Type, typename User_Data_Type>
-Entry<User_Key_Type, User_Data_Type> Cpp_Cache<User_Key_Type, User_Data_Type>::insert(User_Key_Type key, User_Data_Type data) {
+template <typename User_Key_Type, typename User_Data_Type, typename Index_Policy, typename Repl_Policy_Type>
+inline Entry<User_Key_Type, User_Data_Type> Cpp_Cache<User_Key_Type, User_Data_Type, Index_Policy,
+                                                      Repl_Policy_Type>::insert(const User_Key_Type&  key,
+                                                                                const User_Data_Type& data) {
   // first check if line exists
   ASSERT(0, access(key, FALSE) == NULL);
 
-  uns set_idx = set_idx_hash(key);
-  // if the set is full, repl_idx will be overwritten;
-  // if the set has vacancy, repl_idx will point to an invalid line
-  uns repl_idx = get_repl_idx(sets[set_idx]);
+  uns         set_idx = set_idx_hash(key);
+  Entry_Type* ways    = set_ways(set_idx);
+  // if the set has vacancy, repl_idx will point to an invalid line;
+  // otherwise the line chosen by the replacement policy will be overwritten
+  uns repl_idx = assoc;
+  for (uns i = 0; i < assoc; i++) {
+    if (!ways[i].valid) {
+      repl_idx = i;
+      break;
+    }
+  }
+  if (repl_idx == assoc) {
+    repl_idx = repl.victim(set_idx, ways, assoc);
+  }
 
-  Entry<User_Key_Type, User_Data_Type> evicted_entry = sets[set_idx].entries[repl_idx];
-  sets[set_idx].entries[repl_idx] = Entry<User_Key_Type, User_Data_Type>{TRUE, key, data, 0};
-  update_repl_states(sets[set_idx], repl_idx);
+  Entry_Type evicted_entry = ways[repl_idx];
+  ways[repl_idx]           = Entry_Type{TRUE, key, data, 0};
+  repl.touch(set_idx, ways, repl_idx);
 
   // the evicted entry is an eviciton victim if and only if it is valid
   return evicted_entry;
 }
 
-template <typename User_Key_Type, typename User_Data_Type>
-Entry<User_Key_Type, User_Data_Type> Cpp_Cache<User_Key_Type, User_Data_Type>::invalidate(User_Key_Type key) {
-  uns set_idx = set_idx_hash(key);
-  Entry<User_Key_Type, User_Data_Type> invalidated_entry{};
+template <typename User_Key_Type, typename User_Data_Type, typename Index_Policy, typename Repl_Policy_Type>
+inline Entry<User_Key_Type, User_Data_Type> Cpp_Cache<User_Key_Type, User_Data_Type, Index_Policy,
+                                                      Repl_Policy_Type>::invalidate(const User_Key_Type& key) {
+  Entry_Type* ways = set_ways(set_idx_hash(key));
+  Entry_Type  invalidated_entry{};
   for (uns i = 0; i < assoc; i++) {
-    Entry<User_Key_Type, User_Data_Type>& entry = sets[set_idx].entries[i];
-    if (entry.valid && entry.key == key) {  // hit
-      invalidated_entry = entry;
-      entry.valid = FALSE;
+    if (ways[i].valid && ways[i].key == key) {  // hit
+      invalidated_entry = ways[i];
+      ways[i].valid     = FALSE;
       break;
     }
   }
   return invalidated_entry;
-}
\ No newline at end of file
+}
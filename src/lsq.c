@@ -0,0 +1,424 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : lsq.c
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Load/store queue model (enabled with LSQ_ENABLE).
+ *
+ * Memory dependences are set up at fetch, like map_mem_dep does: every store
+ * enters an address-ordered list of in-flight stores, and every load looks up
+ * the youngest older store it overlaps through a partial-address filter. The
+ * load only waits for a store if the memory dependence predictor (store sets,
+ * or the oracle with STORE_SETS off) tells it to. When the load accesses the
+ * data cache, the store it overlaps decides the outcome: the data is forwarded
+ * if the store contains the load, a partial overlap still accesses the cache
+ * but waits for the store data, and a store that has not executed yet is a
+ * memory order violation, which trains the store sets and adds
+ * LSQ_VIOLATION_PENALTY cycles to the cache access (the squash and
+ * re-execution are not modeled). LQ/SQ capacity is enforced when ops are dispatched into the node
+ * table and released at retirement.
+ ***************************************************************************************/
+
+#include "debug/debug_macros.h"
+#include "debug/debug_print.h"
+#include "globals/assert.h"
+#include "globals/global_defs.h"
+#include "globals/global_types.h"
+#include "globals/global_vars.h"
+#include "globals/utils.h"
+
+#include "lsq.h"
+#include "map.h"
+
+#include "core.param.h"
+#include "debug/debug.param.h"
+#include "memory/memory.param.h"
+#include "statistics.h"
+
+/**************************************************************************************/
+/* Macros */
+
+#define DEBUG(proc_id, args...) _DEBUG(proc_id, DEBUG_LSQ, ##args)
+
+#define LSQ_INIT_STORES 64
+#define LSQ_CHUNK_LOG 3 /* filter granularity: 8 bytes */
+#define LSQ_INVALID_SSID ((uns)-1)
+
+#define LSQ_STORE(ii) \
+  (&lsq_data->stores[(lsq_data->stores_head + (ii)) & (lsq_data->stores_size - 1)])
+#define SSIT_INDEX(pc) (((pc) ^ ((pc) >> LOG2(SSIT_SIZE))) & (SSIT_SIZE - 1))
+
+
+/**************************************************************************************/
+/* Global Variables */
+
+CORE_LOCAL Lsq_Data* lsq_data = NULL;
+
+
+/**************************************************************************************/
+/* Static prototypes */
+
+static inline void       lsq_filter_update(Addr va, uns size, int delta);
+static inline Flag       lsq_filter_test(Addr va, uns size);
+static inline Lsq_Store* lsq_find_store(Addr va, uns size);
+static inline void       lsq_push_store(Op* op);
+static inline Op*        store_sets_lfst(uns ssid, Op* op);
+static inline void       store_sets_train(Addr ld_pc, Addr st_pc);
+
+
+/**************************************************************************************/
+/* set_lsq_data: */
+
+void set_lsq_data(Lsq_Data* new_lsq_data) {
+  lsq_data = new_lsq_data;
+}
+
+
+/**************************************************************************************/
+/* init_lsq: */
+
+void init_lsq(uns8 proc_id) {
+  ASSERT(proc_id, lsq_data);
+  memset(lsq_data, 0, sizeof(Lsq_Data));
+  lsq_data->proc_id = proc_id;
+  if(!LSQ_ENABLE)
+    return;
+
+  ASSERTM(proc_id, is_power_of_2(LSQ_FILTER_SIZE),
+          "LSQ_FILTER_SIZE must be a power of 2\n");
+  ASSERTM(proc_id, is_power_of_2(SSIT_SIZE), "SSIT_SIZE must be a power of 2\n");
+  ASSERTM(proc_id, LFST_SIZE > 0, "LFST_SIZE must be positive\n");
+
+  lsq_data->stores_size = LSQ_INIT_STORES;
+  lsq_data->stores = (Lsq_Store*)malloc(sizeof(Lsq_Store) * LSQ_INIT_STORES);
+  lsq_data->filter = (uns*)calloc(LSQ_FILTER_SIZE, sizeof(uns));
+  lsq_data->ssit   = (uns*)malloc(sizeof(uns) * SSIT_SIZE);
+  lsq_data->lfst   = (Lsq_Lfst_Entry*)calloc(LFST_SIZE, sizeof(Lsq_Lfst_Entry));
+  for(uns ii = 0; ii < SSIT_SIZE; ii++)
+    lsq_data->ssit[ii] = LSQ_INVALID_SSID;
+}
+
+
+/**************************************************************************************/
+/* reset_lsq: drops all in-flight loads and stores (the learned store sets are
+   kept) */
+
+void reset_lsq() {
+  if(!LSQ_ENABLE)
+    return;
+  lsq_data->stores_head  = 0;
+  lsq_data->stores_count = 0;
+  lsq_data->lq_count     = 0;
+  lsq_data->sq_count     = 0;
+  memset(lsq_data->filter, 0, sizeof(uns) * LSQ_FILTER_SIZE);
+}
+
+
+/**************************************************************************************/
+/* recover_lsq: removes the stores younger than recovery_op_num */
+
+void recover_lsq(Counter recovery_op_num) {
+  if(!LSQ_ENABLE)
+    return;
+  while(lsq_data->stores_count) {
+    Lsq_Store* store = LSQ_STORE(lsq_data->stores_count - 1);
+    if(store->op_num <= recovery_op_num)
+      break;
+    lsq_filter_update(store->va, store->size, -1);
+    lsq_data->stores_count--;
+  }
+}
+
+
+/**************************************************************************************/
+/* lsq_filter_*: the filter counts the in-flight stores per hashed 8-byte
+   chunk. A zero count for every chunk of a load means no store can overlap
+   it. */
+
+static inline void lsq_filter_update(Addr va, uns size, int delta) {
+  if(!size)
+    return;
+  Addr first = va >> LSQ_CHUNK_LOG;
+  Addr last  = ADDR_PLUS_OFFSET(va, size - 1) >> LSQ_CHUNK_LOG;
+  for(Addr chunk = first; chunk <= last; chunk++)
+    lsq_data->filter[chunk & (LSQ_FILTER_SIZE - 1)] += delta;
+}
+
+static inline Flag lsq_filter_test(Addr va, uns size) {
+  if(!size)
+    return FALSE;
+  Addr first = va >> LSQ_CHUNK_LOG;
+  Addr last  = ADDR_PLUS_OFFSET(va, size - 1) >> LSQ_CHUNK_LOG;
+  for(Addr chunk = first; chunk <= last; chunk++)
+    if(lsq_data->filter[chunk & (LSQ_FILTER_SIZE - 1)])
+      return TRUE;
+  return FALSE;
+}
+
+
+/**************************************************************************************/
+/* lsq_find_store: youngest in-flight store that overlaps the access */
+
+static inline Lsq_Store* lsq_find_store(Addr va, uns size) {
+  if(!lsq_filter_test(va, size)) {
+    STAT_EVENT(lsq_data->proc_id, LSQ_SQ_SEARCH_FILTERED);
+    return NULL;
+  }
+  STAT_EVENT(lsq_data->proc_id, LSQ_SQ_SEARCH);
+  for(uns ii = lsq_data->stores_count; ii > 0; ii--) {
+    Lsq_Store* store = LSQ_STORE(ii - 1);
+    if(store->size && BYTE_OVERLAP(store->va, store->size, va, size))
+      return store;
+  }
+  return NULL;
+}
+
+
+/**************************************************************************************/
+/* lsq_push_store: appends a fetched store, growing the list if needed */
+
+static inline void lsq_push_store(Op* op) {
+  if(lsq_data->stores_count == lsq_data->stores_size) {
+    uns        new_size   = lsq_data->stores_size * 2;
+    Lsq_Store* new_stores = (Lsq_Store*)malloc(sizeof(Lsq_Store) * new_size);
+    for(uns ii = 0; ii < lsq_data->stores_count; ii++)
+      new_stores[ii] = *LSQ_STORE(ii);
+    free(lsq_data->stores);
+    lsq_data->stores      = new_stores;
+    lsq_data->stores_size = new_size;
+    lsq_data->stores_head = 0;
+  }
+  Lsq_Store* store  = LSQ_STORE(lsq_data->stores_count);
+  store->op         = op;
+  store->unique_num = op->unique_num;
+  store->op_num     = op->op_num;
+  store->va         = op->oracle_info.va;
+  store->size       = op->oracle_info.mem_size;
+  lsq_data->stores_count++;
+  lsq_filter_update(store->va, store->size, +1);
+}
+
+
+/**************************************************************************************/
+/* store_sets_lfst: the last fetched store of a store set, if it is still in
+   flight and older than op */
+
+static inline Op* store_sets_lfst(uns ssid, Op* op) {
+  Lsq_Lfst_Entry* entry = &lsq_data->lfst[ssid];
+  if(entry->op && entry->op->op_pool_valid &&
+     entry->op->unique_num == entry->unique_num &&
+     entry->op->op_num < op->op_num)
+    return entry->op;
+  return NULL;
+}
+
+/**************************************************************************************/
+/* store_sets_train: puts a load and the store it ran ahead of in one set */
+
+static inline void store_sets_train(Addr ld_pc, Addr st_pc) {
+  uns* ld_ssid = &lsq_data->ssit[SSIT_INDEX(ld_pc)];
+  uns* st_ssid = &lsq_data->ssit[SSIT_INDEX(st_pc)];
+
+  if(*ld_ssid == LSQ_INVALID_SSID && *st_ssid == LSQ_INVALID_SSID) {
+    *ld_ssid = *st_ssid = lsq_data->next_ssid;
+    lsq_data->next_ssid = (lsq_data->next_ssid + 1) % LFST_SIZE;
+  } else if(*ld_ssid == LSQ_INVALID_SSID) {
+    *ld_ssid = *st_ssid;
+  } else if(*st_ssid == LSQ_INVALID_SSID) {
+    *st_ssid = *ld_ssid;
+  } else {
+    *ld_ssid = *st_ssid = MIN2(*ld_ssid, *st_ssid);
+  }
+}
+
+
+/**************************************************************************************/
+/* lsq_map_op: sets up the memory dependences of a fetched op (replaces
+   map_mem_dep's store map when LSQ_ENABLE is set) */
+
+void lsq_map_op(Op* op) {
+  ASSERT(lsq_data->proc_id, lsq_data->proc_id == op->proc_id);
+  op->lsq_store = NULL;
+
+  if(STORE_SETS && SSIT_CLEAR_INTERVAL &&
+     cycle_count >= lsq_data->last_ssit_clear + SSIT_CLEAR_INTERVAL) {
+    for(uns ii = 0; ii < SSIT_SIZE; ii++)
+      lsq_data->ssit[ii] = LSQ_INVALID_SSID;
+    lsq_data->last_ssit_clear = cycle_count;
+  }
+
+  if(op->table_info->mem_type == MEM_ST) {
+    if(STORE_SETS) {
+      /* stores of a set execute in order */
+      uns ssid = lsq_data->ssit[SSIT_INDEX(op->inst_info->addr)];
+      if(ssid != LSQ_INVALID_SSID) {
+        Op* prev_store = store_sets_lfst(ssid, op);
+        if(prev_store)
+          add_src_from_op(op, prev_store, MEM_ADDR_DEP);
+        lsq_data->lfst[ssid].op         = op;
+        lsq_data->lfst[ssid].unique_num = op->unique_num;
+      }
+    }
+    lsq_push_store(op);
+  } else if(op->table_info->mem_type == MEM_LD) {
+    Lsq_Store* store = lsq_find_store(op->oracle_info.va,
+                                      op->oracle_info.mem_size);
+    if(store) {
+      op->lsq_store        = store->op;
+      op->lsq_store_unique = store->unique_num;
+      STAT_EVENT(op->proc_id, FORWARDED_LD);
+    } else {
+      STAT_EVENT(op->proc_id, LD_NO_FORWARD);
+    }
+
+    if(STORE_SETS) {
+      uns ssid = lsq_data->ssit[SSIT_INDEX(op->inst_info->addr)];
+      Op* pred = ssid != LSQ_INVALID_SSID ? store_sets_lfst(ssid, op) : NULL;
+      if(pred) {
+        add_src_from_op(op, pred, MEM_DATA_DEP);
+        STAT_EVENT(op->proc_id, LSQ_LD_PRED_DEP);
+        if(pred != op->lsq_store)
+          STAT_EVENT(op->proc_id, LSQ_LD_PRED_OTHER_STORE);
+      }
+    } else if(store) {
+      add_src_from_op(op, store->op, MEM_DATA_DEP);
+    }
+    DEBUG(op->proc_id, "Load op_num:%s overlaps store op_num:%s\n",
+          unsstr64(op->op_num), store ? unsstr64(store->op_num) : "none");
+  }
+}
+
+
+/**************************************************************************************/
+/* lsq_can_dispatch: is there a LQ/SQ entry for the op? */
+
+Flag lsq_can_dispatch(Op* op) {
+  if(!LSQ_ENABLE)
+    return TRUE;
+  if(op->table_info->mem_type == MEM_LD && LOAD_QUEUE_SIZE &&
+     lsq_data->lq_count == LOAD_QUEUE_SIZE) {
+    STAT_EVENT(op->proc_id, LQ_FULL_STALL);
+    return FALSE;
+  }
+  if(op->table_info->mem_type == MEM_ST && STORE_QUEUE_SIZE &&
+     lsq_data->sq_count == STORE_QUEUE_SIZE) {
+    STAT_EVENT(op->proc_id, SQ_FULL_STALL);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/**************************************************************************************/
+/* lsq_dispatch: allocates the LQ/SQ entry of an op entering the node table */
+
+void lsq_dispatch(Op* op) {
+  if(!LSQ_ENABLE)
+    return;
+  if(op->table_info->mem_type == MEM_LD)
+    lsq_data->lq_count++;
+  else if(op->table_info->mem_type == MEM_ST)
+    lsq_data->sq_count++;
+}
+
+/**************************************************************************************/
+/* lsq_retire: frees the LQ/SQ entry of a retiring op */
+
+void lsq_retire(Op* op) {
+  if(!LSQ_ENABLE)
+    return;
+  lsq_flush(op);
+  if(op->table_info->mem_type == MEM_ST) {
+    Lsq_Store* store = LSQ_STORE(0);
+    ASSERTM(op->proc_id,
+            lsq_data->stores_count && store->unique_num == op->unique_num,
+            "Retiring store op_num:%s is not the oldest in-flight store\n",
+            unsstr64(op->op_num));
+    lsq_filter_update(store->va, store->size, -1);
+    lsq_data->stores_head = (lsq_data->stores_head + 1) &
+                            (lsq_data->stores_size - 1);
+    lsq_data->stores_count--;
+  }
+}
+
+/**************************************************************************************/
+/* lsq_flush: frees the LQ/SQ entry of an op removed from the node table (its
+   store list entry is removed by recover_lsq) */
+
+void lsq_flush(Op* op) {
+  if(!LSQ_ENABLE)
+    return;
+  if(op->table_info->mem_type == MEM_LD) {
+    ASSERT(op->proc_id, lsq_data->lq_count > 0);
+    lsq_data->lq_count--;
+  } else if(op->table_info->mem_type == MEM_ST) {
+    ASSERT(op->proc_id, lsq_data->sq_count > 0);
+    lsq_data->sq_count--;
+  }
+}
+
+
+/**************************************************************************************/
+/* lsq_load_exec: called when a load accesses the data cache. Returns TRUE if
+   an older in-flight store forwards all the load's data; *latency is then the
+   number of cycles until the data is available and the cache is not
+   accessed. Otherwise the load accesses the cache; a partial overlap or an
+   order violation sets op->lsq_penalty, which is added on top of that access.
+   The store is only checked once so a load that retries the cache (no miss
+   buffer) is not charged or counted twice. */
+
+Flag lsq_load_exec(Op* op, uns* latency) {
+  Op* store = op->lsq_store;
+  ASSERT(op->proc_id, op->table_info->mem_type == MEM_LD);
+
+  if(!store || !store->op_pool_valid || store->unique_num != op->lsq_store_unique)
+    return FALSE;  // no store or it retired (the store buffer is scanned on a miss)
+  op->lsq_store = NULL;
+
+  if(!store->wake_up_signaled[MEM_DATA_DEP]) {
+    /* the load ran ahead of the store: charged as a penalty on the access
+       instead of a squash and re-execution */
+    STAT_EVENT(op->proc_id, LSQ_LD_ORDER_VIOLATION_ONPATH + op->off_path);
+    if(STORE_SETS && !op->off_path)
+      store_sets_train(op->inst_info->addr, store->inst_info->addr);
+    op->lsq_penalty = LSQ_VIOLATION_PENALTY;
+    DEBUG(op->proc_id, "Order violation  load op_num:%s  store op_num:%s\n",
+          unsstr64(op->op_num), unsstr64(store->op_num));
+    return FALSE;
+  }
+
+  Counter data_cycle = MAX2(cycle_count, store->wake_cycle);
+  if(BYTE_CONTAIN(store->oracle_info.va, store->oracle_info.mem_size,
+                  op->oracle_info.va, op->oracle_info.mem_size)) {
+    STAT_EVENT(op->proc_id, LSQ_LD_FORWARDED_ONPATH + op->off_path);
+    *latency = data_cycle - cycle_count + DCACHE_CYCLES +
+               op->inst_info->extra_ld_latency;
+    return TRUE;
+  }
+
+  /* the rest of the data comes from the cache access, merged with the store
+     data once the store has executed */
+  STAT_EVENT(op->proc_id, LSQ_LD_PARTIAL_FORWARD_ONPATH + op->off_path);
+  op->lsq_penalty = data_cycle - cycle_count + LSQ_PARTIAL_FWD_PENALTY;
+  return FALSE;
+}
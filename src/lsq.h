@@ -0,0 +1,100 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : lsq.h
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Load/store queue model: LQ/SQ capacity, store-to-load
+ *                forwarding and store set memory dependence prediction.
+ ***************************************************************************************/
+
+#ifndef __LSQ_H__
+#define __LSQ_H__
+
+#include "globals/global_defs.h"
+#include "globals/global_types.h"
+#include "op.h"
+
+/**************************************************************************************/
+/* Types */
+
+typedef struct Lsq_Store_struct {
+  Op*     op;
+  Counter unique_num;
+  Counter op_num;
+  Addr    va;
+  uns     size;
+} Lsq_Store;
+
+typedef struct Lsq_Lfst_Entry_struct {
+  Op*     op; /* last fetched store of the store set */
+  Counter unique_num;
+} Lsq_Lfst_Entry;
+
+typedef struct Lsq_Data_struct {
+  uns8 proc_id;
+
+  /* in-flight (fetched, not retired) stores in program order, circular */
+  Lsq_Store* stores;
+  uns        stores_size; /* power of 2, grows when full */
+  uns        stores_head; /* oldest store */
+  uns        stores_count;
+  /* partial-address filter: number of in-flight stores touching each hashed
+     8-byte chunk, so most loads skip the store queue search */
+  uns* filter;
+
+  /* dispatched (in the node table) loads and stores, bounded by
+     LOAD_QUEUE_SIZE and STORE_QUEUE_SIZE */
+  uns lq_count;
+  uns sq_count;
+
+  /* store sets (Chrysos and Emer, ISCA 1998) */
+  uns*            ssit; /* store set ID per hashed PC */
+  Lsq_Lfst_Entry* lfst; /* last fetched store per store set ID */
+  uns             next_ssid;
+  Counter         last_ssit_clear;
+} Lsq_Data;
+
+
+/**************************************************************************************/
+/* External Variables */
+
+extern CORE_LOCAL Lsq_Data* lsq_data;
+
+
+/**************************************************************************************/
+/* Prototypes */
+
+void set_lsq_data(Lsq_Data*);
+void init_lsq(uns8);
+void reset_lsq(void);
+void recover_lsq(Counter);
+void lsq_map_op(Op*);
+Flag lsq_can_dispatch(Op*);
+void lsq_dispatch(Op*);
+void lsq_retire(Op*);
+void lsq_flush(Op*);
+Flag lsq_load_exec(Op*, uns*);
+
+/**************************************************************************************/
+
+#endif /* #ifndef __LSQ_H__ */
@@ -270,6 +270,15 @@ int main(int argc, char* argv[], char* envp[]) {
     case FULL_SIM_MODE:
       full_sim();
       break;
+    case SAMPLE_SIM_MODE:
+      sampling_sim();
+      break;
+    case SIMPOINT_SIM_MODE:
+      simpoint_sim();
+      break;
+    case MIX_SIM_MODE:
+      mix_sim();
+      break;
 #ifdef ENABLE_PT_MEMTRACE
     case TRACE_BBV_MODE:
     case TRACE_BBV_DISTRIBUTED_MODE:
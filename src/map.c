@@ -99,7 +99,7 @@ extern Op invalid_op;
 /**************************************************************************************/
 /* Global Variables */
 
-Map_Data* map_data = NULL;
+CORE_LOCAL Map_Data* map_data = NULL;
 
 const char* const dep_type_names[NUM_DEP_TYPES] = {
   "REG_DATA",
@@ -190,7 +190,8 @@ void recover_map() {
   for(ii = 0; ii < NUM_REG_IDS; ii++)
     map_data->map_flags[ii] = FALSE;
   map_data->last_store_flag = FALSE;
-  hash_table_scan(&map_data->oracle_mem_hash, recover_mem_map_entry, NULL);
+  if(!LSQ_ENABLE)
+    hash_table_scan(&map_data->oracle_mem_hash, recover_mem_map_entry, NULL);
   rebuild_offpath_map();
 }
 
@@ -221,7 +222,7 @@ void rebuild_offpath_map() {
   /* rebuild the map starting with the first offpath op */
   for(; op_p; op_p = (Op**)list_next_element(&td->seq_op_list)) {
     update_map(*op_p);
-    if((*op_p)->table_info->mem_type == MEM_ST) {
+    if((*op_p)->table_info->mem_type == MEM_ST && !LSQ_ENABLE) {
       update_store_hash(*op_p);
     }
   }
@@ -367,6 +368,10 @@ inline void update_map_entry(Op* op, Map_Entry* map_entry) {
 /* map_mem_dep */
 
 void map_mem_dep(Op* op) {
+  if(LSQ_ENABLE) {
+    lsq_map_op(op);  // the LSQ replaces the byte-level store map
+    return;
+  }
   if(!MEM_OBEY_STORE_DEP)
     return;
   if(op->table_info->mem_type == MEM_ST)
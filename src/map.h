@@ -29,6 +29,7 @@
 #ifndef __MAP_H__
 #define __MAP_H__
 
+#include "globals/global_defs.h"
 #include "isa/isa_macros.h"
 #include "libs/hash_lib.h"
 #include "libs/list_lib.h"
@@ -123,7 +124,7 @@ typedef struct Map_Data_struct {
 /**************************************************************************************/
 /* External Variables */
 
-extern Map_Data* map_data;
+extern CORE_LOCAL Map_Data* map_data;
 
 
 /**************************************************************************************/
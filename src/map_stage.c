@@ -59,7 +59,7 @@
 /**************************************************************************************/
 /* Global Variables */
 
-Map_Stage* map = NULL;
+CORE_LOCAL Map_Stage* map = NULL;
 // The next op number is used when deciding whether to consume ops from the
 // uop cache: i.e. check if any preceding instructions are still in the decoder.
 Counter map_stage_next_op_num = 1;
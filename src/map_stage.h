@@ -29,6 +29,7 @@
 #ifndef __MAP_STAGE_H__
 #define __MAP_STAGE_H__
 
+#include "globals/global_defs.h"
 #include "stage_data.h"
 
 
@@ -47,7 +48,7 @@ typedef struct Map_Stage_struct {
 /**************************************************************************************/
 /* External Variables */
 
-extern Map_Stage* map;
+extern CORE_LOCAL Map_Stage* map;
 
 
 /**************************************************************************************/
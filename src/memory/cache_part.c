@@ -428,7 +428,7 @@ void cache_part_init(void) {
     current_partition[proc_id] = L1_ASSOC / NUM_CORES;
     set_partition_allocate(&mem->uncores[0].l1->cache, proc_id,
                            current_partition[proc_id]);
-    GET_STAT_EVENT(proc_id, NORESET_L1_PARTITION) = current_partition[proc_id];
+    SET_STAT_EVENT(proc_id, NORESET_L1_PARTITION, current_partition[proc_id]);
   }
   new_partition       = calloc(NUM_CORES, sizeof(uns));
   temp_partition      = calloc(NUM_CORES, sizeof(uns));
@@ -729,7 +729,7 @@ void set_partition(void) {
     set_partition_allocate(&mem->uncores[0].l1->cache, proc_id,
                            new_partition[proc_id]);
     current_partition[proc_id]                    = new_partition[proc_id];
-    GET_STAT_EVENT(proc_id, NORESET_L1_PARTITION) = new_partition[proc_id];
+    SET_STAT_EVENT(proc_id, NORESET_L1_PARTITION, new_partition[proc_id]);
   }
   STAT_EVENT_ALL(L1_PARTITION_INTERVALS);
 }
@@ -151,6 +151,8 @@ struct Mem_Req_struct {
                                 satisfied? */
   Counter l1_miss_cycle;     /* cycle when this req missed in L1 */
   Counter mem_queue_cycle;   /* cycle this request entered the mem_queue */
+  struct Mem_Req_struct* ramulator_next; /* next request waiting for the same
+                                            Ramulator read (ramulator.cc) */
   Counter mem_crit_path_at_entry; /* DVFS perf pred: the global critical path
                                      estimate when the req entered the memory
                                      controller */
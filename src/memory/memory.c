@@ -58,6 +58,7 @@
 #include "prefetcher/stream_pref.h"
 #include "prefetcher/fdip_new.h"
 #include "statistics.h"
+#include "host_prof.h"
 //#include "dram.h"
 //#include "dram.param.h"
 #include "ramulator.h"
@@ -94,7 +95,7 @@ static uns      mem_req_pref_entries   = 0;
 static uns      mem_req_wb_entries     = 0;
 
 Memory*              mem = NULL;
-extern Icache_Stage* ic;
+extern CORE_LOCAL Icache_Stage* ic;
 extern Counter  last_recover_cycle;
 
 Counter Mem_Req_Priority[MRT_NUM_ELEMS];
@@ -918,33 +919,33 @@ void update_memory() {
 
     perf_pred_cycle();
 
-    pref_update();
-    update_memory_queues();
+    HOST_PROF_TIME(HP_MEM_PREF, pref_update());
+    HOST_PROF_TIME(HP_MEM_QUEUES, update_memory_queues());
     update_on_chip_memory_stats();
 
-    mem_process_mlc_fill_reqs();
-    mem_process_l1_fill_reqs();
+    HOST_PROF_TIME(HP_MEM_FILL, mem_process_mlc_fill_reqs();
+                                mem_process_l1_fill_reqs());
   }
 
   if(freq_is_ready(FREQ_DOMAIN_MEMORY)) {
     cycle_count = freq_cycle_count(FREQ_DOMAIN_MEMORY);
 
     // dram_process_main_memory_reqs();
-    ramulator_tick();
+    HOST_PROF_TIME(HP_RAMULATOR, ramulator_tick());
   }
 
   if(freq_is_ready(FREQ_DOMAIN_L1)) {
     cycle_count = freq_cycle_count(FREQ_DOMAIN_L1);
 
-    mem_process_bus_out_reqs();
-    mem_process_l1_reqs();
-    mem_process_mlc_reqs();
+    HOST_PROF_TIME(HP_MEM_REQS, mem_process_bus_out_reqs();
+                                mem_process_l1_reqs();
+                                mem_process_mlc_reqs());
   }
 
   for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
     if(freq_is_ready(FREQ_DOMAIN_CORES[proc_id])) {
       cycle_count = freq_cycle_count(FREQ_DOMAIN_CORES[proc_id]);
-      mem_process_core_fill_reqs(proc_id);
+      HOST_PROF_TIME(HP_MEM_CORE_FILL, mem_process_core_fill_reqs(proc_id));
     }
   }
 }
@@ -0,0 +1,497 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : memory/tlb.c
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Address translation timing model (enabled with TLB_ENABLE).
+ *
+ * Each core has an L1 ITLB and DTLB backed by a unified STLB. An L1 miss
+ * allocates one of TLB_MSHRS miss entries (later misses to the same page
+ * merge into it) and looks up the STLB. An STLB miss waits for one of
+ * PTW_WALKERS page table walkers, which walks a 4-level radix page table.
+ * The page walk caches skip the upper levels whose entries they hold, and
+ * every remaining level is a memory request (new_mem_req) that goes through
+ * the MLC/L1/DRAM hierarchy like any other data miss.
+ *
+ * The page tables are laid out per level in a region starting at
+ * PTW_TABLE_BASE, with the entry of a page at the position of its page
+ * number, so neighbouring pages share page table lines like they do in a
+ * real radix table. Pages are 4KB unless their 2MB region is listed in
+ * HUGE_PAGE_FILE or picked by HUGE_PAGE_PCT; a 2MB page is translated by the
+ * PD entry.
+ ***************************************************************************************/
+
+#include "debug/debug_macros.h"
+#include "debug/debug_print.h"
+#include "globals/assert.h"
+#include "globals/global_defs.h"
+#include "globals/global_types.h"
+#include "globals/global_vars.h"
+#include "globals/utils.h"
+
+#include "memory/memory.h"
+#include "memory/tlb.h"
+
+#include "core.param.h"
+#include "debug/debug.param.h"
+#include "freq.h"
+#include "memory/memory.param.h"
+#include "statistics.h"
+
+/**************************************************************************************/
+/* Macros */
+
+#define DEBUG(proc_id, args...) _DEBUG(proc_id, DEBUG_TLB, ##args)
+
+#define TLB_PAGE_BITS 12
+#define TLB_HUGE_PAGE_BITS 21
+#define TLB_LEVEL_BITS 9 /* 512 entries per page table page */
+#define TLB_PTE_SIZE 8
+#define TLB_KEY_LINE_SIZE 8 /* keys below are multiples of this */
+
+/* number of address bits translated below a page table level */
+#define TLB_LEVEL_SHIFT(level) \
+  (TLB_PAGE_BITS + TLB_LEVEL_BITS * ((level)-1))
+
+
+/**************************************************************************************/
+/* Types */
+
+typedef struct Huge_Page_Range_struct {
+  Addr start;
+  Addr end; /* exclusive */
+} Huge_Page_Range;
+
+
+/**************************************************************************************/
+/* Global Variables */
+
+static Tlb_Data*        tlb_data;
+static Huge_Page_Range* huge_ranges;
+static uns              num_huge_ranges;
+
+static const char* const tlb_names[NUM_TLB_TYPES] = {"ITLB", "DTLB"};
+
+
+/**************************************************************************************/
+/* Static prototypes */
+
+static void        read_huge_page_file(void);
+static Flag        tlb_is_huge_page(Addr va);
+static inline Addr tlb_strip_va(Addr va);
+static inline Addr tlb_key(Addr va, Flag huge);
+static inline Addr pwc_key(Addr va, uns level);
+static inline Addr pte_line_addr(uns8 proc_id, Addr va, uns level);
+static uns         tlb_walk_start_level(Tlb_Data* tlb, Addr va, Flag huge);
+static void        tlb_fill(Tlb_Data* tlb, Tlb_Miss* miss);
+
+
+/**************************************************************************************/
+/* init_tlb: */
+
+void init_tlb(uns8 proc_id) {
+  if(!TLB_ENABLE)
+    return;
+
+  if(!tlb_data) {
+    tlb_data = (Tlb_Data*)calloc(NUM_CORES, sizeof(Tlb_Data));
+    read_huge_page_file();
+  }
+
+  const uns pwc_entries[TLB_PT_LEVELS + 1] = {0, 0, PWC_PD_ENTRIES,
+                                              PWC_PDPT_ENTRIES,
+                                              PWC_PML4_ENTRIES};
+  Tlb_Data* tlb = &tlb_data[proc_id];
+  char      name[MAX_STR_LENGTH + 1];
+
+  tlb->proc_id = proc_id;
+  init_cache(&tlb->tlbs[TLB_INST], "ITLB", ITLB_ENTRIES * TLB_KEY_LINE_SIZE,
+             ITLB_ASSOC, TLB_KEY_LINE_SIZE, sizeof(Tlb_Entry), REPL_TRUE_LRU);
+  init_cache(&tlb->tlbs[TLB_DATA], "DTLB", DTLB_ENTRIES * TLB_KEY_LINE_SIZE,
+             DTLB_ASSOC, TLB_KEY_LINE_SIZE, sizeof(Tlb_Entry), REPL_TRUE_LRU);
+  init_cache(&tlb->stlb, "STLB", STLB_ENTRIES * TLB_KEY_LINE_SIZE, STLB_ASSOC,
+             TLB_KEY_LINE_SIZE, sizeof(Tlb_Entry), REPL_TRUE_LRU);
+  for(uns level = 2; level <= TLB_PT_LEVELS; level++) {
+    if(!pwc_entries[level])
+      continue;
+    /* page walk caches are fully associative */
+    snprintf(name, MAX_STR_LENGTH, "PWC_L%u", level);
+    init_cache(&tlb->pwc[level], name, pwc_entries[level] * TLB_KEY_LINE_SIZE,
+               pwc_entries[level], TLB_KEY_LINE_SIZE, sizeof(Tlb_Entry),
+               REPL_TRUE_LRU);
+  }
+
+  ASSERTM(proc_id, TLB_MSHRS > 0 && PTW_WALKERS > 0,
+          "TLB_MSHRS and PTW_WALKERS must be positive\n");
+  ASSERTM(proc_id, HUGE_PAGE_PCT <= 100, "HUGE_PAGE_PCT is a percentage\n");
+  tlb->misses       = (Tlb_Miss*)calloc(TLB_MSHRS, sizeof(Tlb_Miss));
+  tlb->active_walks = 0;
+}
+
+
+/**************************************************************************************/
+/* reset_tlb: drops the outstanding misses (the TLB contents are kept) */
+
+void reset_tlb(uns8 proc_id) {
+  if(!TLB_ENABLE)
+    return;
+  Tlb_Data* tlb = &tlb_data[proc_id];
+  memset(tlb->misses, 0, sizeof(Tlb_Miss) * TLB_MSHRS);
+  tlb->active_walks = 0;
+}
+
+
+/**************************************************************************************/
+/* read_huge_page_file: reads the 2MB page regions, one "start end" range of
+   hex virtual addresses per line (e.g. the AnonHugePages mappings of
+   /proc/<pid>/smaps recorded with the trace) */
+
+static void read_huge_page_file() {
+  if(!HUGE_PAGE_FILE)
+    return;
+  FILE* file = fopen(HUGE_PAGE_FILE, "r");
+  ASSERTM(0, file, "Could not open HUGE_PAGE_FILE %s\n", HUGE_PAGE_FILE);
+
+  uns                max_ranges = 64;
+  unsigned long long start, end;
+  huge_ranges = (Huge_Page_Range*)malloc(sizeof(Huge_Page_Range) * max_ranges);
+  while(fscanf(file, "%llx %llx", &start, &end) == 2) {
+    ASSERTM(0, start < end, "Bad HUGE_PAGE_FILE range %llx %llx\n", start,
+            end);
+    if(num_huge_ranges == max_ranges) {
+      max_ranges *= 2;
+      huge_ranges = (Huge_Page_Range*)realloc(
+        huge_ranges, sizeof(Huge_Page_Range) * max_ranges);
+    }
+    /* sorted insert */
+    uns ii = num_huge_ranges++;
+    for(; ii > 0 && huge_ranges[ii - 1].start > start; ii--)
+      huge_ranges[ii] = huge_ranges[ii - 1];
+    huge_ranges[ii].start = start;
+    huge_ranges[ii].end   = end;
+  }
+  fclose(file);
+}
+
+
+/**************************************************************************************/
+/* tlb_is_huge_page: is va mapped by a 2MB page? */
+
+static Flag tlb_is_huge_page(Addr va) {
+  Addr region = tlb_strip_va(va) >> TLB_HUGE_PAGE_BITS;
+
+  if(num_huge_ranges) {
+    /* binary search for the last range starting at or below the region */
+    Addr region_start = region << TLB_HUGE_PAGE_BITS;
+    int  lo = 0, hi = (int)num_huge_ranges - 1, found = -1;
+    while(lo <= hi) {
+      int mid = (lo + hi) / 2;
+      if(huge_ranges[mid].start <= region_start) {
+        found = mid;
+        lo    = mid + 1;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    /* the whole 2MB region must be inside the range */
+    if(found >= 0 &&
+       region_start + (1ULL << TLB_HUGE_PAGE_BITS) <= huge_ranges[found].end)
+      return TRUE;
+  }
+
+  if(HUGE_PAGE_PCT) {
+    uns64 hash = region * 0x9E3779B97F4A7C15ULL;
+    return (hash >> 32) % 100 < HUGE_PAGE_PCT;
+  }
+  return FALSE;
+}
+
+
+/**************************************************************************************/
+/* tlb_strip_va: virtual address without the proc_id bits */
+
+static inline Addr tlb_strip_va(Addr va) {
+  return va & N_BIT_MASK(NUM_ADDR_NON_SIGN_EXTEND_BITS);
+}
+
+/* tlb_key: TLB lookup key of the page holding va (4KB and 2MB pages never
+   alias) */
+static inline Addr tlb_key(Addr va, Flag huge) {
+  Addr vpn = tlb_strip_va(va) >> (huge ? TLB_HUGE_PAGE_BITS : TLB_PAGE_BITS);
+  return ((vpn << 1) | huge) * TLB_KEY_LINE_SIZE;
+}
+
+/* pwc_key: page walk cache key of the entry at 'level' that maps va */
+static inline Addr pwc_key(Addr va, uns level) {
+  return (tlb_strip_va(va) >> TLB_LEVEL_SHIFT(level)) * TLB_KEY_LINE_SIZE;
+}
+
+/* pte_line_addr: memory line holding the page table entry at 'level' that
+   maps va. Each level has its own 1TB region of the page table area. */
+static inline Addr pte_line_addr(uns8 proc_id, Addr va, uns level) {
+  Addr index = tlb_strip_va(va) >> TLB_LEVEL_SHIFT(level);
+  Addr addr  = PTW_TABLE_BASE + ((Addr)(level - 1) << 40) +
+              index * TLB_PTE_SIZE;
+  return convert_to_cmp_addr(proc_id, addr & ~(Addr)(DCACHE_LINE_SIZE - 1));
+}
+
+
+/**************************************************************************************/
+/* tlb_translate: returns TRUE if the translation of va is in the L1 TLB of
+   'type'. Otherwise the miss is handled (or merged with an outstanding one)
+   and the caller retries with 'retry' set until it succeeds; stats are only
+   collected for the first attempt. */
+
+Flag tlb_translate(uns8 proc_id, Tlb_Type type, Addr va, Flag off_path,
+                   Flag retry) {
+  Tlb_Data*  tlb  = &tlb_data[proc_id];
+  Flag       huge = tlb_is_huge_page(va);
+  Addr       key  = tlb_key(va, huge);
+  Addr       line_addr;
+  Tlb_Entry* entry = (Tlb_Entry*)cache_access(&tlb->tlbs[type], key,
+                                              &line_addr, TRUE);
+  if(entry) {
+    if(!retry) {
+      if(type == TLB_INST)
+        STAT_EVENT(proc_id, ITLB_HIT_ONPATH + off_path);
+      else
+        STAT_EVENT(proc_id, DTLB_HIT_ONPATH + off_path);
+    }
+    return TRUE;
+  }
+
+  if(!retry) {
+    if(type == TLB_INST)
+      STAT_EVENT(proc_id, ITLB_MISS_ONPATH + off_path);
+    else
+      STAT_EVENT(proc_id, DTLB_MISS_ONPATH + off_path);
+  }
+
+  /* merge with an outstanding miss to the same page */
+  Tlb_Miss* free_miss = NULL;
+  for(uns ii = 0; ii < TLB_MSHRS; ii++) {
+    Tlb_Miss* miss = &tlb->misses[ii];
+    if(miss->state == TLB_MISS_INV) {
+      if(!free_miss)
+        free_miss = miss;
+    } else if(tlb_key(miss->va, miss->huge) == key) {
+      if(!retry && !miss->fill[type])
+        STAT_EVENT(proc_id, TLB_MISS_MERGED);
+      miss->fill[type] = TRUE;
+      miss->off_path &= off_path;
+      return FALSE;
+    }
+  }
+
+  if(!free_miss) {
+    STAT_EVENT(proc_id, TLB_MSHR_FULL);
+    return FALSE;
+  }
+
+  memset(free_miss, 0, sizeof(Tlb_Miss));
+  free_miss->state       = TLB_MISS_STLB;
+  free_miss->va          = va;
+  free_miss->huge        = huge;
+  free_miss->fill[type]  = TRUE;
+  free_miss->off_path    = off_path;
+  free_miss->walked      = !cache_access(&tlb->stlb, key, &line_addr, TRUE);
+  free_miss->ready_cycle = cycle_count + STLB_LATENCY;
+  STAT_EVENT(proc_id, free_miss->walked ? STLB_MISS : STLB_HIT);
+  if(huge)
+    STAT_EVENT(proc_id, HUGE_PAGE_TRANSLATION);
+  DEBUG(proc_id, "%s miss  va:%s  huge:%d  stlb_hit:%d  off_path:%d\n",
+        tlb_names[type], hexstr64s(va), huge, !free_miss->walked, off_path);
+  return FALSE;
+}
+
+
+/**************************************************************************************/
+/* tlb_walk_start_level: the first page table level a walk of va has to
+   access, after skipping the levels held by the page walk caches */
+
+static uns tlb_walk_start_level(Tlb_Data* tlb, Addr va, Flag huge) {
+  uns  leaf = huge ? 2 : 1;
+  Addr line_addr;
+  for(uns level = leaf + 1; level <= TLB_PT_LEVELS; level++) {
+    if(tlb->pwc[level].num_lines &&
+       cache_access(&tlb->pwc[level], pwc_key(va, level), &line_addr, TRUE))
+      return level - 1;
+  }
+  return TLB_PT_LEVELS;
+}
+
+
+/**************************************************************************************/
+/* update_tlb: advances the outstanding misses of a core by one cycle */
+
+void update_tlb(uns8 proc_id) {
+  if(!TLB_ENABLE)
+    return;
+  Tlb_Data* tlb = &tlb_data[proc_id];
+
+  for(uns ii = 0; ii < TLB_MSHRS; ii++) {
+    Tlb_Miss* miss = &tlb->misses[ii];
+    if(cycle_count < miss->ready_cycle)
+      continue;
+
+    switch(miss->state) {
+      case TLB_MISS_INV:
+      case TLB_MISS_WAIT_MEM:
+        break;
+
+      case TLB_MISS_STLB:
+        if(!miss->walked) {
+          miss->state = TLB_MISS_DONE;
+          tlb_fill(tlb, miss);
+          break;
+        }
+        miss->state = TLB_MISS_WAIT_PTW;
+        /* fall through */
+
+      case TLB_MISS_WAIT_PTW:
+        if(tlb->active_walks == PTW_WALKERS)
+          break;
+        tlb->active_walks++;
+        miss->walk_start_cycle = cycle_count;
+        miss->level = tlb_walk_start_level(tlb, miss->va, miss->huge);
+        miss->state = TLB_MISS_WALK;
+        STAT_EVENT(proc_id, PTW_WALK_ONPATH + miss->off_path);
+        STAT_EVENT(proc_id, PTW_SKIP_0_LEVELS + TLB_PT_LEVELS - miss->level);
+        /* fall through */
+
+      case TLB_MISS_WALK:
+        miss->pte_line = pte_line_addr(proc_id, miss->va, miss->level);
+        if(new_mem_req(MRT_DFETCH, proc_id, miss->pte_line, DCACHE_LINE_SIZE,
+                       0, NULL, tlb_walk_mem_done, unique_count, NULL)) {
+          STAT_EVENT(proc_id, PTW_MEM_ACCESS);
+          miss->state = TLB_MISS_WAIT_MEM;
+          DEBUG(proc_id, "Walk  va:%s  level:%u  pte_line:%s\n",
+                hexstr64s(miss->va), miss->level, hexstr64s(miss->pte_line));
+        } else {
+          STAT_EVENT(proc_id, PTW_MEM_REQ_FAILED);
+        }
+        break;
+
+      case TLB_MISS_DONE:
+        tlb_fill(tlb, miss);
+        break;
+
+      default:
+        FATAL_ERROR(proc_id, "Bad TLB miss state %d\n", miss->state);
+    }
+  }
+}
+
+
+/**************************************************************************************/
+/* tlb_walk_mem_done: memory request done function of the page table
+   accesses. Walks waiting on the same line all advance a level. */
+
+Flag tlb_walk_mem_done(Mem_Req* req) {
+  uns8      proc_id = req->proc_id;
+  Tlb_Data* tlb     = &tlb_data[proc_id];
+  Counter   core_cycle = freq_cycle_count(FREQ_DOMAIN_CORES[proc_id]);
+  Addr      line_addr;
+
+  for(uns ii = 0; ii < TLB_MSHRS; ii++) {
+    Tlb_Miss* miss = &tlb->misses[ii];
+    if(miss->state != TLB_MISS_WAIT_MEM || miss->pte_line != req->addr)
+      continue;
+    uns leaf = miss->huge ? 2 : 1;
+    if(miss->level > leaf) {
+      if(tlb->pwc[miss->level].num_lines &&
+         !cache_access(&tlb->pwc[miss->level], pwc_key(miss->va, miss->level),
+                       &line_addr, FALSE))
+        cache_insert(&tlb->pwc[miss->level], proc_id,
+                     pwc_key(miss->va, miss->level), &line_addr, &line_addr);
+      miss->level--;
+      miss->state = TLB_MISS_WALK;
+    } else {
+      miss->state = TLB_MISS_DONE;
+    }
+    miss->ready_cycle = core_cycle;
+  }
+  return TRUE;
+}
+
+
+/**************************************************************************************/
+/* tlb_fill: installs a completed translation and frees its miss entry */
+
+static void tlb_fill(Tlb_Data* tlb, Tlb_Miss* miss) {
+  Addr       key = tlb_key(miss->va, miss->huge);
+  Addr       line_addr, repl_line_addr;
+  Tlb_Entry* entry;
+
+  if(miss->walked) {
+    ASSERT(tlb->proc_id, tlb->active_walks > 0);
+    tlb->active_walks--;
+    INC_STAT_EVENT(tlb->proc_id, PTW_WALK_CYCLES,
+                   cycle_count - miss->walk_start_cycle);
+    entry = (Tlb_Entry*)cache_insert(&tlb->stlb, tlb->proc_id, key, &line_addr,
+                                     &repl_line_addr);
+    entry->off_path = miss->off_path;
+  }
+  for(uns type = 0; type < NUM_TLB_TYPES; type++) {
+    if(!miss->fill[type])
+      continue;
+    entry = (Tlb_Entry*)cache_access(&tlb->tlbs[type], key, &line_addr, FALSE);
+    if(!entry)
+      entry = (Tlb_Entry*)cache_insert(&tlb->tlbs[type], tlb->proc_id, key,
+                                       &line_addr, &repl_line_addr);
+    entry->off_path = miss->off_path;
+  }
+  DEBUG(tlb->proc_id, "Fill  va:%s  walked:%d\n", hexstr64s(miss->va),
+        miss->walked);
+  miss->state = TLB_MISS_INV;
+}
+
+
+/**************************************************************************************/
+/* tlb_warmup: functional translation of va used during warmup. The page table
+   lines a walk would touch are passed to warmup_func. */
+
+void tlb_warmup(uns8 proc_id, Tlb_Type type, Addr va,
+                void warmup_func(uns, Addr, Flag)) {
+  if(!TLB_ENABLE)
+    return;
+  Tlb_Data* tlb  = &tlb_data[proc_id];
+  Flag      huge = tlb_is_huge_page(va);
+  Addr      key  = tlb_key(va, huge);
+  Addr      line_addr, repl_line_addr;
+
+  if(cache_access(&tlb->tlbs[type], key, &line_addr, TRUE))
+    return;
+  if(!cache_access(&tlb->stlb, key, &line_addr, TRUE)) {
+    uns leaf = huge ? 2 : 1;
+    for(uns level = tlb_walk_start_level(tlb, va, huge); level >= leaf;
+        level--) {
+      warmup_func(proc_id, pte_line_addr(proc_id, va, level), FALSE);
+      if(level > leaf && tlb->pwc[level].num_lines)
+        cache_insert(&tlb->pwc[level], proc_id, pwc_key(va, level), &line_addr,
+                     &repl_line_addr);
+    }
+    cache_insert(&tlb->stlb, proc_id, key, &line_addr, &repl_line_addr);
+  }
+  cache_insert(&tlb->tlbs[type], proc_id, key, &line_addr, &repl_line_addr);
+}
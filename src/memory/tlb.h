@@ -0,0 +1,102 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : memory/tlb.h
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Address translation timing model: per-core L1 ITLB/DTLB, a
+ *                unified STLB and a radix page table walker with page walk
+ *                caches.
+ ***************************************************************************************/
+
+#ifndef __TLB_H__
+#define __TLB_H__
+
+#include "globals/global_types.h"
+#include "libs/cache_lib.h"
+#include "memory/mem_req.h"
+
+/**************************************************************************************/
+/* Defines */
+
+#define TLB_PT_LEVELS 4 /* x86-64 4-level page table: PML4, PDPT, PD, PT */
+
+/**************************************************************************************/
+/* Types */
+
+typedef enum Tlb_Type_enum {
+  TLB_INST,
+  TLB_DATA,
+  NUM_TLB_TYPES
+} Tlb_Type;
+
+typedef enum Tlb_Miss_State_enum {
+  TLB_MISS_INV,
+  TLB_MISS_STLB,      /* looking up the STLB */
+  TLB_MISS_WAIT_PTW,  /* waiting for a free page table walker */
+  TLB_MISS_WALK,      /* ready to access the page table entry of 'level' */
+  TLB_MISS_WAIT_MEM,  /* waiting for the page table entry of 'level' */
+  TLB_MISS_DONE       /* translation known, fill the TLBs */
+} Tlb_Miss_State;
+
+typedef struct Tlb_Entry_struct {
+  Flag off_path; /* was the entry filled by an off-path access? */
+} Tlb_Entry;
+
+/* an outstanding L1 TLB miss (an STLB lookup or a page walk) */
+typedef struct Tlb_Miss_struct {
+  Tlb_Miss_State state;
+  Addr           va;        /* any address in the page */
+  Flag           huge;      /* 2MB page */
+  Flag           fill[NUM_TLB_TYPES]; /* L1 TLBs waiting for the translation */
+  Flag           walked;    /* missed in the STLB */
+  Flag           off_path;  /* only off-path accesses are waiting */
+  uns            level;     /* page table level being accessed (1 = PT) */
+  Addr           pte_line;  /* line of the page table entry in memory */
+  Counter        ready_cycle;
+  Counter        walk_start_cycle;
+} Tlb_Miss;
+
+typedef struct Tlb_Data_struct {
+  uns8      proc_id;
+  Cache     tlbs[NUM_TLB_TYPES]; /* L1 ITLB and DTLB */
+  Cache     stlb;
+  Cache     pwc[TLB_PT_LEVELS + 1]; /* page walk cache per non-leaf level */
+  Tlb_Miss* misses;                 /* TLB_MSHRS entries */
+  uns       active_walks;
+} Tlb_Data;
+
+/**************************************************************************************/
+/* Prototypes */
+
+void init_tlb(uns8 proc_id);
+void reset_tlb(uns8 proc_id);
+void update_tlb(uns8 proc_id);
+Flag tlb_translate(uns8 proc_id, Tlb_Type type, Addr va, Flag off_path,
+                   Flag retry);
+void tlb_warmup(uns8 proc_id, Tlb_Type type, Addr va,
+                void warmup_func(uns, Addr, Flag));
+Flag tlb_walk_mem_done(Mem_Req* req);
+
+/**************************************************************************************/
+
+#endif /* #ifndef __TLB_H__ */
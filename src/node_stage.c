@@ -37,6 +37,7 @@
 #include "globals/global_vars.h"
 #include "globals/utils.h"
 #include "op_pool.h"
+#include "pc_prof.h"
 
 #include "bp/bp.h"
 #include "exec_ports.h"
@@ -54,6 +55,7 @@
 #include "statistics.h"
 
 #include "bp/tagescl.h"
+#include "cmp_model.h"
 #include "decoupled_frontend.h"
 
 /* Macros */
@@ -68,7 +70,7 @@
 /**************************************************************************************/
 /* Global Variables */
 
-Node_Stage*            node                   = NULL;
+CORE_LOCAL Node_Stage*            node                   = NULL;
 Rob_Stall_Reason       rob_stall_reason       = ROB_STALL_NONE;
 Rob_Block_Issue_Reason rob_block_issue_reason = ROB_BLOCK_ISSUE_NONE;
 
@@ -94,6 +96,8 @@ void collect_node_table_full_stats(Op* op);
 /* set_node_stage:*/
 
 void set_node_stage(Node_Stage* new_node) {
+  if(new_node != node)
+    core_context = NULL; /* only one stage of another core is selected */
   node = new_node;
 }
 
@@ -129,7 +133,7 @@ void reset_node_stage() {
   node->next_op_into_rs = NULL;
 
   node->node_count           = 0;
-  node->ret_op               = 1;
+  node->ret_op               = uop_count[node->proc_id] + 1;
   node->last_scheduled_opnum = 0;
   node->mem_blocked          = FALSE;
   node->mem_block_length     = 0;
@@ -243,6 +247,7 @@ void flush_window() {
         ASSERT(op->proc_id, node->rs[op->rs_id].rs_op_count > 0);
         node->rs[op->rs_id].rs_op_count--;
       }
+      lsq_flush(op);
       free_op(op);
     } else {
       /* Keep op */
@@ -437,6 +442,10 @@ void node_issue(Stage_Data* src_sd) {
     if((op->table_info->bar_type & BAR_ISSUE) && (node->node_count > 0))
       break;
 
+    /* stall if the op's load/store queue is full */
+    if(!lsq_can_dispatch(op))
+      return;
+
     /* remove op from previous stage */
     src_sd->ops[ii] = NULL;
     src_sd->op_count--;
@@ -445,6 +454,7 @@ void node_issue(Stage_Data* src_sd) {
     /* set op fields */
     op->node_id     = node->node_count;
     op->issue_cycle = cycle_count;
+    lsq_dispatch(op);
 
     /* add to node list & update node state*/
     ASSERT(node->proc_id, !op->in_node_list);
@@ -734,6 +744,8 @@ void node_retire() {
     if(op_not_ready_for_retire(op)) {
       // op is not ready to retire
       collect_not_ready_to_retire_stats(op);
+      if(ret_count == 0)
+        PC_PROF_EVENT(node->proc_id, PP_RET_STALL, op->inst_info->addr, 1);
       break;
     }
 
@@ -772,6 +784,9 @@ void node_retire() {
                OP_WAIT_0 + MIN2(op->sched_cycle - real_rdy_cycle, 31));
     STAT_EVENT(op->proc_id, OP_RETIRED);  // Counts all ops retired, not just
                                           // those in primary thread
+    if(op->table_info->mem_type == MEM_LD && op->oracle_info.dcmiss)
+      PC_PROF_EVENT(op->proc_id, PP_LD_MISS, op->inst_info->addr,
+                    op->done_cycle - op->dcache_cycle);
 
     DEBUG(node->proc_id, "Retiring op_num:%s\n", unsstr64(op->op_num));
 
@@ -784,6 +799,7 @@ void node_retire() {
        * the PIN frontend*/
       inst_count[node->proc_id]++;
       STAT_EVENT(op->proc_id, NODE_INST_COUNT);
+      PC_PROF_EVENT(op->proc_id, PP_RETIRED, op->inst_info->addr, 1);
 
       if(op->fetched_instruction) {
         inst_count_fetched[node->proc_id]++;
@@ -838,6 +854,7 @@ void node_retire() {
 
     // free the previous register entries with same architectural destination
     rename_table_commit(op);
+    lsq_retire(op);
 
     if(model->op_retired_hook)
       model->op_retired_hook(op);
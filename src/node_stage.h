@@ -29,6 +29,7 @@
 #ifndef __NODE_STAGE_H__
 #define __NODE_STAGE_H__
 
+#include "globals/global_defs.h"
 #include "exec_stage.h"
 #include "stage_data.h"
 
@@ -76,7 +77,7 @@ typedef struct Node_Stage_struct {
 /**************************************************************************************/
 // External Variables
 
-extern Node_Stage* node;
+extern CORE_LOCAL Node_Stage* node;
 
 
 /**************************************************************************************/
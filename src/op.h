@@ -246,6 +246,11 @@ struct Op_struct {
   uns wake_up_count;   // count of ops to be awakened by this op (wake up list
                        // length)
   Counter wake_cycle;  // used by wake up logic for time wake up signal is sent
+  struct Op_struct* lsq_store;  // youngest older in-flight store overlapping a
+                                // load (LSQ_ENABLE)
+  Counter lsq_store_unique;     // unique_num of lsq_store
+  uns     lsq_penalty;  // cycles the LSQ adds to the load's dcache access
+  Flag tlb_miss;  // has the op missed in the DTLB? (TLB_ENABLE)
   // }}}
 
   struct Mem_Req_struct* req;  // pointer to memory request responsible for
@@ -154,7 +154,7 @@ void free_op(Op* op) {
   if(op->sched_info)
     free(op->sched_info);
 
-  if(op->table_info->mem_type == MEM_ST)
+  if(op->table_info->mem_type == MEM_ST && !LSQ_ENABLE)
     delete_store_hash_entry(op);
 
   if(op->inst_info && op->inst_info->fake_inst) {
@@ -253,6 +253,9 @@ void op_pool_setup_op(uns proc_id, Op* op) {
   op->recovery_scheduled = FALSE;
   op->redirect_scheduled = FALSE;
   op->fetched_from_uop_cache         = FALSE;
+  op->lsq_store                      = NULL;
+  op->lsq_penalty                    = 0;
+  op->tlb_miss                       = FALSE;
 
   for(ii = 0; ii < NUM_DEP_TYPES; ii++)
     op->wake_up_signaled[ii] = FALSE;
@@ -51,6 +51,7 @@
 #include "globals/global_types.h"
 #include "globals/utils.h"
 #include "optimizer2.h"
+#include "ramulator.h"
 #include "statistics.h"
 
 #define DEBUG(proc_id, args...) _DEBUGU(proc_id, DEBUG_OPTIMIZER2, ##args)
@@ -113,7 +114,6 @@ static FILE*   open_fifo(uns pid, const char* mode);
 static void    slave_clean_up(void);
 static void    master_clean_up(void);
 static void    run_master(void);
-static void    decouple_open_files(void);
 
 void init_slave(void) {
   char buf[MAX_STR_LENGTH + 1];
@@ -279,6 +279,7 @@ void opt2_init(uns n, uns n_to_keep, void (*fn)(int)) {
     FATAL_ERROR(0, "Master feedback read stream fopen FAILED. errno: %s\n",
                 strerror(errno));
   fflush(stdout); /* avoid repeated messages */
+  ramulator_stop_threads(); /* threads do not survive fork() */
   if(!fork()) {
     init_slave();
     is_leader = TRUE;
@@ -363,6 +364,7 @@ void receive_msg(FILE* stream, Message_Type type, Message* external_msg,
 void spawn_children() {
   fflush(stdout);    /* prevent duplicate output */
   is_leader = FALSE; /* spawned children should know they are not leaders */
+  ramulator_stop_threads(); /* threads do not survive fork() */
   uns config_num = 0;
   while(config_num < num_configs) {
     if(config_num != my_config_num) { /* don't init myself */
@@ -399,68 +401,6 @@ Flag opt2_is_leader(void) {
   return is_leader;
 }
 
-void decouple_open_files(void) {
-  const uns MAX_FDS = 1024;
-  uns       fds[MAX_FDS];
-  uns       num_fds = 0;
-
-  char fdinfo_path[MAX_STR_LENGTH + 1];
-  uns  len = snprintf(fdinfo_path, MAX_STR_LENGTH, "/proc/%d/fdinfo", getpid());
-  ASSERT(0, len < MAX_STR_LENGTH);
-  DIR* dir = opendir(fdinfo_path);
-
-  while(dir) {
-    struct dirent* entry = readdir(dir);
-    if(entry) {
-      if(entry->d_name[0] != '.') {  // not a "." or ".."
-        ASSERT(0, num_fds < MAX_FDS);
-        fds[num_fds] = atoi(entry->d_name);
-        ++num_fds;
-      }
-    } else {
-      break;
-    }
-  }
-
-  // by closing the directory, we invalidate the FDs opened by opendir/readdir
-  closedir(dir);
-
-  for(int i = 0; i < num_fds; ++i) {
-    if(fcntl(fds[i], F_GETFL, 0) !=
-       -1) {  // valid FD (not related to /proc/pid/fdinfo traversal)
-      int fd = fds[i];
-      if(fd <= 2)
-        continue;  // do not decouple standard input/output/error
-      char fd_path[MAX_STR_LENGTH + 1];
-      uns  len = snprintf(fd_path, MAX_STR_LENGTH, "/proc/%d/fd/%d", getpid(),
-                         fd);
-      ASSERT(0, len < MAX_STR_LENGTH);
-      char path[MAX_STR_LENGTH + 1];
-      uns  path_len = readlink(fd_path, path, MAX_STR_LENGTH);
-      ASSERT(0, path_len < MAX_STR_LENGTH);
-      path[path_len] = 0;  // null terminator
-      int64 offset   = lseek(fd, 0, SEEK_CUR);
-      int   flags    = fcntl(fd, F_GETFL, 0) & ~O_CREAT & ~O_EXCL & ~O_NOCTTY &
-                  ~O_TRUNC;  // clear file creation flags for safety
-      int close_rc = close(fd);
-      ASSERT(0, close_rc == 0);
-      int open_fd = open(path, flags);
-      ASSERT(0, open_fd != -1);
-      if(open_fd != fd) {
-        int new_fd = dup2(open_fd, fd);
-        ASSERT(0, new_fd == fd);
-        int close_rc = close(open_fd);
-        ASSERT(0, close_rc == 0);
-      }
-      int ret_offset = lseek(fd, offset, SEEK_SET);
-      ASSERT(0, ret_offset == offset);
-    } else {
-      ASSERT(0, errno == EBADF);
-      errno = 0;
-    }
-  }
-}
-
 Counter dbl2ctr(double x) {
   Counter result;
   memcpy(&result, &x, sizeof(Counter));
@@ -46,6 +46,7 @@ the program.  This way, an exact duplicate run can be performed.
 #include "globals/global_defs.h"
 #include "globals/global_types.h"
 #include "globals/global_vars.h"
+#include "globals/param_spec.h"
 #include "globals/utils.h"
 
 #include "bp/bp.h"
@@ -78,7 +79,7 @@ the program.  This way, an exact duplicate run can be performed.
 
 const char* help_options[]    = {"-help", "-h", "--help",
                               "--h"}; /* cmd-line help options strings */
-const char* sim_mode_names[]  = {"uop", "full"
+const char* sim_mode_names[]  = {"uop", "full", "sample", "simpoint", "mix"
 #ifdef ENABLE_PT_MEMTRACE
 , "trace_bbv"
 , "trace_bbv_distributed"
@@ -94,8 +95,13 @@ const char* exit_cond_names[] = {"last_done", "first_done"};
 /**************************************************************************************/
 /* need to declare the variables that will be externed the .param.h files */
 
+/* parameters compiled in by a specialized build are declared in the
+   .param.h files and have no variable here (see globals/param_spec.h) */
+#define PARAM_DEFINE_0(variable, type, def, qual) qual type variable = def;
+#define PARAM_DEFINE_1(variable, type, def, qual)
+
 #define DEF_PARAM(name, variable, type, func, def, const) \
-  const type variable = def;
+  PARAM_SPEC_SELECT(PARAM_DEFINE_, variable)(variable, type, def, const)
 #include "param_files.def"
 #undef DEF_PARAM
 
@@ -137,8 +143,12 @@ char* const_options[] = {
   "", "", ""};
 #undef DEF_PARAM
 
+#define PARAM_DUMP_0(variable, def, qual) {#variable, #def, #qual},
+#define PARAM_DUMP_1(variable, def, qual) \
+  {#variable, PARAM_SPEC_STR(PARAM_SPEC_VALUE_##variable), "specialized"},
+
 #define DEF_PARAM(name, variable, type, func, def, const) \
-  {#variable, #def, #const},
+  PARAM_SPEC_SELECT(PARAM_DUMP_, variable)(variable, def, const)
 char* compiled_param_dump_array[][3] = {
 #include "param_files.def"
   {0, 0, 0}};
@@ -151,7 +161,13 @@ typedef struct Param_Record_struct {
   char optarg[MAX_STR_LENGTH + 1];
 } Param_Record;
 
-void dump_params(char** arg_list, Param_Record used_params[], Flag exe_found);
+void dump_params(const char* dir, char** sim_argv, Param_Record used_params[],
+                 Flag exe_found);
+
+/* values given for each parameter (kept for override_params) */
+static Param_Record used_params[NUM_PARAMS];
+/* simulated command of the run */
+static char** sim_argv;
 
 /**************************************************************************************/
 /* Local prototypes */
@@ -470,9 +486,10 @@ void get_uns64_param(const char* name, uns64* variable) {
 /**************************************************************************************/
 /* dump_params: */
 
-void dump_params(char** arg_list, Param_Record used_params[], Flag exe_found) {
+void dump_params(const char* dir, char** sim_argv, Param_Record used_params[],
+                 Flag exe_found) {
   int   ii;
-  FILE* arg_stream_out = file_tag_fopen(NULL, ARG_FILE_OUT, "w");
+  FILE* arg_stream_out = file_tag_fopen(dir, ARG_FILE_OUT, "w");
   if(!arg_stream_out) {
     WARNINGU(
       0, "Couldn't open parameter output file %s.out --- Dumping to stderr.\n",
@@ -485,8 +502,8 @@ void dump_params(char** arg_list, Param_Record used_params[], Flag exe_found) {
               used_params[ii].optarg);
   if(exe_found)
     fprintf(arg_stream_out, "--exe ");
-  for(ii = optind; arg_list[ii]; ii++)
-    fprintf(arg_stream_out, "%s ", arg_list[ii]);
+  for(ii = 0; sim_argv[ii]; ii++)
+    fprintf(arg_stream_out, "%s ", sim_argv[ii]);
 
   fprintf(
     arg_stream_out,
@@ -514,9 +531,24 @@ void dump_params(char** arg_list, Param_Record used_params[], Flag exe_found) {
      the appropriate function when it finds one.  It also returns a pointer to
      the start of the simulated command's argv string.  */
 
+/* a specialized parameter can still be given, but only with the value it was
+   compiled with (so the PARAMS file of the build can be used as PARAMS.in) */
+#define PARAM_SET_0(name, variable, type, func) \
+  get_##func##_param(#name, (type*)&variable);
+#define PARAM_SET_1(name, variable, type, func)                              \
+  {                                                                          \
+    type value;                                                              \
+    get_##func##_param(#name, &value);                                       \
+    if(value != (type)PARAM_SPEC_VALUE_##variable)                           \
+      FATAL_ERROR(0,                                                         \
+                  "Cannot set parameter '%s' to '%s': this build is "        \
+                  "specialized to '%s'.\n",                                  \
+                  #name, optarg, PARAM_SPEC_STR(PARAM_SPEC_VALUE_##variable)); \
+  }
+
 #define DEF_PARAM(name, variable, type, func, def, const)                   \
   case PARAM_ENUM_##name:                                                   \
-    get_##func##_param(#name, (type*)&variable);                            \
+    PARAM_SPEC_SELECT(PARAM_SET_, variable)(name, variable, type, func)     \
     used_params[PARAM_ENUM_##name].used = TRUE;                             \
     strncpy(used_params[PARAM_ENUM_##name].optarg, optarg, MAX_STR_LENGTH); \
     break;
@@ -779,33 +811,18 @@ uns get_param_file_args_and_command_line_args(char*** arg_list_ptr, int argc,
          argc; /*Return the total number of args in the arg_list*/
 }
 
-char** get_params(int argc, char* argv[]) {
-  uns arg_list_count; /*Count of all args and values in the arg_list (like argc
-                         for the command line)*/
-  char** arg_list = NULL; /*Merged list of all args and values from PARAMS.in
-                             and the command line (like argv for the command
-                             line)*/
-  Param_Record used_params[NUM_PARAMS]; /*Keeps track of the values that are
-                                           actually used by the simulator. */
-
-  if(contains_help_options(argc, argv)) {
-    print_help();
-    exit(0);
-  }
-
-  arg_list_count = get_param_file_args_and_command_line_args(&arg_list, argc,
-                                                             argv);
+/**************************************************************************************/
+/* parse_args: sets every parameter given in argv (argv[0] is skipped) */
 
+static void parse_args(int argc, char* argv[]) {
   int temp_index = 0;
   param_idx      = -1;
   opterr         = 0;  // Suppress getopt_long's error message (we have our own)
-  mark_all_params_as_unused(used_params);
-  while(getopt_long(arg_list_count, arg_list, "", long_options, &temp_index) !=
-        -1) {
+  while(getopt_long(argc, argv, "", long_options, &temp_index) != -1) {
     int index = param_idx;
     param_idx = -1;
     if(index == -1) {
-      FATAL_ERROR(0, "Unknown parameter '%s'\n", arg_list[optind - 1]);
+      FATAL_ERROR(0, "Unknown parameter '%s'\n", argv[optind - 1]);
     }
     if(strncmp(const_options[index], "const", MAX_STR_LENGTH) == 0) {
       FATAL_ERROR(0, "Cannot set parameter '%s' compiled as a constant.\n",
@@ -824,7 +841,12 @@ char** get_params(int argc, char* argv[]) {
                     index);
     }
   }
+}
 
+/**************************************************************************************/
+/* set_derived_params: computes the parameters derived from other ones */
+
+static void set_derived_params(void) {
   // Set global size variables.
   NUM_RS   = num_tokens(RS_SIZES, DELIMITERS);
   uns temp = num_tokens(RS_CONNECTIONS, DELIMITERS);
@@ -833,6 +855,26 @@ char** get_params(int argc, char* argv[]) {
           "Number of elements in RS_SIZES(%d) must match number of elements in "
           "RS_CONNECTIONS(%d)",
           NUM_RS, temp);
+}
+
+char** get_params(int argc, char* argv[]) {
+  uns arg_list_count; /*Count of all args and values in the arg_list (like argc
+                         for the command line)*/
+  char** arg_list = NULL; /*Merged list of all args and values from PARAMS.in
+                             and the command line (like argv for the command
+                             line)*/
+
+  if(contains_help_options(argc, argv)) {
+    print_help();
+    exit(0);
+  }
+
+  arg_list_count = get_param_file_args_and_command_line_args(&arg_list, argc,
+                                                             argv);
+
+  mark_all_params_as_unused(used_params);
+  parse_args(arg_list_count, arg_list);
+  set_derived_params();
 
   if((FRONTEND == FE_TRACE
 #ifdef ENABLE_PT_MEMTRACE
@@ -848,8 +890,24 @@ char** get_params(int argc, char* argv[]) {
   ASSERTM(0, arg_list[arg_list_count] == 0x0,
           "3: Reading in parameters overflowed the space allocated for the "
           "args_list\n");
-  dump_params(arg_list, used_params, FALSE);
-  return &arg_list[optind]; /* return pointer to simulated argv */
+  sim_argv = &arg_list[optind];
+  dump_params(NULL, sim_argv, used_params, FALSE);
+  return sim_argv; /* return pointer to simulated argv */
+}
+
+/**************************************************************************************/
+/* override_params: sets the parameters given in argv (same syntax as the
+   command line, argv[0] is skipped) on top of the current values and dumps
+   the resulting parameter file in dump_dir. */
+
+void override_params(int argc, char* argv[], const char* dump_dir) {
+  optind = 0; /* restarts getopt_long */
+  parse_args(argc, argv);
+  if(optind != argc)
+    FATAL_ERROR(0, "Unexpected argument '%s' in parameter overrides\n",
+                argv[optind]);
+  set_derived_params();
+  dump_params(dump_dir, sim_argv, used_params, FALSE);
 }
 
 static void print_help(void) {
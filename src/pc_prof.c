@@ -0,0 +1,373 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : pc_prof.c
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Per-PC / per-line profiler: counts pipeline events and their cycles
+ *                per instruction or cache line address, to find the loads, branches
+ *                and lines that limit performance
+ ***************************************************************************************/
+
+#include "pc_prof.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "globals/assert.h"
+#include "globals/global_defs.h"
+#include "globals/global_vars.h"
+#include "globals/utils.h"
+
+#include "core.param.h"
+
+/**************************************************************************************/
+/* Types */
+
+/* One (address, event) pair. All events of a core share one open-addressing
+   table (linear probing), so an address with several events takes several
+   entries. A slot with a zero count is free. */
+typedef struct Pc_Prof_Entry_struct {
+  Addr  addr;
+  uns32 event;
+  uns32 proc_id;
+  uns64 count; /* number of events */
+  uns64 sum;   /* sum of their values */
+} Pc_Prof_Entry;
+
+typedef struct Pc_Prof_Table_struct {
+  Pc_Prof_Entry* entries;
+  uns64          mask; /* number of slots - 1, a power of 2 */
+  uns64          num;  /* used slots */
+} Pc_Prof_Table;
+
+/* Binary dump (OUTPUT_DIR/FILE_TAG + PC_PROF_BIN_FILE)
+
+   Layout (little endian, everything 8-byte aligned):
+     Pc_Prof_Bin_Header
+     names  : NUL-separated event names, in Pc_Prof_Event order
+     keys   : one uns8 Pc_Prof_Key per event
+     entries: num_entries Pc_Prof_Entry of all cores, unsorted */
+
+#define PC_PROF_BIN_MAGIC "SCARABPP"
+#define PC_PROF_BIN_VERSION 1
+#define PC_PROF_BIN_ALIGN(x) (((x) + 7) & ~((uns64)7))
+
+typedef struct Pc_Prof_Bin_Header_struct {
+  char  magic[8];
+  uns32 version;
+  uns32 num_cores;
+  uns32 num_events;
+  uns32 entry_size;
+  uns64 names_offset;
+  uns64 names_size;
+  uns64 keys_offset;
+  uns64 data_offset;
+  uns64 num_entries;
+} Pc_Prof_Bin_Header;
+
+/**************************************************************************************/
+/* Global Variables */
+
+Flag pc_prof_counting = TRUE;
+
+#define DEF_PC_PROF_EVENT(id, name, key, desc) name,
+static const char* const pc_prof_names[NUM_PC_PROF_EVENTS] = {
+#include "pc_prof_events.def"
+};
+#undef DEF_PC_PROF_EVENT
+
+#define DEF_PC_PROF_EVENT(id, name, key, desc) key,
+static const Pc_Prof_Key pc_prof_keys[NUM_PC_PROF_EVENTS] = {
+#include "pc_prof_events.def"
+};
+#undef DEF_PC_PROF_EVENT
+
+#define DEF_PC_PROF_EVENT(id, name, key, desc) desc,
+static const char* const pc_prof_descs[NUM_PC_PROF_EVENTS] = {
+#include "pc_prof_events.def"
+};
+#undef DEF_PC_PROF_EVENT
+
+static Pc_Prof_Table* tables; /* one per core */
+
+/**************************************************************************************/
+/* Local Prototypes */
+
+static void           alloc_table(Pc_Prof_Table* table, uns64 size);
+static void           grow_table(Pc_Prof_Table* table);
+static void           free_tables(void);
+static Pc_Prof_Entry* find_slot(Pc_Prof_Table* table, uns event, Addr addr);
+static int            entry_cmp(const void* a, const void* b);
+static void           print_report(void);
+static void           write_bin(void);
+
+/**************************************************************************************/
+/* pc_prof_init: */
+
+void pc_prof_init(void) {
+  if(!PC_PROF)
+    return;
+
+  if(tables)  // reallocated for each sweep point
+    free_tables();
+
+  uns64 size = 16;
+  while(size < PC_PROF_ENTRIES)
+    size <<= 1;
+
+  pc_prof_counting = TRUE;
+  tables = (Pc_Prof_Table*)calloc(NUM_CORES, sizeof(Pc_Prof_Table));
+  ASSERT(0, tables);
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++)
+    alloc_table(&tables[proc_id], size);
+}
+
+/**************************************************************************************/
+/* pc_prof_reset: */
+
+void pc_prof_reset(void) {
+  if(!PC_PROF)
+    return;
+
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    Pc_Prof_Table* table = &tables[proc_id];
+    memset(table->entries, 0, (table->mask + 1) * sizeof(Pc_Prof_Entry));
+    table->num = 0;
+  }
+}
+
+/**************************************************************************************/
+/* pc_prof_pause: */
+
+void pc_prof_pause(void) {
+  pc_prof_counting = FALSE;
+}
+
+/**************************************************************************************/
+/* pc_prof_resume: */
+
+void pc_prof_resume(void) {
+  pc_prof_counting = TRUE;
+}
+
+/**************************************************************************************/
+/* pc_prof_add: */
+
+void pc_prof_add(uns proc_id, Pc_Prof_Event event, Addr addr, uns64 value) {
+  ASSERT(proc_id, proc_id < NUM_CORES && event < NUM_PC_PROF_EVENTS);
+  Pc_Prof_Table* table = &tables[proc_id];
+  Pc_Prof_Entry* entry = find_slot(table, event, addr);
+
+  if(!entry->count) {
+    /* keep the table at most half full so that probes stay short */
+    if(2 * (table->num + 1) > table->mask + 1) {
+      grow_table(table);
+      entry = find_slot(table, event, addr);
+    }
+    entry->addr    = addr;
+    entry->event   = event;
+    entry->proc_id = proc_id;
+    table->num++;
+  }
+  entry->count++;
+  entry->sum += value;
+}
+
+/**************************************************************************************/
+/* pc_prof_done: */
+
+void pc_prof_done(void) {
+  if(!PC_PROF || !tables)
+    return;
+
+  print_report();
+  write_bin();
+  free_tables();
+}
+
+/**************************************************************************************/
+/* alloc_table: */
+
+static void alloc_table(Pc_Prof_Table* table, uns64 size) {
+  table->entries = (Pc_Prof_Entry*)calloc(size, sizeof(Pc_Prof_Entry));
+  ASSERTM(0, table->entries, "Could not allocate %llu pc_prof entries\n",
+          size);
+  table->mask = size - 1;
+  table->num  = 0;
+}
+
+/**************************************************************************************/
+/* grow_table: doubles the table and reinserts the used entries */
+
+static void grow_table(Pc_Prof_Table* table) {
+  Pc_Prof_Entry* old      = table->entries;
+  uns64          old_size = table->mask + 1;
+  uns64          num      = table->num;
+
+  alloc_table(table, 2 * old_size);
+  for(uns64 ii = 0; ii < old_size; ii++) {
+    if(old[ii].count)
+      *find_slot(table, old[ii].event, old[ii].addr) = old[ii];
+  }
+  table->num = num;
+  free(old);
+}
+
+/**************************************************************************************/
+/* free_tables: */
+
+static void free_tables(void) {
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++)
+    free(tables[proc_id].entries);
+  free(tables);
+  tables = NULL;
+}
+
+/**************************************************************************************/
+/* find_slot: returns the entry of (event, addr), or the free slot where it
+   goes */
+
+static Pc_Prof_Entry* find_slot(Pc_Prof_Table* table, uns event, Addr addr) {
+  uns64 hash = (addr ^ ((uns64)event << 56)) * 0x9e3779b97f4a7c15ULL;
+  uns64 slot = (hash ^ (hash >> 32)) & table->mask;
+
+  while(TRUE) {
+    Pc_Prof_Entry* entry = &table->entries[slot];
+    if(!entry->count || (entry->addr == addr && entry->event == event))
+      return entry;
+    slot = (slot + 1) & table->mask;
+  }
+}
+
+/**************************************************************************************/
+/* entry_cmp: highest sum first, then highest count, then lowest address */
+
+static int entry_cmp(const void* a, const void* b) {
+  const Pc_Prof_Entry* ea = *(const Pc_Prof_Entry* const*)a;
+  const Pc_Prof_Entry* eb = *(const Pc_Prof_Entry* const*)b;
+  if(ea->sum != eb->sum)
+    return ea->sum < eb->sum ? 1 : -1;
+  if(ea->count != eb->count)
+    return ea->count < eb->count ? 1 : -1;
+  return ea->addr < eb->addr ? -1 : ea->addr > eb->addr;
+}
+
+/**************************************************************************************/
+/* print_report: the PC_PROF_TOP_K entries with the highest sum, per core and
+   event. For PC events, per_ret is the sum per retired instance of the PC. */
+
+static void print_report(void) {
+  FILE* file = file_tag_fopen(OUTPUT_DIR, PC_PROF_FILE, "w");
+  ASSERTM(0, file, "Could not open %s\n", PC_PROF_FILE);
+
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    Pc_Prof_Table*  table  = &tables[proc_id];
+    uns64           size   = table->mask + 1;
+    Pc_Prof_Entry** sorted = (Pc_Prof_Entry**)malloc(
+      MAX2(table->num, 1) * sizeof(Pc_Prof_Entry*));
+    ASSERT(proc_id, sorted);
+
+    for(uns event = 0; event < NUM_PC_PROF_EVENTS; event++) {
+      uns64 num = 0, count = 0, sum = 0;
+      for(uns64 ii = 0; ii < size; ii++) {
+        Pc_Prof_Entry* entry = &table->entries[ii];
+        if(entry->count && entry->event == event) {
+          sorted[num++] = entry;
+          count += entry->count;
+          sum += entry->sum;
+        }
+      }
+      qsort(sorted, num, sizeof(Pc_Prof_Entry*), entry_cmp);
+
+      fprintf(file, "Core %u  %s (%s): %s\n", proc_id, pc_prof_names[event],
+              pc_prof_keys[event] == PC_PROF_KEY_PC ? "pc" : "line",
+              pc_prof_descs[event]);
+      fprintf(file, "  addresses %llu  events %llu  sum %llu\n", num, count,
+              sum);
+      fprintf(file, "  %5s %18s %14s %14s %10s %8s %10s\n", "rank", "addr",
+              "count", "sum", "avg", "%sum", "per_ret");
+      for(uns64 ii = 0; ii < MIN2(num, PC_PROF_TOP_K); ii++) {
+        Pc_Prof_Entry* entry = sorted[ii];
+        char           per_ret[16] = "-";
+        if(pc_prof_keys[event] == PC_PROF_KEY_PC) {
+          Pc_Prof_Entry* retired = find_slot(table, PP_RETIRED, entry->addr);
+          if(retired->count)
+            snprintf(per_ret, sizeof(per_ret), "%.3f",
+                     (double)entry->sum / retired->count);
+        }
+        fprintf(file, "  %5llu 0x%16s %14llu %14llu %10.2f %8.2f %10s\n",
+                ii + 1, hexstr64(entry->addr), entry->count, entry->sum,
+                (double)entry->sum / entry->count,
+                sum ? 100.0 * entry->sum / sum : 0.0, per_ret);
+      }
+      fprintf(file, "\n");
+    }
+    free(sorted);
+  }
+  fclose(file);
+}
+
+/**************************************************************************************/
+/* write_bin: */
+
+static void write_bin(void) {
+  FILE* file = file_tag_fopen(OUTPUT_DIR, PC_PROF_BIN_FILE, "wb");
+  ASSERTM(0, file, "Could not open %s\n", PC_PROF_BIN_FILE);
+
+  Pc_Prof_Bin_Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, PC_PROF_BIN_MAGIC, sizeof(header.magic));
+  header.version    = PC_PROF_BIN_VERSION;
+  header.num_cores  = NUM_CORES;
+  header.num_events = NUM_PC_PROF_EVENTS;
+  header.entry_size = sizeof(Pc_Prof_Entry);
+  for(uns event = 0; event < NUM_PC_PROF_EVENTS; event++)
+    header.names_size += strlen(pc_prof_names[event]) + 1;
+  header.names_offset = sizeof(header);
+  header.keys_offset  = PC_PROF_BIN_ALIGN(header.names_offset +
+                                         header.names_size);
+  header.data_offset  = PC_PROF_BIN_ALIGN(header.keys_offset +
+                                         NUM_PC_PROF_EVENTS);
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++)
+    header.num_entries += tables[proc_id].num;
+
+  static const char pad[8] = {0};
+  fwrite(&header, sizeof(header), 1, file);
+  for(uns event = 0; event < NUM_PC_PROF_EVENTS; event++)
+    fwrite(pc_prof_names[event], 1, strlen(pc_prof_names[event]) + 1, file);
+  fwrite(pad, 1, header.keys_offset - header.names_offset - header.names_size,
+         file);
+  for(uns event = 0; event < NUM_PC_PROF_EVENTS; event++) {
+    uns8 key = pc_prof_keys[event];
+    fwrite(&key, 1, 1, file);
+  }
+  fwrite(pad, 1, header.data_offset - header.keys_offset - NUM_PC_PROF_EVENTS,
+         file);
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    Pc_Prof_Table* table = &tables[proc_id];
+    for(uns64 ii = 0; ii <= table->mask; ii++) {
+      if(table->entries[ii].count)
+        fwrite(&table->entries[ii], sizeof(Pc_Prof_Entry), 1, file);
+    }
+  }
+  fclose(file);
+}
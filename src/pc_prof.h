@@ -0,0 +1,98 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : pc_prof.h
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Per-PC / per-line profiler: counts pipeline events and their cycles
+ *                per instruction or cache line address, to find the loads, branches
+ *                and lines that limit performance
+ ***************************************************************************************/
+
+#ifndef __PC_PROF_H__
+#define __PC_PROF_H__
+
+#include "globals/global_types.h"
+#include "general.param.h"
+
+/**************************************************************************************/
+/* Types */
+
+typedef enum Pc_Prof_Key_enum {
+  PC_PROF_KEY_PC,   /* keyed by instruction address */
+  PC_PROF_KEY_LINE, /* keyed by cache line address */
+} Pc_Prof_Key;
+
+#define DEF_PC_PROF_EVENT(id, name, key, desc) id,
+typedef enum Pc_Prof_Event_enum {
+#include "pc_prof_events.def"
+  NUM_PC_PROF_EVENTS
+} Pc_Prof_Event;
+#undef DEF_PC_PROF_EVENT
+
+/**************************************************************************************/
+/* Global Variables */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+extern Flag pc_prof_counting;
+#ifdef __cplusplus
+}
+#endif
+
+/**************************************************************************************/
+/* Prototypes */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Allocate the per-core tables */
+void pc_prof_init(void);
+
+/* Drop the events counted so far (e.g. during warmup) */
+void pc_prof_reset(void);
+
+/* Stop and restart counting around warmup windows of sampled runs, so the
+   measured windows accumulate */
+void pc_prof_pause(void);
+void pc_prof_resume(void);
+
+/* Count one event of addr that cost value (usually cycles) */
+void pc_prof_add(uns proc_id, Pc_Prof_Event event, Addr addr, uns64 value);
+
+/* Write the top-K report and the binary dump and clean up */
+void pc_prof_done(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Counts an event when PC_PROF is on and not paused */
+#define PC_PROF_EVENT(proc_id, event, addr, value)      \
+  do {                                                  \
+    if(PC_PROF && pc_prof_counting)                     \
+      pc_prof_add((proc_id), (event), (addr), (value)); \
+  } while(0)
+
+#endif  // __PC_PROF_H__
@@ -59,6 +59,9 @@ struct InstInfo {
   bool last_inst_from_trace;
   // used by MEMTRACE frontend to distinguish fetched/non-fetched inst
   bool fetched_instruction;
+  // used by MEMTRACE frontend to find roi and stat dump markers without
+  // querying XED (set for every 'xchg' of a register with itself)
+  bool scarab_marker;
 };
 
 #define XED_OP_NAME(ins, op) \
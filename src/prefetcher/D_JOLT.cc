@@ -466,7 +466,7 @@ class WindowBasedStreamPrefetcher {
             for (size_t j = 0; j < Degree; ++j) {
                 const uint64_t pf_addr = (stream.start_line_address + Distance) << LOG2(ICACHE_LINE_SIZE);
 
-                new_mem_req(MRT_IPRF, djolt_proc_id, pf_addr, ICACHE_LINE_SIZE, 0, NULL, instr_fill_line, unique_count, 0);
+                pref_plugin_prefetch_line(djolt_proc_id, PREF_PLUGIN_L1I, pf_addr);
                 INC_STAT_EVENT(0, DJOLT_PREFETCH_ENTRY, 1);
                 ++stream.start_line_address;
             }
@@ -480,7 +480,7 @@ class WindowBasedStreamPrefetcher {
         // i == 0 is not needed since it is the same line as the demand access.
         for (size_t i = 1; i < Distance; ++i) {
             const uint64_t pf_addr = (line_address + i) << LOG2(ICACHE_LINE_SIZE);
-            new_mem_req(MRT_IPRF, djolt_proc_id, pf_addr, ICACHE_LINE_SIZE, 0, NULL, instr_fill_line, unique_count, 0);
+            pref_plugin_prefetch_line(djolt_proc_id, PREF_PLUGIN_L1I, pf_addr);
             INC_STAT_EVENT(0, DJOLT_PREFETCH_INITIAL, 1);
         }
     }
@@ -537,6 +537,7 @@ class D_JOLT_PREFETCHER {
 
 public:
     D_JOLT_PREFETCHER(uns proc_id);
+    uns get_proc_id() const { return proc_id; }
 
     template<class Table>
     void prefetch_with_sig(const Table& table, uint32_t sig);
@@ -549,8 +550,6 @@ public:
     void cache_fill(uint64_t v_addr, uint64_t evicted_v_addr);
 };
 
-std::vector<D_JOLT_PREFETCHER *> per_core_d_jolt_prefetcher;
-
 D_JOLT_PREFETCHER::D_JOLT_PREFETCHER(uns proc_id) : proc_id(proc_id) {
     std::cout << "L1I D-JOLT instruction prefetcher has been constructed!" << std::endl;
 }
@@ -561,7 +560,7 @@ void D_JOLT_PREFETCHER::prefetch_with_sig(const Table& table, uint32_t sig) {
         for (const auto& v : table[sig].getValidEntries()) {
             for (const auto& address : v.getAddresses()) {
                 const uint64_t pf_addr = upper_bit_table.decompress(address);
-                new_mem_req(MRT_IPRF, proc_id, pf_addr, ICACHE_LINE_SIZE, 0, NULL, instr_fill_line, unique_count, 0);
+                pref_plugin_prefetch_line(proc_id, PREF_PLUGIN_L1I, pf_addr);
                 INC_STAT_EVENT(0, DJOLT_PREFETCH_SIG, 1);
             }
         }
@@ -647,34 +646,43 @@ void D_JOLT_PREFETCHER::cache_fill(uint64_t v_addr, uint64_t evicted_v_addr)
 }
 
 
-void alloc_mem_djolt(uns numCores) {
-  per_core_d_jolt_prefetcher.resize(numCores);
+// Plugin interface: the instance of a core is its D_JOLT_PREFETCHER
+static D_JOLT_PREFETCHER* djolt_select(void* pf) {
+  D_JOLT_PREFETCHER* djolt = (D_JOLT_PREFETCHER*)pf;
+  djolt_proc_id = djolt->get_proc_id();
+  return djolt;
 }
 
-void init_djolt(uns proc_id) {
-  if (!DJOLT_ENABLE)
-    return;
-  per_core_d_jolt_prefetcher[proc_id] = new D_JOLT_PREFETCHER(proc_id);
+static void* djolt_init(uns proc_id) {
+  djolt_proc_id = proc_id;
+  return new D_JOLT_PREFETCHER(proc_id);
 }
 
-void set_djolt(uns proc_id) {
-  djolt_proc_id = proc_id;
+static void djolt_operate(void* pf, Addr addr, Addr ip, Flag cache_hit, Flag prefetch_hit, Flag off_path) {
+  djolt_select(pf)->cache_operate(addr, cache_hit, prefetch_hit);
 }
 
-void update_djolt(uns proc_id, Addr fetch_addr, uint8_t branch_type, uint64_t branch_target) {
-  if (!DJOLT_ENABLE)
-    return;
-  per_core_d_jolt_prefetcher[proc_id]->branch_operate(fetch_addr, branch_type, branch_target);
+static void djolt_cache_fill(void* pf, Addr addr, Addr evicted_addr) {
+  djolt_select(pf)->cache_fill(addr, evicted_addr);
 }
 
-void djolt_prefetch(uns proc_id, uint64_t v_addr, uint8_t cache_hit, uint8_t prefetch_hit) {
-  per_core_d_jolt_prefetcher[proc_id]->cache_operate(v_addr, cache_hit, prefetch_hit);
+static void djolt_cycle_operate(void* pf) {
+  djolt_select(pf)->cycle_operate();
 }
 
-void djolt_cycle_operate(uns proc_id) {
-  per_core_d_jolt_prefetcher[proc_id]->cycle_operate();
+static void djolt_branch_operate(void* pf, Addr ip, uns8 branch_type, Addr branch_target) {
+  djolt_select(pf)->branch_operate(ip, branch_type, branch_target);
 }
 
-void print_djolt_stats(uns proc_id) {
-  per_core_d_jolt_prefetcher[proc_id]->final_stats();
+static void djolt_final_stats(void* pf) {
+  djolt_select(pf)->final_stats();
+}
+
+static const Pref_Plugin_Ops djolt_ops = {
+  PREF_PLUGIN_API_VERSION, "djolt", PREF_PLUGIN_L1I,
+  djolt_init, djolt_operate, djolt_cache_fill, djolt_cycle_operate, djolt_branch_operate, djolt_final_stats,
+};
+
+const Pref_Plugin_Ops* djolt_pref_plugin(void) {
+  return &djolt_ops;
 }
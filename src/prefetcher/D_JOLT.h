@@ -7,16 +7,10 @@ extern "C" {
 #endif
 
   #include "icache_stage.h"
+  #include "prefetcher/pref_plugin.h"
 
-  // Interface
-  void alloc_mem_djolt(uns numCores);
-  void init_djolt(uns proc_id);
-  void djolt_prefetch(uns proc_id, uint64_t v_addr, uint8_t cache_hit, uint8_t prefetch_hit);
-  void set_djolt(uns proc_id);
-  void update_djolt(uns proc_id, Addr fetch_addr, uint8_t branch_type, uint64_t branch_target);
-  void djolt_prefetch(uns proc_id, uint64_t v_addr, uint8_t cache_hit, uint8_t prefetch_hit);
-  void djolt_cycle_operate(uns proc_id);
-  void print_djolt_stats(uns proc_id);
+  // Interface: ops table of the built-in plugin (see prefetcher/pref_plugin.h)
+  const Pref_Plugin_Ops* djolt_pref_plugin(void);
 
 #ifdef __cplusplus
 }
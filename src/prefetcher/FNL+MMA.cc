@@ -267,29 +267,25 @@ public:
 
 PredictMiss AHEAD, AHEADphist;
 
-#define   PrefCodeBlock(X) new_mem_req(MRT_IPRF, fnlmma_proc_id, X << LOG2(ICACHE_LINE_SIZE), ICACHE_LINE_SIZE, 0, NULL, instr_fill_line, unique_count, 0)
+#define   PrefCodeBlock(X) pref_plugin_prefetch_line(fnlmma_proc_id, PREF_PLUGIN_L1I, X << LOG2(ICACHE_LINE_SIZE))
 // prefetch  works on  blocks
 
 /////////////////////////////////
-void alloc_mem_fnlmma(uns numCores) {
-}
+// Plugin interface. The FNL+MMA tables are shared by all cores, an instance
+// only records its core.
+struct Fnlmma_Core {
+  uns proc_id;
+};
 
-void init_fnlmma(uns proc_id) {
+static void* fnlmma_init(uns proc_id) {
   AHEAD.init (DISTAHEAD);
   AHEADphist.init (DISTAHEAD);
-}
-
-void set_fnlmma(uns _proc_id) {
-  fnlmma_proc_id = _proc_id;
-}
-
-void update_fnlmma() {
-  if (!FNLMMA_ENABLE)
-    return;
+  return new Fnlmma_Core{proc_id};
 }
 
 ////////////////////
-void fnlmma_prefetch(uns proc_id, uint64_t v_addr, uint8_t cache_hit, uint8_t prefetch_hit) {
+static void fnlmma_operate(void* pf, Addr v_addr, Addr ip, Flag cache_hit, Flag prefetch_hit, Flag off_path) {
+  fnlmma_proc_id = ((Fnlmma_Core*)pf)->proc_id;
   //cout << "access v_addr: 0x" << hex << v_addr << dec << endl;
   uint64_t Block = v_addr >> LOG2(ICACHE_LINE_SIZE);
   int index = Block & (FNL_NBENTRIES - 1);
@@ -484,7 +480,7 @@ void fnlmma_prefetch(uns proc_id, uint64_t v_addr, uint8_t cache_hit, uint8_t pr
     }
 }
 
-void print_fnlmma_stats(uns proc_id) {
+static void fnlmma_final_stats(void* pf) {
   printf ("I-Shadow cache %d bytes\n", (SIZESHADOWICACHE * (15 + 2)) / 8);
   printf ("Touched + WorthPF tables %d bytes \n", (FNL_NBENTRIES * 3) / 8);
   printf ("MMA filter %d bytes \n", (MMA_FILT_SIZE * 58) / 8);
@@ -494,3 +490,12 @@ void print_fnlmma_stats(uns proc_id) {
 	  ((SIZESHADOWICACHE * (15 + 2)) / 8) + ((FNL_NBENTRIES * 3) / 8) +
 	  ((MMA_FILT_SIZE * 58) / 8) + ((SIZEFILTERFNL * (15 + 2) / 8)));
 }
+
+static const Pref_Plugin_Ops fnlmma_ops = {
+  PREF_PLUGIN_API_VERSION, "fnlmma", PREF_PLUGIN_L1I,
+  fnlmma_init, fnlmma_operate, NULL /* cache_fill */, NULL /* cycle_operate */, NULL /* branch_operate */, fnlmma_final_stats,
+};
+
+const Pref_Plugin_Ops* fnlmma_pref_plugin(void) {
+  return &fnlmma_ops;
+}
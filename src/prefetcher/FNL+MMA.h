@@ -7,15 +7,10 @@ extern "C" {
 #endif
 
   #include "icache_stage.h"
+  #include "prefetcher/pref_plugin.h"
 
-  // Interface
-  void alloc_mem_fnlmma(uns numCores);
-  void init_fnlmma(uns proc_id);
-  void fnlmma_prefetch(uns proc_id, uint64_t v_addr, uint8_t cache_hit, uint8_t prefetch_hit);
-  void set_fnlmma(uns proc_id);
-  void update_fnlmma(uns proc_id, Addr fetch_addr, uint8_t branch_type, uint64_t branch_target);
-  void fnlmma_prefetch(uns proc_id, uint64_t v_addr, uint8_t cache_hit, uint8_t prefetch_hit);
-  void print_fnlmma_stats(uns proc_id);
+  // Interface: ops table of the built-in plugin (see prefetcher/pref_plugin.h)
+  const Pref_Plugin_Ops* fnlmma_pref_plugin(void);
 
 #ifdef __cplusplus
 }
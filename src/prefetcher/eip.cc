@@ -72,9 +72,17 @@ uint32_t L1I_TIMING_MSHR_SIZE = 0;
 uint32_t L1I_SET = 0;
 uint32_t L1I_WAY = 0;
 
-uint64_t l1i_last_basic_block;
-uint32_t l1i_consecutive_count;
-uint32_t l1i_basic_block_merge_diff;
+// Per-core basic block tracking, handed back by the plugin framework as the
+// prefetcher instance of each core
+struct Eip_Core {
+  uns      proc_id;
+  uint64_t last_basic_block;
+  uint32_t consecutive_count;
+  uint32_t basic_block_merge_diff;
+};
+
+std::vector<Eip_Core> eip_cores;
+Eip_Core*             eip_core;  // instance of eip_proc_id
 
 bool debug = 0;
 
@@ -866,10 +874,7 @@ uint32_t L1I_TAG_MASK;
   }
 
   // INTERFACE
-void alloc_mem_eip(uns numCores) {
-  if (!EIP_ENABLE)
-    return;
-
+static void eip_alloc(uns numCores) {
   L1I_ENTANGLED_TABLE_SETS = (1 << L1I_ENTANGLED_TABLE_INDEX_BITS);
   L1I_TAG_BITS = (19 - L1I_ENTANGLED_TABLE_INDEX_BITS);
   L1I_TAG_MASK = (((uint64_t)1 << L1I_TAG_BITS) - 1);
@@ -908,27 +913,38 @@ void alloc_mem_eip(uns numCores) {
   l1i_entangled_fifo.resize(numCores);
   for (auto it = l1i_entangled_fifo.begin(); it != l1i_entangled_fifo.end(); ++it)
     *it = (uint32_t*)malloc(sizeof(uint32_t) * L1I_ENTANGLED_TABLE_SETS);
+  eip_cores.resize(numCores);
 }
 
-  void init_eip(uns proc_id) {
-    if (!EIP_ENABLE)
-      return;
+// eip_select: makes the instance pf the one the table helpers work on
+static uns eip_select(void* pf) {
+  eip_core    = (Eip_Core*)pf;
+  eip_proc_id = eip_core->proc_id;
+  return eip_proc_id;
+}
 
+  static void* eip_init(uns proc_id) {
     ASSERT(proc_id, WP_COLLECT_STATS);
 
-    eip_proc_id = proc_id;
+    if (eip_cores.empty())
+      eip_alloc(NUM_CORES);
+    eip_cores[proc_id].proc_id = proc_id;
+    eip_select(&eip_cores[proc_id]);
     l1i_init_stats_table();
-    l1i_last_basic_block = 0;
-    l1i_consecutive_count = 0;
-    l1i_basic_block_merge_diff = 0;
+    eip_core->last_basic_block = 0;
+    eip_core->consecutive_count = 0;
+    eip_core->basic_block_merge_diff = 0;
 
     l1i_init_hist_table();
     l1i_init_timing_tables();
     l1i_init_entangled_table();
+    return eip_core;
   }
 
-  void eip_prefetch(uns proc_id, uint64_t v_addr, uint8_t cache_hit, uint8_t prefetch_hit, Flag off_path)
+  static void eip_operate(void* pf, Addr addr, Addr ip, Flag cache_hit, Flag prefetch_hit, Flag off_path)
   {
+    uns proc_id = eip_select(pf);
+    uint64_t v_addr = addr;
     uint64_t line_addr = v_addr >> LOG2(ICACHE_LINE_SIZE);
     DEBUG(proc_id, "eip_prefetch 0x%lx, icache_line_addr 0x%lx line_addr 0x%lx, cache hit %d, prefetch_hit %d, l1i_find_timing_cache_entry %lu\n", v_addr, v_addr & ~0x3F, line_addr, cache_hit, prefetch_hit, l1i_find_timing_cache_entry(line_addr));
 
@@ -950,10 +966,10 @@ void alloc_mem_eip(uns numCores) {
 
     bool consecutive = false;
 
-    if (l1i_last_basic_block + l1i_consecutive_count == line_addr) { // Same
+    if (eip_core->last_basic_block + eip_core->consecutive_count == line_addr) { // Same
       return;
-    } else if (l1i_last_basic_block + l1i_consecutive_count + 1 == line_addr) { // Consecutive
-      l1i_consecutive_count++;
+    } else if (eip_core->last_basic_block + eip_core->consecutive_count + 1 == line_addr) { // Consecutive
+      eip_core->consecutive_count++;
       consecutive = true;
     }
     if (!FDIP_ENABLE)
@@ -1010,32 +1026,32 @@ void alloc_mem_eip(uns numCores) {
     if (num_entangled) l1i_stats_entangled[num_entangled]++; 
 
     if (!consecutive) { // New basic block found
-      uint32_t max_bb_size = l1i_get_bbsize_entangled_table(l1i_last_basic_block);
+      uint32_t max_bb_size = l1i_get_bbsize_entangled_table(eip_core->last_basic_block);
 
       // Check for merging bb opportunities
-      if (l1i_consecutive_count) { // single blocks no need to merge and are not inserted in the entangled table
-        if (l1i_basic_block_merge_diff > 0) {
-          l1i_add_bbsize_table(l1i_last_basic_block - l1i_basic_block_merge_diff, l1i_consecutive_count + l1i_basic_block_merge_diff);
-          l1i_add_bb_size_hist_table(l1i_last_basic_block - l1i_basic_block_merge_diff, l1i_consecutive_count + l1i_basic_block_merge_diff);
+      if (eip_core->consecutive_count) { // single blocks no need to merge and are not inserted in the entangled table
+        if (eip_core->basic_block_merge_diff > 0) {
+          l1i_add_bbsize_table(eip_core->last_basic_block - eip_core->basic_block_merge_diff, eip_core->consecutive_count + eip_core->basic_block_merge_diff);
+          l1i_add_bb_size_hist_table(eip_core->last_basic_block - eip_core->basic_block_merge_diff, eip_core->consecutive_count + eip_core->basic_block_merge_diff);
         } else {
-          l1i_add_bbsize_table(l1i_last_basic_block, std::max(max_bb_size, l1i_consecutive_count));
-          l1i_add_bb_size_hist_table(l1i_last_basic_block, std::max(max_bb_size, l1i_consecutive_count));
+          l1i_add_bbsize_table(eip_core->last_basic_block, std::max(max_bb_size, eip_core->consecutive_count));
+          l1i_add_bb_size_hist_table(eip_core->last_basic_block, std::max(max_bb_size, eip_core->consecutive_count));
         }
       }
     }
 
     if (!consecutive) { // New basic block found
-      l1i_consecutive_count = 0;
-      l1i_last_basic_block = line_addr;
+      eip_core->consecutive_count = 0;
+      eip_core->last_basic_block = line_addr;
     }  
 
     if (!consecutive) {
-      l1i_basic_block_merge_diff = l1i_find_bb_merge_hist_table(l1i_last_basic_block);
+      eip_core->basic_block_merge_diff = l1i_find_bb_merge_hist_table(eip_core->last_basic_block);
     }
 
     // Add the request in the history buffer
     uint32_t pos_hist = L1I_HIST_TABLE_ENTRIES; 
-    if (!consecutive && l1i_basic_block_merge_diff == 0) {
+    if (!consecutive && eip_core->basic_block_merge_diff == 0) {
       if ((l1i_find_hist_entry(line_addr) == L1I_HIST_TABLE_ENTRIES)) {
         pos_hist = l1i_add_hist_table(line_addr);
       } else {
@@ -1061,18 +1077,11 @@ void alloc_mem_eip(uns numCores) {
 
   }
 
-void set_eip(uns _proc_id) {
-  eip_proc_id = _proc_id;
-}
-
-  void update_eip() {
-    if (!EIP_ENABLE)
-      return;
-  }
-
-  void eip_cache_fill(uns proc_id, uint64_t v_addr, uint64_t evicted_v_addr)
+  static void eip_cache_fill(void* pf, Addr addr, Addr evicted_addr)
   {
-    eip_proc_id = proc_id;
+    uns proc_id = eip_select(pf);
+    uint64_t v_addr = addr;
+    uint64_t evicted_v_addr = evicted_addr;
     uint64_t line_addr = (v_addr >> LOG2(ICACHE_LINE_SIZE));
     uint64_t evicted_line_addr = (evicted_v_addr >> LOG2(ICACHE_LINE_SIZE));
     DEBUG(proc_id, "eip_cache_fill 0x%lx, icache_line_addr 0x%lx line_addr 0x%lx, evicted_v_addr 0x%lx\n", v_addr, v_addr & ~0x3F, line_addr, evicted_v_addr);
@@ -1118,7 +1127,17 @@ void set_eip(uns _proc_id) {
     }
   }
 
-  void print_eip_stats(uns proc_id)
+  static void eip_final_stats(void* pf)
   {
+    eip_select(pf);
     l1i_print_stats_table();
   }
+
+static const Pref_Plugin_Ops eip_ops = {
+  PREF_PLUGIN_API_VERSION, "eip", PREF_PLUGIN_L1I,
+  eip_init, eip_operate, eip_cache_fill, NULL /* cycle_operate */, NULL /* branch_operate */, eip_final_stats,
+};
+
+const Pref_Plugin_Ops* eip_pref_plugin(void) {
+  return &eip_ops;
+}
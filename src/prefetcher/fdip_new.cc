@@ -20,10 +20,10 @@ extern "C" {
 #include <tuple>
 #define DEBUG(proc_id, args...) _DEBUG(proc_id, DEBUG_FDIP, ##args)
 
-decoupled_fe_iter* iter;
+CORE_LOCAL decoupled_fe_iter* iter;
 extern const int MAX_FTQ_ENTRY_CYC = 2;
-int fdip_proc_id;
-Icache_Stage *ic_ref;
+CORE_LOCAL int fdip_proc_id;
+CORE_LOCAL Icache_Stage *ic_ref;
 std::vector<Op*> per_core_cur_op;
 std::vector<decoupled_fe_iter*> per_core_ftq_iter;
 std::vector<Addr> per_core_last_line_addr;
@@ -58,7 +58,7 @@
 /* Global Variables */
 
 extern Memory*       mem;
-extern Dcache_Stage* dc;
+extern CORE_LOCAL Dcache_Stage* dc;
 static Cache*        l1_cache;
 
 /***************************************************************************************/
@@ -30,13 +30,14 @@
 #define __L2L1PREF_PARAM_H__
 
 #include "globals/global_types.h"
+#include "globals/param_spec.h"
 
 
 /**************************************************************************************/
 /* extern all of the variables defined in l2l1pref.param.def */
 
 #define DEF_PARAM(name, variable, type, func, def, const) \
-  extern const type variable;
+  PARAM_EXTERN(variable, type, const)
 #include "l2l1pref.param.def"
 #undef DEF_PARAM
 
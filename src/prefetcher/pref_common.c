@@ -78,7 +78,7 @@ static int pref_table_size;
 /* Global Variables */
 
 extern Memory*       mem;
-extern Dcache_Stage* dc;
+extern CORE_LOCAL Dcache_Stage* dc;
 
 HWP_Common pref;
 
@@ -30,12 +30,13 @@
 #define __PREF_GHB_PARAM_H__
 
 #include "globals/global_types.h"
+#include "globals/param_spec.h"
 
 /**************************************************************************************/
 /* extern all of the variables defined in core.param.def */
 
 #define DEF_PARAM(name, variable, type, func, def, const) \
-  extern const type variable;
+  PARAM_EXTERN(variable, type, const)
 #include "pref_ghb.param.def"
 #undef DEF_PARAM
 
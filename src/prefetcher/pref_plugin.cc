@@ -0,0 +1,278 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : prefetcher/pref_plugin.cc
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Prefetcher plugin framework: plugin registration and
+ *                loading, per-core instances and the batched prefetch queue.
+ *
+ * Prefetches requested by the plugins of a core wait in a per-core queue
+ * (PREF_PLUGIN_QUEUE_SIZE entries, requests for a line already queued are
+ * merged) and up to PREF_PLUGIN_ISSUE_WIDTH of them are sent to the memory
+ * system by update_pref_plugin() every cycle. A request the memory system
+ * rejects stays at the head of the queue and is retried the next cycle.
+ ***************************************************************************************/
+
+#include <dlfcn.h>
+#include <string>
+#include <vector>
+
+#include "debug/debug_macros.h"
+#include "debug/debug_print.h"
+#include "globals/assert.h"
+#include "globals/global_defs.h"
+#include "globals/global_types.h"
+#include "globals/global_vars.h"
+#include "globals/utils.h"
+
+#include "prefetcher/D_JOLT.h"
+#include "prefetcher/FNL+MMA.h"
+#include "prefetcher/eip.h"
+#include "prefetcher/pref_plugin.h"
+#include "statistics.h"
+
+extern "C" {
+#include "dcache_stage.h"
+#include "debug/debug.param.h"
+#include "icache_stage.h"
+#include "memory/memory.h"
+#include "memory/memory.param.h"
+#include "prefetcher/pref.param.h"
+}
+
+/**************************************************************************************/
+/* Macros */
+
+#define DEBUG(proc_id, args...) _DEBUG(proc_id, DEBUG_PREF_PLUGIN, ##args)
+
+/**************************************************************************************/
+/* Types */
+
+struct Pref_Plugin_Req {
+  Addr              line_addr;
+  Pref_Plugin_Cache cache;
+};
+
+struct Pref_Plugin_Core {
+  std::vector<void*>           instances;  // instance of each plugin
+  std::vector<Pref_Plugin_Req> queue;      // circular
+  uns                          head;
+  uns                          count;
+};
+
+/**************************************************************************************/
+/* Global Variables */
+
+static std::vector<const Pref_Plugin_Ops*> plugins;
+static std::vector<Pref_Plugin_Core>       plugin_cores;
+
+/**************************************************************************************/
+/* pref_plugin_register: */
+
+static void pref_plugin_register(const Pref_Plugin_Ops* ops, const char* from) {
+  ASSERTM(0, ops, "Prefetcher plugin %s has no ops table\n", from);
+  ASSERTM(0, ops->api_version == PREF_PLUGIN_API_VERSION,
+          "Prefetcher plugin %s has API version %u, expected %u\n", from,
+          ops->api_version, PREF_PLUGIN_API_VERSION);
+  ASSERTM(0, ops->init, "Prefetcher plugin %s has no init function\n", from);
+  ASSERT(0, ops->cache < NUM_PREF_PLUGIN_CACHES);
+  DEBUG(0, "Registered prefetcher plugin %s (%s)\n", ops->name, from);
+  plugins.push_back(ops);
+}
+
+/**************************************************************************************/
+/* pref_plugin_load: loads the shared objects of the comma separated list. The
+   libraries stay loaded until the simulator exits. */
+
+static void pref_plugin_load(const char* list) {
+  std::string paths(list);
+  size_t      start = 0;
+  while(start <= paths.size()) {
+    size_t end = paths.find(',', start);
+    if(end == std::string::npos)
+      end = paths.size();
+    std::string path = paths.substr(start, end - start);
+    start            = end + 1;
+    if(path.empty())
+      continue;
+
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if(!handle)
+      FATAL_ERROR(0, "Cannot load prefetcher plugin %s: %s\n", path.c_str(),
+                  dlerror());
+    Pref_Plugin_Entry_Func entry = (Pref_Plugin_Entry_Func)dlsym(
+      handle, PREF_PLUGIN_ENTRY);
+    if(!entry)
+      FATAL_ERROR(0, "Prefetcher plugin %s does not export %s\n", path.c_str(),
+                  PREF_PLUGIN_ENTRY);
+    pref_plugin_register(entry(), path.c_str());
+  }
+}
+
+/**************************************************************************************/
+/* alloc_mem_pref_plugin: */
+
+void alloc_mem_pref_plugin(uns num_cores) {
+  if(EIP_ENABLE)
+    pref_plugin_register(eip_pref_plugin(), "built-in");
+  if(DJOLT_ENABLE)
+    pref_plugin_register(djolt_pref_plugin(), "built-in");
+  if(FNLMMA_ENABLE)
+    pref_plugin_register(fnlmma_pref_plugin(), "built-in");
+  if(PREF_PLUGINS)
+    pref_plugin_load(PREF_PLUGINS);
+
+  ASSERT(0, PREF_PLUGIN_QUEUE_SIZE > 0);
+  plugin_cores.resize(num_cores);
+  for(auto& core : plugin_cores)
+    core.queue.resize(PREF_PLUGIN_QUEUE_SIZE);
+}
+
+/**************************************************************************************/
+/* init_pref_plugin: */
+
+void init_pref_plugin(uns proc_id) {
+  Pref_Plugin_Core& core = plugin_cores[proc_id];
+  core.instances.clear();
+  for(const Pref_Plugin_Ops* ops : plugins)
+    core.instances.push_back(ops->init(proc_id));
+  core.head  = 0;
+  core.count = 0;
+}
+
+/**************************************************************************************/
+/* update_pref_plugin: cycle_operate of every plugin, then issues queued
+   prefetches */
+
+void update_pref_plugin(uns proc_id) {
+  Pref_Plugin_Core& core = plugin_cores[proc_id];
+
+  for(uns ii = 0; ii < plugins.size(); ii++) {
+    if(plugins[ii]->cycle_operate)
+      plugins[ii]->cycle_operate(core.instances[ii]);
+  }
+
+  for(uns ii = 0; ii < PREF_PLUGIN_ISSUE_WIDTH && core.count; ii++) {
+    Pref_Plugin_Req* req = &core.queue[core.head];
+    Flag             success;
+
+    if(req->cache == PREF_PLUGIN_L1I)
+      success = new_mem_req(MRT_IPRF, proc_id, req->line_addr,
+                            ICACHE_LINE_SIZE, 0, NULL, instr_fill_line,
+                            unique_count, 0);
+    else
+      success = new_mem_req(MRT_DPRF, proc_id, req->line_addr,
+                            DCACHE_LINE_SIZE, 0, NULL, dcache_fill_line,
+                            unique_count, 0);
+    if(!success) {
+      STAT_EVENT(proc_id, PREF_PLUGIN_MEM_REQ_FAILED);
+      break;
+    }
+
+    DEBUG(proc_id, "Issued plugin prefetch of line 0x%s into %s\n",
+          hexstr64s(req->line_addr),
+          req->cache == PREF_PLUGIN_L1I ? "L1I" : "L1D");
+    STAT_EVENT(proc_id, PREF_PLUGIN_ISSUED_L1I + req->cache);
+    core.head = (core.head + 1) % core.queue.size();
+    core.count--;
+  }
+}
+
+/**************************************************************************************/
+/* pref_plugin_operate: */
+
+void pref_plugin_operate(uns proc_id, Pref_Plugin_Cache cache, Addr addr,
+                         Addr ip, Flag cache_hit, Flag prefetch_hit,
+                         Flag off_path) {
+  Pref_Plugin_Core& core = plugin_cores[proc_id];
+  for(uns ii = 0; ii < plugins.size(); ii++) {
+    if(plugins[ii]->cache == cache && plugins[ii]->operate)
+      plugins[ii]->operate(core.instances[ii], addr, ip, cache_hit,
+                           prefetch_hit, off_path);
+  }
+}
+
+/**************************************************************************************/
+/* pref_plugin_cache_fill: */
+
+void pref_plugin_cache_fill(uns proc_id, Pref_Plugin_Cache cache, Addr addr,
+                            Addr evicted_addr) {
+  Pref_Plugin_Core& core = plugin_cores[proc_id];
+  for(uns ii = 0; ii < plugins.size(); ii++) {
+    if(plugins[ii]->cache == cache && plugins[ii]->cache_fill)
+      plugins[ii]->cache_fill(core.instances[ii], addr, evicted_addr);
+  }
+}
+
+/**************************************************************************************/
+/* pref_plugin_branch_operate: */
+
+void pref_plugin_branch_operate(uns proc_id, Addr ip, uns8 branch_type,
+                                Addr branch_target) {
+  Pref_Plugin_Core& core = plugin_cores[proc_id];
+  for(uns ii = 0; ii < plugins.size(); ii++) {
+    if(plugins[ii]->branch_operate)
+      plugins[ii]->branch_operate(core.instances[ii], ip, branch_type,
+                                  branch_target);
+  }
+}
+
+/**************************************************************************************/
+/* pref_plugin_final_stats: */
+
+void pref_plugin_final_stats(uns proc_id) {
+  Pref_Plugin_Core& core = plugin_cores[proc_id];
+  for(uns ii = 0; ii < plugins.size(); ii++) {
+    if(plugins[ii]->final_stats)
+      plugins[ii]->final_stats(core.instances[ii]);
+  }
+}
+
+/**************************************************************************************/
+/* pref_plugin_prefetch_line: */
+
+Flag pref_plugin_prefetch_line(uns proc_id, Pref_Plugin_Cache cache,
+                               Addr addr) {
+  Pref_Plugin_Core& core      = plugin_cores[proc_id];
+  uns               size      = core.queue.size();
+  uns               line_size = cache == PREF_PLUGIN_L1I ? ICACHE_LINE_SIZE :
+                                                           DCACHE_LINE_SIZE;
+  Addr              line_addr = addr & ~(Addr)(line_size - 1);
+
+  STAT_EVENT(proc_id, PREF_PLUGIN_REQ);
+  for(uns ii = 0; ii < core.count; ii++) {
+    Pref_Plugin_Req* req = &core.queue[(core.head + ii) % size];
+    if(req->line_addr == line_addr && req->cache == cache) {
+      STAT_EVENT(proc_id, PREF_PLUGIN_REQ_MERGED);
+      return TRUE;
+    }
+  }
+  if(core.count == size) {
+    STAT_EVENT(proc_id, PREF_PLUGIN_QUEUE_FULL);
+    return FALSE;
+  }
+
+  core.queue[(core.head + core.count) % size] = {line_addr, cache};
+  core.count++;
+  return TRUE;
+}
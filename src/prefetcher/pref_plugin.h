@@ -0,0 +1,112 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : prefetcher/pref_plugin.h
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : ChampSim-style prefetcher plugin interface for the L1 instruction
+ *                and data caches.
+ *
+ * A plugin is described by a Pref_Plugin_Ops table. The framework creates one
+ * instance per core with 'init' and passes it back to every other callback;
+ * callbacks left NULL are skipped. Prefetches are requested with
+ * pref_plugin_prefetch_line() and are issued to the memory system in batches
+ * at the end of the core cycle.
+ *
+ * Built-in plugins are enabled by their own parameters (eip_enable, ...).
+ * Out-of-tree plugins are shared objects listed in pref_plugins; each exports
+ * PREF_PLUGIN_ENTRY, a Pref_Plugin_Entry_Func returning its ops table.
+ ***************************************************************************************/
+
+#ifndef __PREF_PLUGIN_H__
+#define __PREF_PLUGIN_H__
+
+#include "globals/global_types.h"
+
+/**************************************************************************************/
+/* Defines */
+
+#define PREF_PLUGIN_API_VERSION 1
+#define PREF_PLUGIN_ENTRY "scarab_pref_plugin"
+
+/**************************************************************************************/
+/* Types */
+
+typedef enum Pref_Plugin_Cache_enum {
+  PREF_PLUGIN_L1I,
+  PREF_PLUGIN_L1D,
+  NUM_PREF_PLUGIN_CACHES
+} Pref_Plugin_Cache;
+
+typedef struct Pref_Plugin_Ops_struct {
+  uns               api_version; /* PREF_PLUGIN_API_VERSION */
+  const char*       name;
+  Pref_Plugin_Cache cache; /* cache the plugin observes and prefetches into */
+
+  /* returns the instance of core proc_id */
+  void* (*init)(uns proc_id);
+  /* demand access to the cache, addr is the accessed address */
+  void (*operate)(void* pf, Addr addr, Addr ip, Flag cache_hit,
+                  Flag prefetch_hit, Flag off_path);
+  /* line addr was filled, evicting evicted_addr (0 if none) */
+  void (*cache_fill)(void* pf, Addr addr, Addr evicted_addr);
+  /* called once per core cycle, before the prefetch queue is drained */
+  void (*cycle_operate)(void* pf);
+  /* a control flow instruction was fetched (branch_type is a Cf_Type) */
+  void (*branch_operate)(void* pf, Addr ip, uns8 branch_type,
+                         Addr branch_target);
+  /* end of simulation of the core */
+  void (*final_stats)(void* pf);
+} Pref_Plugin_Ops;
+
+typedef const Pref_Plugin_Ops* (*Pref_Plugin_Entry_Func)(void);
+
+/**************************************************************************************/
+/* Prototypes */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void alloc_mem_pref_plugin(uns num_cores);
+void init_pref_plugin(uns proc_id);
+void update_pref_plugin(uns proc_id);
+
+/* events from the core */
+void pref_plugin_operate(uns proc_id, Pref_Plugin_Cache cache, Addr addr,
+                         Addr ip, Flag cache_hit, Flag prefetch_hit,
+                         Flag off_path);
+void pref_plugin_cache_fill(uns proc_id, Pref_Plugin_Cache cache, Addr addr,
+                            Addr evicted_addr);
+void pref_plugin_branch_operate(uns proc_id, Addr ip, uns8 branch_type,
+                                Addr branch_target);
+void pref_plugin_final_stats(uns proc_id);
+
+/* service for plugins: queue a prefetch of the line of addr into cache.
+   Returns FALSE if the prefetch queue of the core is full. */
+Flag pref_plugin_prefetch_line(uns proc_id, Pref_Plugin_Cache cache, Addr addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef __PREF_PLUGIN_H__ */
@@ -26,10 +26,7 @@
  * Description  : Defines an interface to Ramulator
  ***************************************************************************************/
 
-#include <deque>
-#include <list>
-#include <map>
-#include <utility>
+#include <vector>
 
 
 #include "ramulator/Config.h"
@@ -66,11 +63,78 @@ void enqueue_response(Request& req);
 
 void stats_callback(int coreid, int type);
 
-deque<pair<long, Mem_Req*>> resp_queue;  // completed read request that need to
-                                         // send back to Scarab
+// Scarab requests waiting for the read of a line (inflight) or holding its data
+// until they can be sent back to Scarab (responded). Requests to the same line
+// are chained through Mem_Req::ramulator_next, oldest first.
+struct Ramulator_Line {
+  long     addr;
+  Mem_Req* inflight;
+  Mem_Req* responded;
+  Mem_Req* responded_tail;
+};
+
+// Open addressing table (linear probing) of the lines that have requests.
+// There are never more of them than Scarab request buffers, so it is sized once.
+vector<Ramulator_Line> lines;
+uns64                  lines_mask;
+
+// completed read requests that need to be sent back to Scarab, oldest first
+vector<Mem_Req*> resp_ring;
+uns              resp_head  = 0;
+uns              resp_count = 0;
+
+// Idle DRAM ticks (RAMULATOR_SKIP_IDLE): ramulator_tick() only counts them in
+// skipped_ticks while idle_ticks_left lasts, and catch_up() replays them in one
+// step before anything else touches the DRAM model.
+long idle_ticks_left = 0;
+long skipped_ticks   = 0;
+
+static void catch_up() {
+  if(skipped_ticks) {
+    wrapper->skip(skipped_ticks);
+    skipped_ticks = 0;
+  }
+  idle_ticks_left = 0;
+}
 
-map<long, list<Mem_Req*>> inflight_read_reqs;
-// map<long, Mem_Req*> inflight_read_reqs;
+static inline uns64 line_slot(long addr) {
+  return (((uns64)addr * 0x9E3779B97F4A7C15ULL) >> 32) & lines_mask;
+}
+
+static inline Flag line_is_free(const Ramulator_Line* line) {
+  return !line->inflight && !line->responded;
+}
+
+/* find_line: returns the entry of addr, or NULL if it has no requests (a free
+   entry for it if 'create') */
+static Ramulator_Line* find_line(long addr, Flag create) {
+  for(uns64 slot = line_slot(addr);; slot = (slot + 1) & lines_mask) {
+    Ramulator_Line* line = &lines[slot];
+    if(line_is_free(line)) {
+      if(!create)
+        return NULL;
+      line->addr = addr;
+      return line;
+    }
+    if(line->addr == addr)
+      return line;
+  }
+}
+
+/* free_line: removes an entry whose chains are empty, moving back the entries
+   that probed past it */
+static void free_line(Ramulator_Line* line) {
+  uns64 hole = line - &lines[0];
+  for(uns64 slot = (hole + 1) & lines_mask; !line_is_free(&lines[slot]);
+      slot     = (slot + 1) & lines_mask) {
+    uns64 home = line_slot(lines[slot].addr);
+    if(((slot - home) & lines_mask) >= ((slot - hole) & lines_mask)) {
+      lines[hole] = lines[slot];
+      hole        = slot;
+    }
+  }
+  lines[hole] = Ramulator_Line();
+}
 
 void ramulator_init() {
   ASSERTM(0, ICACHE_LINE_SIZE == DCACHE_LINE_SIZE,
@@ -85,14 +149,33 @@ void ramulator_init() {
 
   wrapper = new ScarabWrapper(*configs, DCACHE_LINE_SIZE, &stats_callback);
 
+  uns64 num_lines = 1;
+  while(num_lines < 2 * (uns64)mem->total_mem_req_buffers)
+    num_lines <<= 1;
+  lines.assign(num_lines, Ramulator_Line());
+  lines_mask = num_lines - 1;
+  resp_ring.assign(mem->total_mem_req_buffers, NULL);
+
   DPRINTF("Initialized Ramulator. \n");
 }
 
 void ramulator_finish() {
+  catch_up();
   wrapper->finish();
 
   delete wrapper;
   delete configs;
+  wrapper = NULL;
+}
+
+void ramulator_set_output_dir(const char* dir) {
+  wrapper->set_output_dir(dir);
+}
+
+/* the channel threads restart at the next tick; threads do not survive fork() */
+void ramulator_stop_threads() {
+  if(wrapper)
+    wrapper->stop_threads();
 }
 
 void stats_callback(int coreid, int type) {
@@ -137,6 +220,8 @@ void init_configs() {
 
   configs->add("record_cmd_trace", RAMULATOR_REC_CMD_TRACE);
   configs->add("print_cmd_trace", RAMULATOR_PRINT_CMD_TRACE);
+  configs->add("flat_timing", RAMULATOR_FLAT_TIMING);
+  configs->add("channel_threads", to_string(RAMULATOR_CHANNEL_THREADS));
   configs->add("use_rest_of_addr_as_row_addr",
                RAMULATOR_USE_REST_OF_ADDR_AS_ROW_ADDR);
 
@@ -176,36 +261,37 @@ int ramulator_send(Mem_Req* scarab_req) {
   // printf("Ramulator: Received a (%s) request to address %llu\n",
   // Mem_Req_Type_str(scarab_req->type), scarab_req->addr);
 
-  // does inflight_read_reqs have the proc_id in the req?
-  auto it_scarab_req = inflight_read_reqs.find(req.addr);
-  if(it_scarab_req != inflight_read_reqs.end() &&
-     req.type == Request::Type::READ) {
+  // is a read of the same line already in Ramulator?
+  Ramulator_Line* line = req.type == Request::Type::READ ?
+                           find_line(req.addr, FALSE) :
+                           NULL;
+  if(line && line->inflight) {
     DEBUG(scarab_req->proc_id,
           "Ramulator: Duplicate (%s) request to address %llx\n",
           Mem_Req_Type_str(scarab_req->type), scarab_req->addr);
     // Can have duplicate Ifetch and Dfetch requests, but only one of each
-    ASSERT(0, it_scarab_req->second.size() <= 1);
+    ASSERT(0, !line->inflight->ramulator_next);
 
-    if(req.type == Request::Type::READ)
-      inflight_read_reqs[req.addr].push_back(
-        scarab_req);  // save it as an inflight request so later it will be
-                      // moved to the resp_queue at the same time with the older
-                      // request
-    scarab_req->mem_queue_cycle = cycle_count;
+    // it completes at the same time as the older request
+    line->inflight->ramulator_next = scarab_req;
+    scarab_req->ramulator_next     = NULL;
+    scarab_req->mem_queue_cycle    = cycle_count;
     return true;  // a request to the same address is already issued
   }
 
+  catch_up();  // the request is stamped with the DRAM clock
   bool is_sent = wrapper->send(req);
 
   if(is_sent) {
     STAT_EVENT(scarab_req->proc_id, POWER_MEMORY_CTRL_ACCESS);
 
     if(req.type == Request::Type::READ) {
-      ASSERTM(0, inflight_read_reqs.find(req.addr) == inflight_read_reqs.end(),
+      line = find_line(req.addr, TRUE);
+      ASSERTM(0, !line->inflight,
               "ERROR: A read request to the same address shouldn't be sent "
               "multiple times to Ramulator\n");
-      // inflight_read_reqs[req.addr] = scarab_req;
-      inflight_read_reqs[req.addr].push_back(scarab_req);
+      line->inflight             = scarab_req;
+      scarab_req->ramulator_next = NULL;
       STAT_EVENT(scarab_req->proc_id, POWER_MEMORY_CTRL_READ);
     } else if(req.type == Request::Type::WRITE) {
       STAT_EVENT(scarab_req->proc_id, POWER_MEMORY_CTRL_WRITE);
@@ -228,17 +314,25 @@ void enqueue_response(Request& req) {
   // This should only be called by READ requests
   ASSERTM(0, req.type == Request::Type::READ,
           "ERROR: Responses should be sent only for read requests! \n");
-  ASSERTM(0, inflight_read_reqs.find(req.addr) != inflight_read_reqs.end(),
+  Ramulator_Line* line = find_line(req.addr, FALSE);
+  ASSERTM(0, line && line->inflight,
           "ERROR: A corresponding Scarab request was not found for the "
           "Ramulator request that read address: %lu\n",
           req.addr);
 
-  auto it_scarab_req = inflight_read_reqs.find(req.addr);
-  for(auto req : it_scarab_req->second)
-    resp_queue.push_back(make_pair(it_scarab_req->first, req));
-  // resp_queue.push_back(make_pair(it_scarab_req->first,
-  // it_scarab_req->second));
-  inflight_read_reqs.erase(it_scarab_req);
+  Mem_Req* last = NULL;
+  for(Mem_Req* scarab_req = line->inflight; scarab_req;
+      scarab_req         = scarab_req->ramulator_next) {
+    ASSERT(0, resp_count < resp_ring.size());
+    resp_ring[(resp_head + resp_count++) % resp_ring.size()] = scarab_req;
+    last = scarab_req;
+  }
+  if(line->responded)
+    line->responded_tail->ramulator_next = line->inflight;
+  else
+    line->responded = line->inflight;
+  line->responded_tail = last;
+  line->inflight       = NULL;
 }
 
 bool try_completing_request(Mem_Req* req) {
@@ -296,11 +390,32 @@ void to_ramulator_req(const Mem_Req* scarab_req, Request* ramulator_req) {
 }
 
 void ramulator_tick() {
+  if(idle_ticks_left && !resp_count) {
+    idle_ticks_left--;
+    skipped_ticks++;
+    return;
+  }
+
+  catch_up();
   wrapper->tick();
+  if(RAMULATOR_SKIP_IDLE)
+    idle_ticks_left = wrapper->idle_cycles();
 
-  if(resp_queue.size() > 0) {
-    if(try_completing_request(resp_queue.front().second))
-      resp_queue.pop_front();
+  for(uns ii = 0; ii < RAMULATOR_RESPONSES_PER_CYCLE && resp_count; ii++) {
+    Mem_Req* req = resp_ring[resp_head];
+    if(!try_completing_request(req))
+      break;
+    resp_head = (resp_head + 1) % resp_ring.size();
+    resp_count--;
+
+    // responses of a line complete in order, so req heads its chain
+    Ramulator_Line* line = find_line(req->phys_addr, FALSE);
+    ASSERT(0, line && line->responded == req);
+    line->responded = req->ramulator_next;
+    if(!line->responded)
+      line->responded_tail = NULL;
+    if(line_is_free(line))
+      free_line(line);
   }
 }
 
@@ -320,6 +435,20 @@ int ramulator_get_chip_row_buffer_size() {
   return wrapper->get_chip_row_buffer_size();
 }
 
+static Flag is_inst_req(Mem_Req_Type type) {
+  return type == MRT_IFETCH || type == MRT_IPRF || type == MRT_FDIPPRFON ||
+         type == MRT_FDIPPRFOFF || type == MRT_UOCPRF;
+}
+
+static Flag is_data_req(Mem_Req_Type type) {
+  return type == MRT_DFETCH || type == MRT_DPRF || type == MRT_DSTORE;
+}
+
+static Flag same_cache_side(Mem_Req_Type a, Mem_Req_Type b) {
+  return (is_inst_req(a) && is_inst_req(b)) ||
+         (is_data_req(a) && is_data_req(b));
+}
+
 Mem_Req* ramulator_search_queue(long phys_addr, Mem_Req_Type type) {
   ASSERTM(
     0,
@@ -327,34 +456,18 @@ Mem_Req* ramulator_search_queue(long phys_addr, Mem_Req_Type type) {
       (type == MRT_DPRF) || (type == MRT_DSTORE) || (type == MRT_MIN_PRIORITY) ||
       (type == MRT_FDIPPRFON) || (type == MRT_FDIPPRFOFF) || (type == MRT_UOCPRF),
     "Ramulator: Cannot search write requests in Ramulator request queue\n");
-  auto it_req = inflight_read_reqs.find(phys_addr);
-
-  // Search request queue
-  if(it_req != inflight_read_reqs.end()) {
-    for(auto req : it_req->second) {
-      if((req->type == MRT_IFETCH || req->type == MRT_IPRF || req->type == MRT_FDIPPRFON || req->type == MRT_FDIPPRFOFF || req->type == MRT_UOCPRF) &&
-         (type == MRT_IFETCH || type == MRT_IPRF || type == MRT_FDIPPRFON || type == MRT_FDIPPRFOFF || type == MRT_UOCPRF))
-        return req;
-      else if((req->type == MRT_DFETCH || req->type == MRT_DPRF ||
-               req->type == MRT_DSTORE) &&
-              (type == MRT_DFETCH || type == MRT_DPRF || type == MRT_DSTORE))
-        return req;
-    }
+  Ramulator_Line* line = find_line(phys_addr, FALSE);
+  if(!line)
+    return NULL;
+
+  // Search request queue, then response queue
+  for(Mem_Req* req = line->inflight; req; req = req->ramulator_next) {
+    if(same_cache_side(req->type, type))
+      return req;
   }
-
-  // Search response queue
-  for(auto resp : resp_queue) {
-    if(resp.first == phys_addr) {
-      if((resp.second->type == MRT_IFETCH || resp.second->type == MRT_IPRF ||
-          resp.second->type == MRT_FDIPPRFON || resp.second->type == MRT_FDIPPRFOFF || resp.second->type == MRT_UOCPRF) &&
-         (type == MRT_IFETCH || type == MRT_IPRF || type == MRT_FDIPPRFON || type == MRT_FDIPPRFOFF || type == MRT_UOCPRF))
-        return resp.second;
-      else if((resp.second->type == MRT_DFETCH ||
-               resp.second->type == MRT_DPRF ||
-               resp.second->type == MRT_DSTORE) &&
-              (type == MRT_DFETCH || type == MRT_DPRF || type == MRT_DSTORE))
-        return resp.second;
-    }
+  for(Mem_Req* req = line->responded; req; req = req->ramulator_next) {
+    if(same_cache_side(req->type, type))
+      return req;
   }
 
   return NULL;
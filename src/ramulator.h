@@ -40,6 +40,8 @@
 
 EXTERNC void ramulator_init();
 EXTERNC void ramulator_finish();
+EXTERNC void ramulator_set_output_dir(const char* dir);
+EXTERNC void ramulator_stop_threads();
 
 EXTERNC int  ramulator_send(Mem_Req* scarab_req);
 EXTERNC void ramulator_tick();
@@ -0,0 +1,94 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ChannelThreads.h"
+
+using namespace std;
+using namespace ramulator;
+
+// spins before a waiting thread starts yielding its core
+static const int SPINS_BEFORE_YIELD = 4096;
+
+static inline void spin_wait(int& spins) {
+    if (++spins > SPINS_BEFORE_YIELD)
+        this_thread::yield();
+}
+
+ChannelThreads::ChannelThreads(int threads, int channels, function<void(int)> task)
+    : threads(min(threads, channels)), channels(channels), task(task)
+{
+    // spinning threads must not share cores
+    int cores = thread::hardware_concurrency();
+    if (cores > 0 && this->threads > cores)
+        this->threads = cores;
+}
+
+ChannelThreads::~ChannelThreads()
+{
+    stop();
+}
+
+void ChannelThreads::run_share(int id)
+{
+    for (int i = id; i < channels; i += threads)
+        task(i);
+}
+
+void ChannelThreads::worker(int id, long seen)
+{
+    while (true) {
+        int spins = 0;
+        long cur;
+        while ((cur = generation.load(memory_order_acquire)) == seen) {
+            if (stopping.load(memory_order_relaxed))
+                return;
+            spin_wait(spins);
+        }
+        seen = cur;
+        run_share(id);
+        finished.fetch_add(1, memory_order_release);
+    }
+}
+
+void ChannelThreads::run()
+{
+    if (workers.empty()) {
+        stopping = false;
+        for (int id = 1; id < threads; id++)
+            workers.emplace_back(&ChannelThreads::worker, this, id,
+                                 generation.load());
+    }
+
+    generation.fetch_add(1, memory_order_release);
+    run_share(0);
+    int spins = 0;
+    while (finished.load(memory_order_acquire) != threads - 1)
+        spin_wait(spins);
+    finished.store(0, memory_order_relaxed);
+}
+
+void ChannelThreads::stop()
+{
+    stopping = true;
+    for (auto& t : workers)
+        t.join();
+    workers.clear();
+}
@@ -0,0 +1,73 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * ChannelThreads.h
+ *
+ * Worker threads that tick the channel controllers of a Memory in parallel.
+ * run() calls task(i) for every channel i and returns when all of them are
+ * done; channel i always runs on thread i % threads, the calling thread being
+ * thread 0. DRAM cycles are short, so the workers spin between cycles instead
+ * of sleeping.
+ *
+ * Threads do not survive fork(): stop() joins the workers, and the next run()
+ * starts them again.
+ */
+
+#ifndef __CHANNEL_THREADS_H
+#define __CHANNEL_THREADS_H
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace ramulator
+{
+
+class ChannelThreads
+{
+public:
+    ChannelThreads(int threads, int channels, function<void(int)> task);
+    ~ChannelThreads();
+
+    void run();
+    void stop();
+
+private:
+    int threads;
+    int channels;
+    function<void(int)> task;
+    vector<thread> workers;
+
+    atomic<long> generation{0};  // bumped by run() to start a cycle
+    atomic<int> finished{0};     // workers done with the current cycle
+    atomic<bool> stopping{false};
+
+    void run_share(int id);
+    void worker(int id, long seen);
+};
+
+} /*namespace ramulator*/
+
+#endif /*__CHANNEL_THREADS_H*/
@@ -70,7 +70,9 @@ private:
         // Other
         {"record_cmd_trace", "off"},
         {"print_cmd_trace", "off"},
-        {"use_rest_of_addr_as_row_addr", "on"}
+        {"use_rest_of_addr_as_row_addr", "on"},
+        {"flat_timing", "off"},
+        {"channel_threads", "1"}
     };
 
 	template<typename T>
@@ -197,6 +199,16 @@ public:
       }
       return false;
     }
+    bool flat_timing() const {
+      // the default value is false
+      if (options.find("flat_timing") != options.end()) {
+        if ((options.find("flat_timing"))->second == "on") {
+          return true;
+        }
+        return false;
+      }
+      return false;
+    }
     bool use_rest_of_addr_as_row_addr() const {
       if (options.find("use_rest_of_addr_as_row_addr") != options.end()) {
         if ((options.find("use_rest_of_addr_as_row_addr"))->second == "on") {
@@ -88,7 +88,7 @@ void Controller<TLDRAM>::tick(){
                   channel->update_serving_requests(
                       req.addr_vec.data(), -1, clk);
           }
-            req.callback(req);
+            complete(req);
             pending.pop_front();
         }
     }
@@ -184,6 +184,12 @@ void Controller<TLDRAM>::tick(){
     queue->q.erase(req);
 }
 
+template <>
+long Controller<TLDRAM>::idle_cycles() {
+    // the TLDRAM tick has its own write mode and queue length accounting
+    return 0;
+}
+
 template<>
 void Controller<TLDRAM>::cmd_issue_autoprecharge(typename TLDRAM::Command& cmd,
                                                     const vector<int>& addr_vec) {
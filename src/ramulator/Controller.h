@@ -127,6 +127,12 @@ public:
     // callback function for passing stats to Scarab when an event occurs
     void (*stats_callback)(int, int) = nullptr;
 
+    // When the channels tick on several threads, the completions and stat
+    // events of a tick are kept here until Memory reports them in channel order
+    bool defer_callbacks = false;
+    vector<Request> deferred_reqs;
+    vector<pair<int, int>> deferred_stats;
+
 
     /* Constructor */
     Controller(const Config& configs, DRAM<T>* channel, void (*_stats_callback)(int,int)) :
@@ -140,6 +146,9 @@ public:
 
         stats_callback = _stats_callback;
 
+        if (configs.flat_timing())
+            channel->flatten_timing();
+
         record_cmd_trace = configs.record_cmd_trace();
         print_cmd_trace = configs.print_cmd_trace();
         if (record_cmd_trace){
@@ -377,7 +386,7 @@ public:
                   channel->update_serving_requests(
                       req.addr_vec.data(), -1, clk);
                 }
-                req.callback(req);
+                complete(req);
                 pending.pop_front();
             }
         }
@@ -539,6 +548,59 @@ public:
       return clk <= channel->end_of_refreshing;
     }
 
+    void complete(Request& req)
+    {
+        if (defer_callbacks)
+            deferred_reqs.push_back(req);
+        else
+            req.callback(req);
+    }
+
+    void report_stat(int coreid, StatCallbackType type)
+    {
+        if (defer_callbacks)
+            deferred_stats.push_back(make_pair(coreid, int(type)));
+        else
+            stats_callback(coreid, int(type));
+    }
+
+    // Reports the deferred events of the last tick
+    void flush_callbacks()
+    {
+        for (auto& stat : deferred_stats)
+            stats_callback(stat.first, stat.second);
+        for (auto& req : deferred_reqs)
+            req.callback(req);
+        deferred_stats.clear();
+        deferred_reqs.clear();
+    }
+
+    // Number of upcoming ticks that cannot change any state: nothing to
+    // schedule (writes may wait in writeq below the write mode watermark),
+    // no speculative precharge, no completing read and no refresh due
+    long idle_cycles() {
+      if (readq.size() || actq.size() || otherq.size())
+        return 0;
+      if (write_mode ? writeq.size() != 0 :
+          writeq.size() > unsigned(wr_high_watermark * writeq.max))
+        return 0;
+      if (rowpolicy->type != RowPolicy<T>::Type::Opened && rowtable->table.size())
+        return 0;
+      long next = refresh->next_event_clk();
+      if (pending.size())
+        next = min(next, pending[0].depart);
+      return max(0L, next - clk - 1);
+    }
+
+    // Equivalent to 'cycles' ticks when idle_cycles() >= cycles
+    void skip(long cycles) {
+      clk += cycles;
+      refresh->clk += cycles;
+      req_queue_length_sum += (writeq.size() + pending.size()) * cycles;
+      read_req_queue_length_sum += pending.size() * cycles;
+      write_req_queue_length_sum += writeq.size() * cycles;
+    }
+
     void set_high_writeq_watermark(const float watermark) {
        wr_high_watermark = watermark; 
     }
@@ -622,16 +684,16 @@ private:
         channel->update(cmd, addr_vec.data(), clk);
 
         if(channel->spec->is_opening(cmd))
-            stats_callback(coreid, int(StatCallbackType::DRAM_ACT));
+            report_stat(coreid, StatCallbackType::DRAM_ACT);
 
         if(channel->spec->is_closing(cmd))
-            stats_callback(coreid, int(StatCallbackType::DRAM_PRE));
+            report_stat(coreid, StatCallbackType::DRAM_PRE);
         
         if(channel->spec->is_reading(cmd))
-            stats_callback(coreid, int(StatCallbackType::DRAM_READ));
+            report_stat(coreid, StatCallbackType::DRAM_READ);
 
         if(channel->spec->is_writing(cmd))
-            stats_callback(coreid, int(StatCallbackType::DRAM_WRITE));
+            report_stat(coreid, StatCallbackType::DRAM_WRITE);
 
 
         if(cmd == T::Command::PRE){
@@ -681,6 +743,9 @@ void Controller<ALDRAM>::update_temp(ALDRAM::Temp current_temperature);
 template <>
 void Controller<TLDRAM>::tick();
 
+template <>
+long Controller<TLDRAM>::idle_cycles();
+
 template <>
 void Controller<TLDRAM>::cmd_issue_autoprecharge(typename TLDRAM::Command& cmd,
                                                     const vector<int>& addr_vec);
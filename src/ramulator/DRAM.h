@@ -30,6 +30,7 @@
 #include <functional>
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <type_traits>
 
 using namespace std;
@@ -91,6 +92,11 @@ public:
 
     // Update the timing/state of the tree, signifying that a command has been issued
     void update(typename T::Command cmd, const int* addr, long clk);
+
+    // Keep the timing state of the whole tree in flat tables owned by this
+    // (root) node. check, get_next and update then index them directly
+    // instead of walking the tree; the timing specs are unchanged.
+    void flatten_timing();
     // Update statistics:
 
     // Update the number of requests it serves currently
@@ -137,9 +143,46 @@ private:
     // E.g., activate->precharge: tRAS@bank, activate->activate: tRC@bank
     vector<typename T::TimingEntry>* timing;
 
+    // Flattened timing state (see flatten_timing). The nodes of each level are
+    // numbered densely, a child's flat id being parent flat id * fanout + id,
+    // so the path of an address is one multiply-add per level.
+    struct FlatTiming
+    {
+        struct Entry
+        {
+            int cmd;
+            int dist;
+            int val;
+            bool refresh; // refresh statistics are updated (see update_timing)
+        };
+
+        int end_level; // last instantiated level + 1
+        int fanout[int(T::Level::MAX)]; // children per node of the level above
+        vector<DRAM<T>*> nodes[int(T::Level::MAX)]; // by flat id
+
+        // earliest ready time, [flat id * Command::MAX + cmd]
+        vector<long> next[int(T::Level::MAX)];
+
+        // command history of each node, hist_dist[level][cmd] most recent
+        // first at hist_offset[level][cmd] in the node's hist_stride[level] slots
+        int hist_dist[int(T::Level::MAX)][int(T::Command::MAX)];
+        int hist_offset[int(T::Level::MAX)][int(T::Command::MAX)];
+        int hist_stride[int(T::Level::MAX)];
+        vector<long> hist[int(T::Level::MAX)];
+
+        // timing constraints a command puts on its target nodes and their siblings
+        vector<Entry> target[int(T::Level::MAX)][int(T::Command::MAX)];
+        vector<Entry> sibling[int(T::Level::MAX)][int(T::Command::MAX)];
+    };
+    FlatTiming* flat = NULL;
+
     // Helper Functions
     void update_state(typename T::Command cmd, const int* addr);
     void update_timing(typename T::Command cmd, const int* addr, long clk);
+    bool check_flat(typename T::Command cmd, const int* addr, long clk);
+    long get_next_flat(typename T::Command cmd, const int* addr);
+    void update_timing_flat(typename T::Command cmd, const int* addr, long clk);
+    void record_refresh(long clk, long end);
 }; /* class DRAM */
 
 
@@ -253,6 +296,55 @@ DRAM<T>::~DRAM()
 {
     for (auto child: children)
         delete child;
+    delete flat;
+}
+
+// Flatten timing
+template <typename T>
+void DRAM<T>::flatten_timing()
+{
+    assert(!parent && !flat);
+    const int cmds = int(T::Command::MAX);
+    flat = new FlatTiming;
+
+    vector<DRAM<T>*> nodes = {this};
+    for (int l = int(level); ; l++) {
+        flat->nodes[l] = nodes;
+        flat->next[l].assign(nodes.size() * cmds, -1);
+
+        flat->hist_stride[l] = 0;
+        for (int cmd = 0; cmd < cmds; cmd++) {
+            int dist = 0;
+            for (auto& t : spec->timing[l][cmd]) {
+                typename FlatTiming::Entry e = {int(t.cmd), t.dist, t.val,
+                    spec->is_refreshing(typename T::Command(cmd)) && spec->is_opening(t.cmd)};
+                if (t.sibling) {
+                    assert(t.dist == 1);
+                    flat->sibling[l][cmd].push_back(e);
+                } else {
+                    flat->target[l][cmd].push_back(e);
+                    dist = max(dist, t.dist);
+                }
+            }
+            flat->hist_dist[l][cmd] = dist;
+            flat->hist_offset[l][cmd] = flat->hist_stride[l];
+            flat->hist_stride[l] += dist;
+        }
+        flat->hist[l].assign(nodes.size() * flat->hist_stride[l], -1);
+
+        int fanout = nodes[0]->children.size();
+        if (!fanout) {
+            flat->end_level = l + 1;
+            break;
+        }
+        flat->fanout[l + 1] = fanout;
+        vector<DRAM<T>*> child_nodes;
+        for (auto node : nodes) {
+            assert(int(node->children.size()) == fanout);
+            child_nodes.insert(child_nodes.end(), node->children.begin(), node->children.end());
+        }
+        nodes.swap(child_nodes);
+    }
 }
 
 // Insert
@@ -287,6 +379,9 @@ typename T::Command DRAM<T>::decode(typename T::Command cmd, const int* addr)
 template <typename T>
 bool DRAM<T>::check(typename T::Command cmd, const int* addr, long clk)
 {
+    if (flat)
+        return check_flat(cmd, addr, clk);
+
     if (next[int(cmd)] != -1 && clk < next[int(cmd)])
         return false; // stop recursion: the check failed at this level
 
@@ -333,6 +428,9 @@ bool DRAM<T>::check_row_open(typename T::Command cmd, const int* addr)
 template <typename T>
 long DRAM<T>::get_next(typename T::Command cmd, const int* addr)
 {
+    if (flat)
+        return get_next_flat(cmd, addr);
+
     long next_clk = max(cur_clk, next[int(cmd)]);
     auto node = this;
     for (int l = int(level); l < int(spec->scope[int(cmd)]) && node->children.size() && addr[l + 1] >= 0; l++){
@@ -348,7 +446,10 @@ void DRAM<T>::update(typename T::Command cmd, const int* addr, long clk)
 {
     cur_clk = clk;
     update_state(cmd, addr);
-    update_timing(cmd, addr, clk);
+    if (flat)
+        update_timing_flat(cmd, addr, clk);
+    else
+        update_timing(cmd, addr, clk);
 }
 
 
@@ -406,12 +507,7 @@ void DRAM<T>::update_timing(typename T::Command cmd, const int* addr, long clk)
         // TIANSHI: for refresh statistics
         if (spec->is_refreshing(cmd) && spec->is_opening(t.cmd)) {
           assert(past == clk);
-          begin_of_refreshing = clk;
-          end_of_refreshing = max(end_of_refreshing, next[int(t.cmd)]);
-          refresh_cycles += end_of_refreshing - clk;
-          if (cur_serving_requests > 0) {
-            refresh_intervals.push_back(make_pair(begin_of_refreshing, end_of_refreshing));
-          }
+          record_refresh(clk, next[int(t.cmd)]);
         }
     }
 
@@ -426,6 +522,105 @@ void DRAM<T>::update_timing(typename T::Command cmd, const int* addr, long clk)
 
 }
 
+// Refresh statistics: a refresh issued at clk keeps the node busy until end
+template <typename T>
+void DRAM<T>::record_refresh(long clk, long end)
+{
+    begin_of_refreshing = clk;
+    end_of_refreshing = max(end_of_refreshing, end);
+    refresh_cycles += end_of_refreshing - clk;
+    if (cur_serving_requests > 0) {
+      refresh_intervals.push_back(make_pair(begin_of_refreshing, end_of_refreshing));
+    }
+}
+
+// Check (flattened): same walk as check, over the flat tables
+template <typename T>
+bool DRAM<T>::check_flat(typename T::Command cmd, const int* addr, long clk)
+{
+    const int cmds = int(T::Command::MAX);
+    int scope = int(spec->scope[int(cmd)]);
+    long idx = 0;
+    for (int l = int(level); ; l++) {
+        if (clk < flat->next[l][idx * cmds + int(cmd)])
+            return false;
+
+        int child_id = addr[l + 1];
+        if (child_id < 0 || l == scope || l + 1 == flat->end_level)
+            return true;
+        idx = idx * flat->fanout[l + 1] + child_id;
+    }
+}
+
+template <typename T>
+long DRAM<T>::get_next_flat(typename T::Command cmd, const int* addr)
+{
+    const int cmds = int(T::Command::MAX);
+    int scope = int(spec->scope[int(cmd)]);
+    long next_clk = max(cur_clk, flat->next[int(level)][int(cmd)]);
+    long idx = 0;
+    for (int l = int(level); l < scope && l + 1 < flat->end_level && addr[l + 1] >= 0; l++) {
+        idx = idx * flat->fanout[l + 1] + addr[l + 1];
+        next_clk = max(next_clk, flat->next[l + 1][idx * cmds + int(cmd)]);
+    }
+    return next_clk;
+}
+
+// Update (Timing, flattened): the target node of each level on the path of
+// addr records the command and applies its constraints, the other children of
+// each target node apply the sibling constraints
+template <typename T>
+void DRAM<T>::update_timing_flat(typename T::Command cmd, const int* addr, long clk)
+{
+    const int cmds = int(T::Command::MAX);
+    const int c = int(cmd);
+    assert(id == addr[int(level)]);
+
+    long idx = 0;
+    for (int l = int(level); ; l++) {
+        int dist = flat->hist_dist[l][c];
+        long* hist = flat->hist[l].data() + idx * flat->hist_stride[l] + flat->hist_offset[l][c];
+        if (dist) {
+            memmove(hist + 1, hist, (dist - 1) * sizeof(long));
+            hist[0] = clk; // update history
+        }
+
+        long* next_clks = &flat->next[l][idx * cmds];
+        for (auto& t : flat->target[l][c]) {
+            long past = hist[t.dist - 1];
+            if (past < 0)
+                continue; // not enough history
+
+            next_clks[t.cmd] = max(next_clks[t.cmd], past + t.val);
+            if (t.refresh) {
+                assert(past == clk);
+                flat->nodes[l][idx]->record_refresh(clk, next_clks[t.cmd]);
+            }
+        }
+
+        if (l + 1 == flat->end_level)
+            return;
+
+        int child_id = addr[l + 1];
+        int fanout = flat->fanout[l + 1];
+        long first = idx * fanout;
+        auto& sibling = flat->sibling[l + 1][c];
+        if (sibling.size()) {
+            for (int i = 0; i < fanout; i++) {
+                if (i == child_id)
+                    continue;
+                long* sibling_next = &flat->next[l + 1][(first + i) * cmds];
+                for (auto& t : sibling)
+                    sibling_next[t.cmd] = max(sibling_next[t.cmd], clk + t.val);
+            }
+        }
+
+        if (child_id < 0)
+            return; // no target below this level
+        idx = first + child_id;
+    }
+}
+
 template <typename T>
 void DRAM<T>::update_serving_requests(const int* addr, int delta, long clk) {
   assert(id == addr[int(level)]);
@@ -25,6 +25,7 @@
 #include "Config.h"
 #include "DRAM.h"
 #include "Request.h"
+#include "ChannelThreads.h"
 #include "Controller.h"
 #include "SpeedyController.h"
 #include "Statistics.h"
@@ -56,6 +57,9 @@ public:
     virtual void tick() = 0;
     virtual bool send(Request req) = 0;
     virtual int pending_requests() = 0;
+    virtual long idle_cycles() = 0;
+    virtual void skip(long cycles) = 0;
+    virtual void stop_threads() = 0;
     virtual void finish(void) = 0;
     virtual long page_allocator(long addr, int coreid) = 0;
     virtual void record_core(int coreid) = 0;
@@ -134,6 +138,7 @@ public:
     map<pair<int, long>, long> page_translation;
 
     vector<Controller<T>*> ctrls;
+    ChannelThreads* channel_threads = nullptr;  // ticks the channels in parallel
     T * spec;
     vector<int> addr_bits;
 
@@ -167,6 +172,17 @@ public:
 
         addr_bits[int(T::Level::MAX) - 1] -= calc_log2(spec->prefetch_size);
 
+        // Channels only interact through the callbacks, which are deferred and
+        // reported in channel order, so results do not depend on the threads.
+        // Printed command traces would interleave, so they keep one thread.
+        int threads = configs.get_int("channel_threads");
+        if (threads > 1 && ctrls.size() > 1 && !configs.print_cmd_trace()) {
+            for (auto ctrl : ctrls)
+                ctrl->defer_callbacks = true;
+            channel_threads = new ChannelThreads(threads, ctrls.size(),
+                [this](int i) { this->ctrls[i]->tick(); });
+        }
+
         // Initiating translation
         if (configs.contains("translation")) {
           translation = name_to_translation[configs["translation"]];
@@ -284,6 +300,7 @@ public:
 
     ~Memory()
     {
+        delete channel_threads;
         for (auto ctrl: ctrls)
             delete ctrl;
         delete spec;
@@ -337,16 +354,61 @@ public:
         in_queue_read_req_num_sum += cur_que_readreq_num;
         in_queue_write_req_num_sum += cur_que_writereq_num;
 
+        bool is_active = false;
+        if (channel_threads) {
+          for (auto ctrl : ctrls)
+            is_active = is_active || ctrl->is_active();
+          channel_threads->run();
+          for (auto ctrl : ctrls)
+            ctrl->flush_callbacks();
+        } else {
+          for (auto ctrl : ctrls) {
+            is_active = is_active || ctrl->is_active();
+            ctrl->tick();
+          }
+        }
+        if (is_active) {
+          ramulator_active_cycles++;
+        }
+    }
+
+    // Number of upcoming ticks that would only advance the clocks
+    long idle_cycles()
+    {
+        long idle = LONG_MAX;
+        for (auto ctrl : ctrls)
+          idle = min(idle, ctrl->idle_cycles());
+        return idle;
+    }
+
+    // Same effect as 'cycles' calls to tick() when idle_cycles() >= cycles
+    void skip(long cycles)
+    {
+        num_dram_cycles += cycles;
+        int cur_que_readreq_num = 0;
+        int cur_que_writereq_num = 0;
         bool is_active = false;
         for (auto ctrl : ctrls) {
+          cur_que_readreq_num += ctrl->pending.size();
+          cur_que_writereq_num += ctrl->writeq.size();
           is_active = is_active || ctrl->is_active();
-          ctrl->tick();
+          ctrl->skip(cycles);
         }
+        in_queue_req_num_sum += long(cur_que_readreq_num + cur_que_writereq_num) * cycles;
+        in_queue_read_req_num_sum += long(cur_que_readreq_num) * cycles;
+        in_queue_write_req_num_sum += long(cur_que_writereq_num) * cycles;
         if (is_active) {
-          ramulator_active_cycles++;
+          ramulator_active_cycles += cycles;
         }
     }
 
+    // Joins the channel threads, e.g. before a fork; the next tick restarts them
+    void stop_threads()
+    {
+        if (channel_threads)
+            channel_threads->stop();
+    }
+
     bool send(Request req)
     {
         req.addr_vec.resize(addr_bits.size());
@@ -422,6 +484,7 @@ public:
     }
 
     void finish(void) {
+      stop_threads();
       dram_capacity = max_address;
       int *sz = spec->org_entry.count;
       maximum_bandwidth = spec->speed_entry.rate * 1e6 * spec->channel_width * sz[int(T::Level::Channel)] / 8;
@@ -271,6 +271,12 @@ void Refresh<DSARP>::tick_ref() {
   if ((clk - refreshed) >= refresh_interval)
     inject_refresh(b_ref_rank);
 }
+
+// Early refreshes and WRP act on every tick, so DSARP never skips ticks
+template<>
+long Refresh<DSARP>::next_event_clk() {
+  return clk + 1;
+}
 /**** End DSARP specialization ****/
 
 } /* namespace ramulator */
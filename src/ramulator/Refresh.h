@@ -104,6 +104,11 @@ public:
     }
   }
 
+  // First clk at which tick_ref() may inject a refresh
+  long next_event_clk() {
+    return refreshed + ctrl->channel->spec->speed_entry.nREFI;
+  }
+
 private:
   // Keeping track of refresh status of every bank: + means ahead of schedule, - means behind schedule
   vector<vector<int>*> bank_refresh_backlog;
@@ -153,6 +158,7 @@ private:
 // where to look for these definitions when controller calls them!
 template<> Refresh<DSARP>::Refresh(Controller<DSARP>* ctrl);
 template<> void Refresh<DSARP>::tick_ref();
+template<> long Refresh<DSARP>::next_event_clk();
 
 } /* namespace ramulator */
 
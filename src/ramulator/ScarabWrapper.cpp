@@ -74,10 +74,26 @@ void ScarabWrapper::tick() {
   mem->tick();
 }
 
+long ScarabWrapper::idle_cycles() {
+  return mem->idle_cycles();
+}
+
+void ScarabWrapper::skip(long cycles) {
+  mem->skip(cycles);
+}
+
+void ScarabWrapper::stop_threads() {
+  mem->stop_threads();
+}
+
 bool ScarabWrapper::send(Request req) {
   return mem->send(req);
 }
 
+void ScarabWrapper::set_output_dir(const string& dir) {
+  Stats::statlist.output(dir + "/ramulator.stat.out");
+}
+
 void ScarabWrapper::finish(void) {
   mem->finish();
   Stats::statlist.printall();
@@ -43,8 +43,12 @@ public:
     ScarabWrapper(const Config& configs, const unsigned int cacheline, void (* stats_callback)(int, int));
     ~ScarabWrapper();
     void tick();
+    long idle_cycles();       // ticks that would only advance the clocks
+    void skip(long cycles);   // same as 'cycles' idle ticks
+    void stop_threads();      // joins the channel threads (before a fork)
     bool send(Request req);
     void finish(void);
+    void set_output_dir(const string& dir);
 
     int get_chip_width() const;
     int get_chip_size()  const;
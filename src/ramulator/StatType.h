@@ -113,6 +113,8 @@ class StatList {
     list.push_back(stat);
   }
   void output(std::string filename) {
+    if (stat_output.is_open())
+      stat_output.close();
     stat_output.open(filename.c_str(), std::ios_base::out);
     if (!stat_output.good()) {
       assert(false && "!stat_output.good()");
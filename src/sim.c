@@ -27,6 +27,7 @@
  ***************************************************************************************/
 
 #include <fcntl.h>
+#include <math.h>
 #include <signal.h>
 #include <stdio.h>
 #include <time.h>
@@ -48,16 +49,21 @@
 
 #include "cmp_model.h"
 #include "debug/memview.h"
+#include "decoupled_frontend.h"
 #include "debug/pipeview.h"
 #include "dumb_model.h"
 #include "frontend/pin_trace_fe.h"
+#include "host_prof.h"
+#include "pc_prof.h"
 #include "model.h"
 #include "optimizer2.h"
 #include "power/power_intf.h"
 #include "stat_trace.h"
+#include "sweep.h"
 #include "trigger.h"
 #include "prefetcher/fdip_new.h"
-#include "prefetcher/eip.h"
+#include "prefetcher/pref_plugin.h"
+#include "memory/memory.h"
 
 #include "bp/bp.param.h"
 #include "core.param.h"
@@ -109,6 +115,10 @@ Counter* period_last_inst_count;
 Counter  period_last_cycle_count = 0;
 /* the global dump counter for periodic dump*/
 Counter  period_ID = 0;
+Flag     simpoint_dump_began = FALSE;
+Counter  simpoint_dump_ID    = 0;
+Flag     mix_dump_began      = FALSE;
+Counter  mix_dump_ID         = 0;
 
 /* the global warmup dump flags */
 Flag*    warmup_dump_done;
@@ -130,7 +140,7 @@ Model* model; /* pointer to the simulator model being used
 
 Thread_Data
              single_td; /* cmp Only For single processor: backward compatibility issue*/
-Thread_Data* td = &single_td; /* array of tds for muti-core, all state
+CORE_LOCAL Thread_Data* td = &single_td; /* array of tds for muti-core, all state
                                  associated with the simulated thread */
 
 /**************************************************************************************/
@@ -148,6 +158,12 @@ static inline double  sim_progress(void);
 static inline void    set_last_sim_param(uns8 proc_id);
 static inline void    print_bogus_sim_param(uns8 proc_id);
 
+static Flag fast_forward(Counter num_insts);
+static void skip_start_insts(void);
+static Flag functional_warming(Counter num_insts);
+static Flag detailed_sim(Counter num_insts);
+static void drain_pipeline(void);
+
 /**************************************************************************************/
 /* handle_SIGINT: this handler is for exiting smoothly when a SIGINT is caught
  */
@@ -567,6 +583,8 @@ void init_global(char* argv[], char* envp[]) {
     init_global_stats(proc_id);
   process_params();
   stat_trace_init();
+  host_prof_init();
+  pc_prof_init();
   if(SIM_MODEL != DUMB_MODEL)
     frontend_init();
   power_intf_init();
@@ -716,12 +734,14 @@ void full_sim() {
 
   /* perform initialization  */
   init_model(WARMUP_MODE);  // make sure this happens before init_op_pool
+  skip_start_insts();
 
   if(WARMUP) {
     operating_mode = WARMUP_MODE;
     uop_sim();
     reset_uop_mode_counters();
     reset_stats(FALSE);  // ignore stats accumulated during warmup
+    pc_prof_reset();
     /* The call below resets the cycle counts of all frequency
        domains but maintains the execution time value. This allows us to:
 
@@ -735,6 +755,13 @@ void full_sim() {
     freq_reset_cycle_counts();
   }
 
+  if(SWEEP_FILE) {
+    if(!sweep_fork())
+      return;  // every sweep point has finished
+    close_output_streams();
+    init_output_streams();  // in the OUTPUT_DIR of the sweep point
+  }
+
   operating_mode = SIMULATION_MODE;
   init_model(operating_mode);
 
@@ -757,7 +784,7 @@ void full_sim() {
       break;
     freq_advance_time();
     sim_time = freq_time();
-    model->cycle_func();
+    HOST_PROF_TIME(HP_CYCLE, model->cycle_func());
     if(SIM_MODEL != DUMB_MODEL && DUMB_CORE_ON)
       model_table[DUMB_MODEL].cycle_func();
 
@@ -773,6 +800,7 @@ void full_sim() {
     check_heartbeat(0, FALSE);
 
     stat_trace_cycle();
+    host_prof_cycle();
     if(trigger_fired(clear_stats)) {
       reset_stats(TRUE);
     }
@@ -796,9 +824,7 @@ void full_sim() {
           INC_STAT_EVENT(proc_id, FDIP_AVG_FTQ_OCCUPANCY_OPS, get_fdip_ftq_occupancy_ops(proc_id));
           INC_STAT_EVENT(proc_id, FDIP_AVG_FTQ_OCCUPANCY, get_fdip_ftq_occupancy(proc_id));
         }
-        if(EIP_ENABLE) {
-          print_eip_stats(proc_id);
-        }
+        pref_plugin_final_stats(proc_id);
         if (PERIODIC_DUMP == FALSE) {
           dump_stats(proc_id, TRUE, global_stat_array[proc_id], NUM_GLOBAL_STATS);
         }
@@ -841,6 +867,8 @@ void full_sim() {
     model_table[DUMB_MODEL].done_func();
 
   stat_trace_done();
+  host_prof_done();
+  pc_prof_done();
   if(PIPEVIEW)
     pipeview_done();
   memview_done();
@@ -864,6 +892,739 @@ void full_sim() {
 }
 
 
+/**************************************************************************************/
+/* fast_forward: Skips num_insts instructions without touching the model.
+   The frontend drops them without generating ops. Returns FALSE if the
+   application ended. */
+
+static Flag fast_forward(Counter num_insts) {
+  if(retired_exit[0])
+    return FALSE;
+  Counter skipped = frontend_skip_insts(0, num_insts);
+  inst_count[0] += skipped;
+  if(skipped < num_insts || !frontend_can_fetch_op(0))
+    retired_exit[0] = TRUE;
+  check_heartbeat(0, FALSE);
+  return !retired_exit[0];
+}
+
+/**************************************************************************************/
+/* skip_start_insts: Skips the first SKIP_INSTS instructions of every core
+   before warmup. They are not counted in inst_count. */
+
+static void skip_start_insts(void) {
+  if(!SKIP_INSTS)
+    return;
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    if(DUMB_CORE_ON && DUMB_CORE == proc_id)
+      continue;
+    Counter skipped = frontend_skip_insts(proc_id, SKIP_INSTS);
+    ASSERTM(proc_id, skipped == SKIP_INSTS && frontend_can_fetch_op(proc_id),
+            "Program ended after %llu of %llu skipped instructions\n",
+            skipped, (Counter)SKIP_INSTS);
+  }
+  fprintf(mystdout, "** Skipped %llu instructions per core\n",
+          (Counter)SKIP_INSTS);
+}
+
+/**************************************************************************************/
+/* functional_warming: Feeds num_insts instructions straight from the
+   frontend to the model's warmup function (caches and branch predictors only,
+   no timing), like the warmup phase of uop_sim. Returns FALSE if the
+   application ended. */
+
+static Flag functional_warming(Counter num_insts) {
+  Op         op;
+  Table_Info table_info;
+  Inst_Info  inst_info;
+  op.table_info = &table_info;
+  op.inst_info  = &inst_info;
+  op.mbp7_info  = NULL;
+
+  Counter target = inst_count[0] + num_insts;
+  operating_mode = WARMUP_MODE;
+  while(inst_count[0] < target && !retired_exit[0]) {
+    do {
+      frontend_fetch_op(0, &op);
+      if(op.eom)
+        inst_count[0]++;
+      if(op.exit)
+        retired_exit[0] = TRUE;
+      model->warmup_func(&op);
+      if(op.eom)
+        frontend_retire(op.proc_id, op.inst_uid);
+    } while(!op.eom);
+    check_heartbeat(0, FALSE);
+
+    // HACK that ensures that cache replacement works in warmup
+    do {
+      freq_advance_time();
+    } while(!freq_is_ready(FREQ_DOMAIN_L1));
+    sim_time = freq_time();
+  }
+  operating_mode = SIMULATION_MODE;
+
+  /* skipped cycles are not a lack of forward progress */
+  cycle_count              = freq_cycle_count(FREQ_DOMAIN_CORES[0]);
+  last_forward_progress[0] = cycle_count;
+  return !retired_exit[0];
+}
+
+/**************************************************************************************/
+/* detailed_sim: Runs the timing model until num_insts more instructions
+   have retired. Returns FALSE if the application ended. */
+
+static Flag detailed_sim(Counter num_insts) {
+  Counter target = inst_count[0] + num_insts;
+  while(inst_count[0] < target && !retired_exit[0]) {
+    freq_advance_time();
+    sim_time = freq_time();
+    HOST_PROF_TIME(HP_CYCLE, model->cycle_func());
+    cycle_count = freq_cycle_count(FREQ_DOMAIN_CORES[0]);
+    check_heartbeat(0, FALSE);
+    stat_trace_cycle();
+    host_prof_cycle();
+    if(cycle_count % FORWARD_PROGRESS_INTERVAL == 0)
+      check_forward_progress(0);
+  }
+  return !retired_exit[0];
+}
+
+/**************************************************************************************/
+/* drain_pipeline: Stops fetch on all cores at the next fetch target boundary
+   and cycles the model until no op or memory request is in flight, so that the
+   pipeline can be reset and the frontend handed to functional warming (or a
+   new trace) at an instruction boundary. The trace frontends cannot rewind, so
+   wrong-path work is drained rather than squashed. */
+
+static Flag pipeline_busy(void) {
+  if(op_pool_active_ops || mem->req_count)
+    return TRUE;
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    Bp_Recovery_Info* info = &cmp_model.bp_recovery_info[proc_id];
+    if(info->recovery_cycle != MAX_CTR || info->redirect_cycle != MAX_CTR)
+      return TRUE;
+  }
+  return FALSE;
+}
+
+static void drain_pipeline(void) {
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++)
+    decoupled_fe_set_fetch_gated(proc_id, TRUE);
+  while(pipeline_busy()) {
+    freq_advance_time();
+    sim_time = freq_time();
+    model->cycle_func();
+    cycle_count = freq_cycle_count(FREQ_DOMAIN_CORES[0]);
+    if(cycle_count % FORWARD_PROGRESS_INTERVAL == 0)
+      check_forward_progress(0);
+  }
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++)
+    decoupled_fe_set_fetch_gated(proc_id, FALSE);
+  model->reset_func();
+}
+
+/**************************************************************************************/
+/* sampling_sim: Systematic sampling (SMARTS). The run is divided into units of
+   SAMPLE_PERIOD instructions. Each unit is functionally warmed, except for the
+   last SAMPLE_DETAILED_WARMUP + SAMPLE_SIZE instructions, which are simulated in
+   detail; only the final SAMPLE_SIZE instructions are measured. The stats files
+   accumulate only the measured windows. Per-sample results go to the
+   "sampling" file, and the CPI estimate with its 95% confidence interval is
+   printed at the end. */
+
+void sampling_sim() {
+  ASSERTM(0, NUM_CORES == 1, "Sampling mode supports only a single core\n");
+  ASSERTM(0, SIM_MODEL == CMP_MODEL && !DUMB_CORE_ON,
+          "Sampling mode requires the cmp model\n");
+  ASSERTM(0, SAMPLE_SIZE > 0 &&
+               SAMPLE_PERIOD >= SAMPLE_DETAILED_WARMUP + SAMPLE_SIZE,
+          "SAMPLE_PERIOD must cover SAMPLE_DETAILED_WARMUP + SAMPLE_SIZE\n");
+  ASSERTM(0, !strcmp(SIM_LIMIT, "none"),
+          "SIM_LIMIT does not work in sampling mode\n");
+
+  init_model(WARMUP_MODE);  // make sure this happens before init_op_pool
+  skip_start_insts();
+
+  if(WARMUP) {
+    operating_mode = WARMUP_MODE;
+    uop_sim();
+    reset_uop_mode_counters();
+    freq_reset_cycle_counts();
+  }
+
+  operating_mode = SIMULATION_MODE;
+  init_model(operating_mode);
+  init_op_pool();
+  unique_count = 1;
+  clear_stat_counts(FALSE);
+
+  FILE* sample_file = file_tag_fopen(OUTPUT_DIR, "sampling", "w");
+  ASSERTM(0, sample_file, "Could not open sampling output file\n");
+  fprintf(sample_file, "%-8s %-14s %-10s %-10s %s\n", "sample", "start_inst",
+          "insts", "cycles", "cpi");
+
+  Counter num_samples = 0;
+  double  cpi_sum     = 0.0;
+  double  cpi_sum_sq  = 0.0;
+  Counter unit_start  = inst_count[0];
+
+  while(!(INST_LIMIT && inst_count[0] >= inst_limit[0])) {
+    pc_prof_pause();
+    /* functional warming absorbs the overshoot of the previous detailed window */
+    Counter detailed_start = unit_start + SAMPLE_PERIOD - SAMPLE_DETAILED_WARMUP -
+                             SAMPLE_SIZE;
+    if(detailed_start > inst_count[0] &&
+       !functional_warming(detailed_start - inst_count[0]))
+      break;
+    if(!detailed_sim(SAMPLE_DETAILED_WARMUP))
+      break;
+
+    clear_stat_counts(FALSE);  // drop everything since the last window
+    pc_prof_resume();
+    Counter start_inst  = inst_count[0];
+    Counter start_cycle = cycle_count;
+    Flag    more        = detailed_sim(SAMPLE_SIZE);
+    Counter insts       = inst_count[0] - start_inst;
+    Counter cycles      = cycle_count - start_cycle;
+    clear_stat_counts(TRUE);  // move the window into the totals
+
+    if(insts >= SAMPLE_SIZE) {  // only complete windows enter the estimate
+      double cpi = (double)cycles / insts;
+      cpi_sum += cpi;
+      cpi_sum_sq += cpi * cpi;
+      fprintf(sample_file, "%-8llu %-14llu %-10llu %-10llu %.4f\n",
+              num_samples, start_inst, insts, cycles, cpi);
+      num_samples++;
+    }
+    if(!more)
+      break;
+
+    drain_pipeline();
+    unit_start += SAMPLE_PERIOD;
+  }
+  fclose(sample_file);
+
+  if(model->done_func)
+    model->done_func();
+  stat_trace_done();
+  host_prof_done();
+  pc_prof_done();
+  memview_done();
+  power_intf_done();
+  frontend_done(retired_exit);
+  ramulator_finish();
+
+  sim_done[0] = TRUE;
+  dump_stats(0, TRUE, global_stat_array[0], NUM_GLOBAL_STATS);
+  check_heartbeat(0, TRUE);
+
+  if(num_samples) {
+    double mean = cpi_sum / num_samples;
+    double var  = num_samples > 1 ?
+                   (cpi_sum_sq - num_samples * mean * mean) / (num_samples - 1) :
+                   0.0;
+    double stddev = var > 0.0 ? sqrt(var) : 0.0;
+    double ci     = 1.96 * stddev / sqrt((double)num_samples);
+    fprintf(mystdout,
+            "** Sampling: %llu samples  CPI %.4f +- %.4f (95%% conf, %.2f%%)  "
+            "IPC %.4f  CoV %.3f\n",
+            num_samples, mean, ci, 100.0 * ci / mean, 1.0 / mean,
+            stddev / mean);
+  } else {
+    fprintf(mystdout, "** Sampling: no complete samples\n");
+  }
+}
+
+
+/**************************************************************************************/
+/* simpoint_sim: Simulates all SimPoint regions of one application in a single
+   run. Regions are visited in trace order: the frontend is fast-forwarded to
+   SIMPOINT_WARMUP instructions before each region, functionally warmed up to
+   the region start and then SIMPOINT_INTERVAL instructions are simulated in
+   detail. Each region dumps its own stat files (".simpoint.<cluster>"
+   suffix); the final, unsuffixed stat files hold the weighted average of the
+   regions, normalized to one interval. */
+
+typedef struct Simpoint_Region_struct {
+  Counter interval;
+  Counter cluster;
+  double  weight;
+} Simpoint_Region;
+
+static int simpoint_region_cmp(const void* a, const void* b) {
+  const Simpoint_Region* ra = (const Simpoint_Region*)a;
+  const Simpoint_Region* rb = (const Simpoint_Region*)b;
+  return ra->interval < rb->interval ? -1 : ra->interval > rb->interval;
+}
+
+static uns simpoint_read_regions(Simpoint_Region** regions) {
+  FILE* file = fopen(SIMPOINT_FILE, "r");
+  ASSERTUM(0, file, "Could not open simpoint file '%s'\n", SIMPOINT_FILE);
+  uns                num     = 0;
+  uns                max_num = 16;
+  Simpoint_Region*   r       = (Simpoint_Region*)malloc(sizeof(Simpoint_Region) * max_num);
+  unsigned long long interval, cluster;
+  while(fscanf(file, "%llu %llu", &interval, &cluster) == 2) {
+    if(num == max_num) {
+      max_num *= 2;
+      r = (Simpoint_Region*)realloc(r, sizeof(Simpoint_Region) * max_num);
+    }
+    r[num].interval = interval;
+    r[num].cluster  = cluster;
+    r[num].weight   = -1.0;
+    num++;
+  }
+  fclose(file);
+  ASSERTUM(0, num, "No regions in simpoint file '%s'\n", SIMPOINT_FILE);
+
+  file = fopen(SIMPOINT_WEIGHTS_FILE, "r");
+  ASSERTUM(0, file, "Could not open simpoint weights file '%s'\n",
+           SIMPOINT_WEIGHTS_FILE);
+  double weight;
+  while(fscanf(file, "%lf %llu", &weight, &cluster) == 2) {
+    for(uns ii = 0; ii < num; ii++)
+      if(r[ii].cluster == cluster)
+        r[ii].weight = weight;
+  }
+  fclose(file);
+
+  for(uns ii = 0; ii < num; ii++)
+    ASSERTUM(0, r[ii].weight >= 0.0, "No weight for simpoint cluster %llu\n",
+             r[ii].cluster);
+  qsort(r, num, sizeof(Simpoint_Region), simpoint_region_cmp);
+  *regions = r;
+  return num;
+}
+
+void simpoint_sim() {
+  ASSERTM(0, NUM_CORES == 1, "SimPoint mode supports only a single core\n");
+  ASSERTM(0, SIM_MODEL == CMP_MODEL && !DUMB_CORE_ON,
+          "SimPoint mode requires the cmp model\n");
+  ASSERTM(0, SIMPOINT_FILE && SIMPOINT_WEIGHTS_FILE,
+          "SimPoint mode requires SIMPOINT_FILE and SIMPOINT_WEIGHTS_FILE\n");
+  ASSERTM(0, !WARMUP && !PERIODIC_DUMP && !strcmp(SIM_LIMIT, "none"),
+          "WARMUP, PERIODIC_DUMP and SIM_LIMIT do not work in SimPoint mode\n");
+
+  Simpoint_Region* regions;
+  uns              num_regions = simpoint_read_regions(&regions);
+  double* weighted = (double*)calloc(NUM_GLOBAL_STATS, sizeof(double));
+  double  total_weight = 0.0, weighted_cycles = 0.0, weighted_insts = 0.0,
+         weighted_cpi = 0.0;
+
+  init_model(WARMUP_MODE);  // make sure this happens before init_op_pool
+  operating_mode = SIMULATION_MODE;
+  init_model(operating_mode);
+  init_op_pool();
+  unique_count = 1;
+
+  FILE* summary_file = file_tag_fopen(OUTPUT_DIR, "simpoint", "w");
+  ASSERTM(0, summary_file, "Could not open simpoint output file\n");
+  fprintf(summary_file, "%-8s %-10s %-8s %-14s %-10s %s\n", "cluster",
+          "interval", "weight", "insts", "cycles", "ipc");
+
+  for(uns ii = 0; ii < num_regions; ii++) {
+    Simpoint_Region* r     = &regions[ii];
+    Counter          start = r->interval * SIMPOINT_INTERVAL;
+    Counter warm_start = start > SIMPOINT_WARMUP ? start - SIMPOINT_WARMUP : 0;
+
+    pc_prof_pause();
+    /* the previous region may end a few instructions late */
+    if(warm_start > inst_count[0] && !fast_forward(warm_start - inst_count[0]))
+      break;
+    if(start > inst_count[0] && !functional_warming(start - inst_count[0]))
+      break;
+
+    clear_stat_counts(FALSE);
+    pc_prof_resume();
+    period_last_cycle_count   = cycle_count;
+    period_last_inst_count[0] = inst_count[0];
+    Counter start_inst        = inst_count[0];
+    Counter start_cycle       = cycle_count;
+    Flag    more              = detailed_sim(SIMPOINT_INTERVAL);
+    Counter insts             = inst_count[0] - start_inst;
+    Counter cycles            = cycle_count - start_cycle;
+
+    /* dump_stats() clears the interval counts, so weigh them first */
+    if(insts) {
+      sync_stats();
+      for(uns jj = 0; jj < NUM_GLOBAL_STATS; jj++) {
+        Stat* stat = &global_stat_array[0][jj];
+        weighted[jj] += r->weight * (stat->type == FLOAT_TYPE_STAT ?
+                                       stat->value :
+                                       (double)stat->count);
+      }
+    }
+
+    simpoint_dump_began = TRUE;
+    simpoint_dump_ID    = r->cluster;
+    dump_stats(0, TRUE, global_stat_array[0], NUM_GLOBAL_STATS);
+    simpoint_dump_began = FALSE;
+
+    if(insts) {
+      total_weight += r->weight;
+      weighted_cycles += r->weight * cycles;
+      weighted_insts += r->weight * insts;
+      weighted_cpi += r->weight * cycles / insts;
+      fprintf(summary_file, "%-8llu %-10llu %-8.5f %-14llu %-10llu %.5f\n",
+              r->cluster, r->interval, r->weight, insts, cycles,
+              (double)insts / cycles);
+      fprintf(mystdout,
+              "** SimPoint region %u/%u: cluster %llu  insts %llu  cycles %llu  "
+              "IPC %.4f\n",
+              ii + 1, num_regions, r->cluster, insts, cycles,
+              (double)insts / cycles);
+    }
+    if(!more)
+      break;
+    drain_pipeline();
+  }
+
+  if(model->done_func)
+    model->done_func();
+  stat_trace_done();
+  host_prof_done();
+  pc_prof_done();
+  memview_done();
+  power_intf_done();
+  frontend_done(retired_exit);
+  ramulator_finish();
+  sim_done[0] = TRUE;
+  check_heartbeat(0, TRUE);
+
+  if(total_weight > 0.0) {
+    fprintf(summary_file, "weighted CPI %.5f  IPC %.5f\n",
+            weighted_cpi / total_weight, total_weight / weighted_cpi);
+    fprintf(mystdout, "** SimPoint: %u regions  weighted CPI %.4f  IPC %.4f\n",
+            num_regions, weighted_cpi / total_weight,
+            total_weight / weighted_cpi);
+
+    /* The unsuffixed stat files hold the weighted region average. The
+       simulation is over, so the global counters are overwritten to make the
+       file headers and per-instruction ratios refer to that average. */
+    sync_stats();
+    for(uns jj = 0; jj < NUM_GLOBAL_STATS; jj++) {
+      Stat* stat = stat_touch(0, jj);
+      if(stat->type == FLOAT_TYPE_STAT) {
+        stat->value       = weighted[jj] / total_weight;
+        stat->total_value = 0.0;
+      } else {
+        stat->count       = (Counter)(weighted[jj] / total_weight + 0.5);
+        stat->total_count = 0;
+      }
+    }
+    cycle_count               = (Counter)(weighted_cycles / total_weight + 0.5);
+    inst_count[0]             = (Counter)(weighted_insts / total_weight + 0.5);
+    period_last_cycle_count   = 0;
+    period_last_inst_count[0] = 0;
+    dump_stats(0, TRUE, global_stat_array[0], NUM_GLOBAL_STATS);
+  }
+  fclose(summary_file);
+  free(weighted);
+  free(regions);
+}
+
+
+/**************************************************************************************/
+/* mix_sim: Workload-mix co-simulation. Runs every mix of MIX_FILE back to back
+   in one simulator instance: between mixes the pipelines are drained and reset
+   and each core is handed its new trace (cores without a trace stay idle).
+   Each core is warmed up for MIX_WARMUP instructions and measured until it has
+   retired MIX_INSTS instructions; cores that finish early keep running so the
+   others still see their contention, and traces that end are restarted. The
+   weighted and harmonic speedups of each mix over the single-core IPCs of its
+   traces go to the "mix" file. Single-core IPCs are read from
+   MIX_BASELINE_FILE; missing ones are measured first on core 0 with the other
+   cores idle and appended to it. With MIX_DUMP_STATS, each mix dumps its own
+   stat files (".mix.<n>" suffix, covering the mix until its last core is
+   done); the final, unsuffixed stat files hold the totals over all mixes. */
+
+#define MIX_NAME_LENGTH 256
+
+typedef struct Mix_Trace_struct {
+  char   name[MIX_NAME_LENGTH];
+  char   path[MAX_STR_LENGTH];
+  double alone_ipc; /* negative until known */
+} Mix_Trace;
+
+typedef struct Mix_struct {
+  char name[MIX_NAME_LENGTH];
+  uns  num_traces;
+  uns  traces[MAX_NUM_PROCS]; /* indices into the trace pool, one per core */
+} Mix;
+
+static uns mix_find_trace(Mix_Trace* pool, uns num_pool, const char* name) {
+  for(uns ii = 0; ii < num_pool; ii++)
+    if(!strcmp(pool[ii].name, name))
+      return ii;
+  return num_pool;
+}
+
+static uns mix_read_pool(Mix_Trace** pool) {
+  FILE* file = fopen(MIX_POOL_FILE, "r");
+  ASSERTUM(0, file, "Could not open mix pool file '%s'\n", MIX_POOL_FILE);
+  uns        num     = 0;
+  uns        max_num = 16;
+  Mix_Trace* p       = (Mix_Trace*)malloc(sizeof(Mix_Trace) * max_num);
+  char       name[MIX_NAME_LENGTH], path[MAX_STR_LENGTH];
+  while(fscanf(file, "%255s %1023s", name, path) == 2) {
+    ASSERTUM(0, mix_find_trace(p, num, name) == num,
+             "Trace '%s' is defined twice in '%s'\n", name, MIX_POOL_FILE);
+    if(num == max_num) {
+      max_num *= 2;
+      p = (Mix_Trace*)realloc(p, sizeof(Mix_Trace) * max_num);
+    }
+    strcpy(p[num].name, name);
+    strcpy(p[num].path, path);
+    p[num].alone_ipc = -1.0;
+    num++;
+  }
+  fclose(file);
+  ASSERTUM(0, num, "No traces in mix pool file '%s'\n", MIX_POOL_FILE);
+  *pool = p;
+  return num;
+}
+
+static uns mix_read_mixes(Mix** mixes, Mix_Trace* pool, uns num_pool) {
+  FILE* file = fopen(MIX_FILE, "r");
+  ASSERTUM(0, file, "Could not open mix file '%s'\n", MIX_FILE);
+  uns  num     = 0;
+  uns  max_num = 16;
+  Mix* m       = (Mix*)malloc(sizeof(Mix) * max_num);
+  char line[MAX_STR_LENGTH * 4];
+  while(fgets(line, sizeof(line), file)) {
+    char* token = strtok(line, " \t\r\n");
+    if(!token || token[0] == '#')
+      continue;
+    if(num == max_num) {
+      max_num *= 2;
+      m = (Mix*)realloc(m, sizeof(Mix) * max_num);
+    }
+    Mix* mix = &m[num];
+    snprintf(mix->name, MIX_NAME_LENGTH, "%s", token);
+    mix->num_traces = 0;
+    while((token = strtok(NULL, " \t\r\n"))) {
+      ASSERTUM(0, mix->num_traces < NUM_CORES,
+               "Mix '%s' has more traces than the %u cores\n", mix->name,
+               NUM_CORES);
+      uns trace = mix_find_trace(pool, num_pool, token);
+      ASSERTUM(0, trace < num_pool, "Mix '%s': trace '%s' is not in '%s'\n",
+               mix->name, token, MIX_POOL_FILE);
+      mix->traces[mix->num_traces++] = trace;
+    }
+    ASSERTUM(0, mix->num_traces, "Mix '%s' has no traces\n", mix->name);
+    num++;
+  }
+  fclose(file);
+  ASSERTUM(0, num, "No mixes in mix file '%s'\n", MIX_FILE);
+  *mixes = m;
+  return num;
+}
+
+static void mix_read_baselines(Mix_Trace* pool, uns num_pool) {
+  if(!MIX_BASELINE_FILE)
+    return;
+  FILE* file = fopen(MIX_BASELINE_FILE, "r");
+  if(!file)  // nothing cached yet
+    return;
+  char   name[MIX_NAME_LENGTH];
+  double ipc;
+  while(fscanf(file, "%255s %lf", name, &ipc) == 2) {
+    uns trace = mix_find_trace(pool, num_pool, name);
+    if(trace < num_pool && ipc > 0.0)
+      pool[trace].alone_ipc = ipc;
+  }
+  fclose(file);
+}
+
+/* mix_cycle: one cycle of all cores, restarting the traces that ended */
+static void mix_cycle(Flag* active) {
+  freq_advance_time();
+  sim_time = freq_time();
+  HOST_PROF_TIME(HP_CYCLE, model->cycle_func());
+  cycle_count = freq_cycle_count(FREQ_DOMAIN_CORES[0]);
+  check_heartbeat(0, FALSE);
+  stat_trace_cycle();
+  host_prof_cycle();
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    if(!active[proc_id])
+      continue;
+    if(retired_exit[proc_id])
+      cmp_init_bogus_sim(proc_id);
+    if(cycle_count % FORWARD_PROGRESS_INTERVAL == 0)
+      check_forward_progress(proc_id);
+  }
+}
+
+/* mix_run: Runs the traces in paths (NULL for an idle core) and returns the
+   IPC of every active core in ipc. Mixes (but not baselines) pass dump
+   to dump their stat files with the given ID. */
+static void mix_run(const char** paths, double* ipc, Flag dump, Counter dump_id) {
+  static Flag first_run = TRUE;
+  Flag        active[MAX_NUM_PROCS];
+  Counter     start_inst[MAX_NUM_PROCS], start_cycle[MAX_NUM_PROCS];
+  Flag        all_done;
+
+  if(!first_run)
+    drain_pipeline();
+  first_run = FALSE;
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    active[proc_id] = paths[proc_id] != NULL;
+    trace_switch(proc_id, paths[proc_id]);
+    decoupled_fe_set_fetch_gated(proc_id, !active[proc_id]);
+    start_inst[proc_id]            = inst_count[proc_id];
+    last_forward_progress[proc_id] = cycle_count;
+    last_uop_count[proc_id]        = uop_count[proc_id];
+  }
+
+  pc_prof_pause();
+  do {
+    mix_cycle(active);
+    all_done = TRUE;
+    for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++)
+      if(active[proc_id] && inst_count[proc_id] - start_inst[proc_id] < MIX_WARMUP)
+        all_done = FALSE;
+  } while(!all_done);
+
+  clear_stat_counts(FALSE);
+  pc_prof_resume();
+  period_last_cycle_count = cycle_count;
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    start_inst[proc_id]             = inst_count[proc_id];
+    start_cycle[proc_id]            = freq_cycle_count(FREQ_DOMAIN_CORES[proc_id]);
+    period_last_inst_count[proc_id] = inst_count[proc_id];
+    ipc[proc_id]                    = -1.0;  // not done yet
+  }
+
+  do {
+    mix_cycle(active);
+    all_done = TRUE;
+    for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+      if(!active[proc_id] || ipc[proc_id] >= 0.0)
+        continue;
+      if(inst_count[proc_id] - start_inst[proc_id] >= MIX_INSTS) {
+        Counter cycles = freq_cycle_count(FREQ_DOMAIN_CORES[proc_id]) -
+                         start_cycle[proc_id];
+        ipc[proc_id] = (double)(inst_count[proc_id] - start_inst[proc_id]) /
+                       cycles;
+      } else {
+        all_done = FALSE;
+      }
+    }
+  } while(!all_done);
+
+  if(dump) {
+    mix_dump_began = TRUE;
+    mix_dump_ID    = dump_id;
+    for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++)
+      if(active[proc_id])
+        dump_stats(proc_id, TRUE, global_stat_array[proc_id],
+                   NUM_GLOBAL_STATS);
+    mix_dump_began = FALSE;
+    clear_stat_counts(FALSE);  // the dump moved the counts into the totals
+  } else {
+    clear_stat_counts(TRUE);
+  }
+}
+
+void mix_sim() {
+  ASSERTM(0, FRONTEND == FE_TRACE, "Mix mode requires the trace frontend\n");
+  ASSERTM(0, SIM_MODEL == CMP_MODEL && !DUMB_CORE_ON,
+          "Mix mode requires the cmp model\n");
+  ASSERTM(0, MIX_POOL_FILE && MIX_FILE,
+          "Mix mode requires MIX_POOL_FILE and MIX_FILE\n");
+  ASSERTM(0, MIX_INSTS > 0, "MIX_INSTS must be positive\n");
+  ASSERTM(0, !WARMUP && !PERIODIC_DUMP && !strcmp(SIM_LIMIT, "none"),
+          "WARMUP, PERIODIC_DUMP and SIM_LIMIT do not work in mix mode\n");
+
+  Mix_Trace* pool;
+  Mix*       mixes;
+  uns        num_pool  = mix_read_pool(&pool);
+  uns        num_mixes = mix_read_mixes(&mixes, pool, num_pool);
+  mix_read_baselines(pool, num_pool);
+
+  init_model(WARMUP_MODE);  // make sure this happens before init_op_pool
+  operating_mode = SIMULATION_MODE;
+  init_model(operating_mode);
+  init_op_pool();
+  unique_count = 1;
+
+  const char* paths[MAX_NUM_PROCS];
+  double      ipc[MAX_NUM_PROCS];
+
+  /* single-core baselines of the traces used by the mixes */
+  for(uns ii = 0; ii < num_mixes; ii++) {
+    for(uns jj = 0; jj < mixes[ii].num_traces; jj++) {
+      Mix_Trace* trace = &pool[mixes[ii].traces[jj]];
+      if(trace->alone_ipc >= 0.0)
+        continue;
+      memset(paths, 0, sizeof(paths));
+      paths[0] = trace->path;
+      mix_run(paths, ipc, FALSE, 0);
+      trace->alone_ipc = ipc[0];
+      fprintf(mystdout, "** Mix baseline %s: IPC %.4f\n", trace->name,
+              trace->alone_ipc);
+      if(MIX_BASELINE_FILE) {
+        FILE* file = fopen(MIX_BASELINE_FILE, "a");
+        ASSERTUM(0, file, "Could not open mix baseline file '%s'\n",
+                 MIX_BASELINE_FILE);
+        fprintf(file, "%s %.6f\n", trace->name, trace->alone_ipc);
+        fclose(file);
+      }
+    }
+  }
+
+  FILE* mix_file = file_tag_fopen(OUTPUT_DIR, "mix", "w");
+  ASSERTM(0, mix_file, "Could not open mix output file\n");
+  fprintf(mix_file, "%-6s %-24s %-10s %-10s %s\n", "id", "mix",
+          "ws", "hs", "ipc_shared/ipc_alone per core");
+
+  for(uns ii = 0; ii < num_mixes; ii++) {
+    Mix* mix = &mixes[ii];
+    memset(paths, 0, sizeof(paths));
+    for(uns jj = 0; jj < mix->num_traces; jj++)
+      paths[jj] = pool[mix->traces[jj]].path;
+    mix_run(paths, ipc, MIX_DUMP_STATS, ii);
+
+    double ws = 0.0, inv_speedup_sum = 0.0;
+    fprintf(mix_file, "%-6u %-24s", ii, mix->name);
+    for(uns jj = 0; jj < mix->num_traces; jj++) {
+      double alone = pool[mix->traces[jj]].alone_ipc;
+      ws += ipc[jj] / alone;
+      inv_speedup_sum += alone / ipc[jj];
+    }
+    double hs = mix->num_traces / inv_speedup_sum;
+    fprintf(mix_file, " %-10.5f %-10.5f", ws, hs);
+    for(uns jj = 0; jj < mix->num_traces; jj++)
+      fprintf(mix_file, " %.4f/%.4f", ipc[jj],
+              pool[mix->traces[jj]].alone_ipc);
+    fprintf(mix_file, "\n");
+    fflush(mix_file);
+    fprintf(mystdout, "** Mix %u/%u %s: weighted speedup %.4f  harmonic speedup %.4f\n",
+            ii + 1, num_mixes, mix->name, ws, hs);
+  }
+  fclose(mix_file);
+
+  if(model->done_func)
+    model->done_func();
+  stat_trace_done();
+  host_prof_done();
+  pc_prof_done();
+  memview_done();
+  power_intf_done();
+  frontend_done(retired_exit);
+  ramulator_finish();
+
+  for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    sim_done[proc_id] = TRUE;
+    dump_stats(proc_id, TRUE, global_stat_array[proc_id], NUM_GLOBAL_STATS);
+  }
+  check_heartbeat(0, TRUE);
+  free(mixes);
+  free(pool);
+}
+
+
 /**************************************************************************************/
 #ifdef ENABLE_PT_MEMTRACE
 /* trace_bbv: This is the main loop for extracting basic block vectors from the trace.*/
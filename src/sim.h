@@ -35,6 +35,9 @@
 enum sim_mode_enum {
   UOP_SIM_MODE,
   FULL_SIM_MODE,
+  SAMPLE_SIM_MODE,
+  SIMPOINT_SIM_MODE,
+  MIX_SIM_MODE,
 #ifdef ENABLE_PT_MEMTRACE
   TRACE_BBV_MODE,
   TRACE_BBV_DISTRIBUTED_MODE,
@@ -63,6 +66,8 @@ void init_global(char* [], char* []);
 void uop_sim(void);
 void monitor_sim(void);
 void sampling_sim(void);
+void simpoint_sim(void);
+void mix_sim(void);
 void full_sim(void);
 void handle_SIGINT(int);
 void close_output_streams(void);
@@ -96,6 +96,7 @@ Stat_Mon* stat_mon_create_from_range(uns first_stat_idx, uns last_stat_idx) {
 Counter stat_mon_get_count(Stat_Mon* mon, uns proc_id, uns stat_idx) {
   ASSERT(0, proc_id < NUM_CORES);
   ASSERT(proc_id, stat_idx < NUM_GLOBAL_STATS);
+  sync_stats();
   Stat* stat = &global_stat_array[proc_id][stat_idx];
   ASSERT(proc_id, stat->type != FLOAT_TYPE_STAT);
   Stat_Info* info = find_stat_info(mon, stat_idx);
@@ -108,6 +109,7 @@ Counter stat_mon_get_count(Stat_Mon* mon, uns proc_id, uns stat_idx) {
 double stat_mon_get_value(Stat_Mon* mon, uns proc_id, uns stat_idx) {
   ASSERT(0, proc_id < NUM_CORES);
   ASSERT(proc_id, stat_idx < NUM_GLOBAL_STATS);
+  sync_stats();
   Stat* stat = &global_stat_array[proc_id][stat_idx];
   ASSERT(proc_id, stat->type == FLOAT_TYPE_STAT);
   Stat_Info* info = find_stat_info(mon, stat_idx);
@@ -123,6 +125,7 @@ double stat_mon_get_value(Stat_Mon* mon, uns proc_id, uns stat_idx) {
  * @param mon
  */
 void stat_mon_reset(Stat_Mon* mon) {
+  sync_stats();
   for(uns i = 0; i < mon->num_stats; i++) {
     Stat_Info* info = &mon->stat_infos[i];
     for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
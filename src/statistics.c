@@ -46,7 +46,7 @@ working on this (ob).
 /* Global Variables */
 
 #define DEF_STAT(name, type, ratio) \
-  {type##_TYPE_STAT, #name, {0}, {0}, ratio, __FILE__, FALSE},
+  {type##_TYPE_STAT, #name, {0}, {0}, ratio, __FILE__, FALSE, FALSE},
 
 Stat global_stat_sample[] = {
 #include "stat_files.def"
@@ -54,7 +54,94 @@ Stat global_stat_sample[] = {
 
 #undef DEF_STAT
 
-Stat** global_stat_array;
+Stat**           global_stat_array;
+Stat_Dirty_List* stat_dirty_lists;
+
+/**************************************************************************************/
+/* Stat shards
+
+   Increments that are not written to global_stat_array directly wait in a
+   Stat_Shard until sync_stats() adds them. uncore_stat_shard holds the _ALL
+   events, which used to be added to every core at every event. With
+   STAT_SHARDS, every simulation thread also gets its own shard on its first
+   event; shards are pushed on stat_shards without locking and are only read
+   by sync_stats(), which must run while the other threads are stopped (e.g.
+   at the end of a cycle). */
+
+Stat_Shard uncore_stat_shard;
+#ifdef STAT_SHARDS
+CORE_LOCAL Stat_Shard* thread_stat_shard = NULL;
+#endif
+static Stat_Shard* stat_shards = NULL;
+
+static void init_stat_shard(Stat_Shard* shard, uns num_rows);
+
+/**************************************************************************************/
+/* Binary stat dump
+
+   When DUMP_STATS_BINARY is set, every call to dump_stats() also appends one
+   fixed-size record to a single per-run file (OUTPUT_DIR/FILE_TAG +
+   STATS_BINARY_FILE). All cores and all intervals (periodic, warmup, roi,
+   final) end up in the same file, so the records can be mapped directly as a
+   2-D array by the analysis scripts (see bin/scarab_globals/scarab_stats.py).
+
+   Layout (little endian, everything 8-byte aligned):
+     Stat_Bin_Header
+     names  : NUL-separated stat names, in Stat_Enum order
+     files  : NUL-separated stat file names (e.g. "core.stat."), same order
+     types  : one uns8 Stat_Type per stat
+     records: Stat_Bin_Record followed by uns64 count[num_stats] and
+              uns64 total[num_stats]. FLOAT_TYPE_STAT slots hold the raw bits
+              of the double.
+
+   With STATS_BINARY_SPARSE (version 2, record_size 0), a record is instead
+   followed by uns64 num_entries and that many Stat_Bin_Entry, one per stat
+   that changed since the previous record of the core. Stats without an entry
+   have a zero count and the total of the previous record, so the size of a
+   record follows the number of stats touched in the interval. */
+
+#define STAT_BIN_MAGIC "SCARABST"
+#define STAT_BIN_VERSION 1
+#define STAT_BIN_SPARSE_VERSION 2
+#define STAT_BIN_ALIGN(x) (((x) + 7) & ~((uns64)7))
+
+#define STAT_BIN_WARMUP 0x1
+#define STAT_BIN_PERIODIC 0x2
+#define STAT_BIN_ROI 0x4
+#define STAT_BIN_SIMPOINT 0x8
+#define STAT_BIN_MIX 0x10
+
+typedef struct Stat_Bin_Header_struct {
+  char  magic[8];
+  uns32 version;
+  uns32 num_cores;
+  uns32 num_stats;
+  uns32 record_size;
+  uns64 names_offset;
+  uns64 names_size;
+  uns64 files_offset;
+  uns64 files_size;
+  uns64 types_offset;
+  uns64 data_offset;
+} Stat_Bin_Header;
+
+typedef struct Stat_Bin_Record_struct {
+  uns32 proc_id;
+  uns32 flags;
+  uns64 interval_id;
+  uns64 cycle_count;
+  uns64 inst_count;
+} Stat_Bin_Record;
+
+typedef struct Stat_Bin_Entry_struct {
+  uns64 idx;
+  uns64 count;
+  uns64 total;
+} Stat_Bin_Entry;
+
+static FILE*  stat_bin_stream = NULL;
+static uns64* stat_bin_buf    = NULL;
+static uns    stat_bin_size   = 0;
 
 /**************************************************************************************/
 // init_global_stats_array:
@@ -79,6 +166,80 @@ void init_global_stats_array() {
     memcpy(global_stat_array[ii], global_stat_sample,
            NUM_GLOBAL_STATS * sizeof(Stat));
   }
+
+  stat_dirty_lists = (Stat_Dirty_List*)malloc(NUM_CORES *
+                                              sizeof(Stat_Dirty_List));
+  for(ii = 0; ii < NUM_CORES; ii++) {
+    stat_dirty_lists[ii].idx = (uns*)malloc(NUM_GLOBAL_STATS * sizeof(uns));
+    stat_dirty_lists[ii].num = 0;
+  }
+
+  init_stat_shard(&uncore_stat_shard, 1);
+}
+
+/**************************************************************************************/
+/* init_stat_shard: row 0 is the uncore row, row 1 + proc_id the row of a core */
+
+static void init_stat_shard(Stat_Shard* shard, uns num_rows) {
+  shard->deltas    = (Stat_Delta*)calloc(num_rows * NUM_GLOBAL_STATS,
+                                      sizeof(Stat_Delta));
+  shard->dirty     = (uns*)malloc(num_rows * NUM_GLOBAL_STATS * sizeof(uns));
+  shard->num_dirty = 0;
+
+  shard->next = __atomic_load_n(&stat_shards, __ATOMIC_RELAXED);
+  while(!__atomic_compare_exchange_n(&stat_shards, &shard->next, shard, TRUE,
+                                     __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    ;
+}
+
+/**************************************************************************************/
+/* new_stat_shard: creates the shard of the calling thread */
+
+Stat_Shard* new_stat_shard(void) {
+#ifdef STAT_SHARDS
+  ASSERT(0, !thread_stat_shard);
+  thread_stat_shard = (Stat_Shard*)malloc(sizeof(Stat_Shard));
+  init_stat_shard(thread_stat_shard, NUM_CORES + 1);
+  return thread_stat_shard;
+#else
+  return &uncore_stat_shard;
+#endif
+}
+
+/**************************************************************************************/
+/* merge_stat_delta: */
+
+static inline void merge_stat_delta(uns proc_id, uns idx,
+                                    const Stat_Delta* delta) {
+  Stat* stat = stat_touch(proc_id, idx);
+  if(stat->type == FLOAT_TYPE_STAT)
+    stat->value += delta->value;
+  else
+    stat->count += delta->count;
+}
+
+/**************************************************************************************/
+/* sync_stats: adds the pending increments of all shards to global_stat_array.
+   Cheap when nothing is pending, so readers call it before every read. */
+
+void sync_stats(void) {
+  Stat_Shard* shard;
+  for(shard = __atomic_load_n(&stat_shards, __ATOMIC_ACQUIRE); shard;
+      shard = shard->next) {
+    for(uns ii = 0; ii < shard->num_dirty; ii++) {
+      uns         idx   = shard->dirty[ii];
+      Stat_Delta* delta = &shard->deltas[idx];
+      if(idx < NUM_GLOBAL_STATS) {
+        for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++)
+          merge_stat_delta(proc_id, idx, delta);
+      } else {
+        uns proc_id = idx / NUM_GLOBAL_STATS - 1;
+        merge_stat_delta(proc_id, idx % NUM_GLOBAL_STATS, delta);
+      }
+      memset(delta, 0, sizeof(Stat_Delta));
+    }
+    shard->num_dirty = 0;
+  }
 }
 
 /**************************************************************************************/
@@ -115,6 +276,16 @@ void gen_stat_output_file(char* buf, uns8 proc_id, Stat* stat, char csv) {
     sprintf(temp3, ".roi.%llu", roi_dump_ID);
     strncat(temp, temp3, 24);
   }
+  if (simpoint_dump_began) {
+    char temp3[32];
+    sprintf(temp3, ".simpoint.%llu", simpoint_dump_ID);
+    strncat(temp, temp3, 32);
+  }
+  if (mix_dump_began) {
+    char temp3[32];
+    sprintf(temp3, ".mix.%llu", mix_dump_ID);
+    strncat(temp, temp3, 32);
+  }
   strncpy(buf, OUTPUT_DIR, MAX_STR_LENGTH);
   strncat(buf, "/", MAX_STR_LENGTH);
   strncat(buf, FILE_TAG, MAX_STR_LENGTH);
@@ -149,6 +320,147 @@ void fprint_line(FILE* file) {
 }
 
 
+/**************************************************************************************/
+/* open_stats_binary: creates the binary stat file and writes its header */
+
+static void open_stats_binary(void) {
+  char buf[MAX_STR_LENGTH + 1];
+  snprintf(buf, MAX_STR_LENGTH, "%s/%s%s", OUTPUT_DIR, FILE_TAG,
+           STATS_BINARY_FILE);
+  stat_bin_stream = fopen(buf, "wb");
+  ASSERTUM(0, stat_bin_stream, "Couldn't open binary stat file '%s'.\n", buf);
+
+  uns64 names_size = 0, files_size = 0;
+  for(uns ii = 0; ii < NUM_GLOBAL_STATS; ii++) {
+    names_size += strlen(global_stat_array[0][ii].name) + 1;
+    files_size += strlen(global_stat_array[0][ii].file_name) - 3 + 1;
+  }
+
+  Stat_Bin_Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, STAT_BIN_MAGIC, sizeof(header.magic));
+  header.version      = STATS_BINARY_SPARSE ? STAT_BIN_SPARSE_VERSION :
+                                            STAT_BIN_VERSION;
+  header.num_cores    = NUM_CORES;
+  header.num_stats    = NUM_GLOBAL_STATS;
+  header.record_size  = STATS_BINARY_SPARSE ?
+                         0 :
+                         sizeof(Stat_Bin_Record) +
+                           2 * NUM_GLOBAL_STATS * sizeof(uns64);
+  header.names_offset = sizeof(header);
+  header.names_size   = names_size;
+  header.files_offset = STAT_BIN_ALIGN(header.names_offset + names_size);
+  header.files_size   = files_size;
+  header.types_offset = STAT_BIN_ALIGN(header.files_offset + files_size);
+  header.data_offset  = STAT_BIN_ALIGN(header.types_offset + NUM_GLOBAL_STATS);
+
+  static const char pad[8] = {0};
+  fwrite(&header, sizeof(header), 1, stat_bin_stream);
+  for(uns ii = 0; ii < NUM_GLOBAL_STATS; ii++)
+    fwrite(global_stat_array[0][ii].name, 1,
+           strlen(global_stat_array[0][ii].name) + 1, stat_bin_stream);
+  fwrite(pad, 1, header.files_offset - header.names_offset - names_size,
+         stat_bin_stream);
+  for(uns ii = 0; ii < NUM_GLOBAL_STATS; ii++) {
+    /* same "core.stat." prefix that gen_stat_output_file() uses */
+    fwrite(global_stat_array[0][ii].file_name, 1,
+           strlen(global_stat_array[0][ii].file_name) - 3, stat_bin_stream);
+    fwrite(pad, 1, 1, stat_bin_stream);
+  }
+  fwrite(pad, 1, header.types_offset - header.files_offset - files_size,
+         stat_bin_stream);
+  for(uns ii = 0; ii < NUM_GLOBAL_STATS; ii++) {
+    uns8 type = global_stat_array[0][ii].type;
+    fwrite(&type, 1, 1, stat_bin_stream);
+  }
+  fwrite(pad, 1, header.data_offset - header.types_offset - NUM_GLOBAL_STATS,
+         stat_bin_stream);
+
+  stat_bin_size = STATS_BINARY_SPARSE ?
+                    sizeof(Stat_Bin_Record) + sizeof(uns64) +
+                      NUM_GLOBAL_STATS * sizeof(Stat_Bin_Entry) :
+                    header.record_size;
+  stat_bin_buf  = (uns64*)malloc(stat_bin_size);
+}
+
+/**************************************************************************************/
+/* dump_stats_binary: appends one record with the current interval and total
+   values of all stats of a core (of the stats in the dirty list of the core
+   if STATS_BINARY_SPARSE). Must be called after the totals have been updated
+   and before the interval counters are cleared. */
+
+static void dump_stats_binary(uns8 proc_id, Stat stat_array[]) {
+  if(!stat_bin_stream)
+    open_stats_binary();
+
+  Stat_Bin_Record* record = (Stat_Bin_Record*)stat_bin_buf;
+
+  record->proc_id     = proc_id;
+  record->flags       = 0;
+  record->interval_id = 0;
+  if(FULL_WARMUP && !warmup_dump_done[proc_id])
+    record->flags |= STAT_BIN_WARMUP;
+  if(PERIODIC_DUMP) {
+    record->flags |= STAT_BIN_PERIODIC;
+    record->interval_id = period_ID;
+  }
+  if(roi_dump_began) {
+    record->flags |= STAT_BIN_ROI;
+    record->interval_id = roi_dump_ID;
+  }
+  if(simpoint_dump_began) {
+    record->flags |= STAT_BIN_SIMPOINT;
+    record->interval_id = simpoint_dump_ID;
+  }
+  if(mix_dump_began) {
+    record->flags |= STAT_BIN_MIX;
+    record->interval_id = mix_dump_ID;
+  }
+  record->cycle_count = cycle_count;
+  record->inst_count  = inst_count[proc_id];
+
+  /* count/value and total_count/total_value share storage, so copying the
+     counters also copies the bits of float stats */
+  if(STATS_BINARY_SPARSE) {
+    Stat_Dirty_List* list        = &stat_dirty_lists[proc_id];
+    uns64*           num_entries = (uns64*)(record + 1);
+    Stat_Bin_Entry*  entries     = (Stat_Bin_Entry*)(num_entries + 1);
+
+    *num_entries = list->num;
+    for(uns ii = 0; ii < list->num; ii++) {
+      entries[ii].idx   = list->idx[ii];
+      entries[ii].count = stat_array[list->idx[ii]].count;
+      entries[ii].total = stat_array[list->idx[ii]].total_count;
+    }
+    fwrite(stat_bin_buf, 1,
+           sizeof(Stat_Bin_Record) + sizeof(uns64) +
+             list->num * sizeof(Stat_Bin_Entry),
+           stat_bin_stream);
+  } else {
+    uns64* counts = (uns64*)(record + 1);
+    uns64* totals = counts + NUM_GLOBAL_STATS;
+    for(uns ii = 0; ii < NUM_GLOBAL_STATS; ii++) {
+      counts[ii] = stat_array[ii].count;
+      totals[ii] = stat_array[ii].total_count;
+    }
+    fwrite(stat_bin_buf, stat_bin_size, 1, stat_bin_stream);
+  }
+  fflush(stat_bin_stream);
+}
+
+/**************************************************************************************/
+/* close_stats_binary: the next dump creates the binary stat file again, in the
+   current OUTPUT_DIR (used by the children of a sweep) */
+
+void close_stats_binary(void) {
+  if(stat_bin_stream)
+    fclose(stat_bin_stream);
+  free(stat_bin_buf);
+  stat_bin_stream = NULL;
+  stat_bin_buf    = NULL;
+  stat_bin_size   = 0;
+}
+
 /**************************************************************************************/
 /* dump_stats: */
 
@@ -163,8 +475,16 @@ void dump_stats(uns8 proc_id, Flag final, Stat stat_array[], uns num_stats) {
   if(!DUMP_STATS)
     return;
 
-  for(ii = 0; ii < num_stats; ii++) {
-    Stat* s = &stat_array[ii];
+  /* only the stats in the dirty list of the core have a nonzero count, so a
+     full dump does not have to visit the others to update the counters */
+  Flag             full       = num_stats == NUM_GLOBAL_STATS;
+  Stat_Dirty_List* dirty_list = &stat_dirty_lists[proc_id];
+  ASSERT(proc_id, !full || stat_array == global_stat_array[proc_id]);
+
+  sync_stats();
+  uns num_touched = full ? dirty_list->num : num_stats;
+  for(ii = 0; ii < num_touched; ii++) {
+    Stat* s = &stat_array[full ? dirty_list->idx[ii] : ii];
 
     /* update the total counter for this interval */
     if(s->type == FLOAT_TYPE_STAT)
@@ -173,6 +493,9 @@ void dump_stats(uns8 proc_id, Flag final, Stat stat_array[], uns num_stats) {
       s->total_count += s->count;
   }
 
+  if(DUMP_STATS_BINARY && full)
+    dump_stats_binary(proc_id, stat_array);
+
   const char* last_file_name  = NULL;
   FILE*       file_stream     = NULL;
   FILE*       csv_file_stream = NULL;
@@ -477,20 +800,24 @@ void dump_stats(uns8 proc_id, Flag final, Stat stat_array[], uns num_stats) {
   }
 
   /* reset the interval counters */
-  for(ii = 0; ii < num_stats; ii++) {
-    Stat* s = &stat_array[ii];
+  for(ii = 0; ii < num_touched; ii++) {
+    Stat* s = &stat_array[full ? dirty_list->idx[ii] : ii];
     if(s->type == FLOAT_TYPE_STAT)
       s->value = 0.0;
     else
       s->count = 0;
+    if(full)
+      s->dirty = FALSE;
   }
+  if(full)
+    dirty_list->num = 0;
 }
 
 /**************************************************************************************/
 /* dump_stats: */
 
 void reset_stats(Flag keep_total) {
-  uns proc_id, ii;
+  uns proc_id;
   if(!opt2_in_use() || opt2_is_leader()) {
     fprintf(mystdout, "** Stats Cleared:   insts: { ");
     for(proc_id = 0; proc_id < NUM_CORES; proc_id++)
@@ -500,9 +827,23 @@ void reset_stats(Flag keep_total) {
     fflush(mystdout);
   }
 
-  for(ii = 0; ii < NUM_GLOBAL_STATS; ii++) {
-    for(proc_id = 0; proc_id < NUM_CORES; proc_id++) {
-      Stat* stat = &global_stat_array[proc_id][ii];
+  clear_stat_counts(keep_total);
+}
+
+/**************************************************************************************/
+/* clear_stat_counts: reset_stats without the status message, for callers that
+   clear the stats many times per run (e.g. sampled simulation). */
+
+void clear_stat_counts(Flag keep_total) {
+  uns proc_id, ii;
+  /* a sparse binary record must include the totals changed here, so the
+     stats stay in the dirty list until the next dump */
+  Flag keep_dirty = DUMP_STATS && DUMP_STATS_BINARY && STATS_BINARY_SPARSE;
+  sync_stats();
+  for(proc_id = 0; proc_id < NUM_CORES; proc_id++) {
+    Stat_Dirty_List* dirty_list = &stat_dirty_lists[proc_id];
+    for(ii = 0; ii < dirty_list->num; ii++) {
+      Stat* stat = &global_stat_array[proc_id][dirty_list->idx[ii]];
       if(stat->type == FLOAT_TYPE_STAT) {
         if(keep_total || stat->noreset)
           stat->total_value += stat->value;
@@ -512,7 +853,11 @@ void reset_stats(Flag keep_total) {
           stat->total_count += stat->count;
         stat->count = 0ULL;
       }
+      if(!keep_dirty)
+        stat->dirty = FALSE;
     }
+    if(!keep_dirty)
+      dirty_list->num = 0;
   }
 }
 
@@ -537,6 +882,7 @@ const Stat* get_stat(uns8 proc_id, const char* name) {
   Stat_Enum idx = get_stat_idx(name);
   if(idx == NUM_GLOBAL_STATS)
     return NULL;
+  sync_stats();
   return &global_stat_array[proc_id][idx];
 }
 
@@ -549,6 +895,7 @@ Counter get_accum_stat_event(Stat_Enum name) {
   if(name == NUM_GLOBAL_STATS)
     return 0;
 
+  sync_stats();
   for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) {
     accum += global_stat_array[proc_id][name].total_count;
   }
@@ -87,8 +87,20 @@ typedef struct Stat_struct {
   Stat_Enum   ratio_stat;  // stat that to use in the ratio
   const char* file_name;   // name of file to print stats
   Flag noreset;  // this stat does not get reset (name has prefix "NORESET")
+  Flag dirty;    // index is in the dirty list of the core
 } Stat;
 
+/* Stats of a core whose count or total may have changed since the last full
+   dump_stats() of the core. Only these need to be cleared, added to the totals
+   or written to a sparse binary record, so resetting and dumping stats costs
+   O(touched stats) instead of O(NUM_GLOBAL_STATS). Every write to a stat must
+   go through stat_touch() (the STAT_EVENT macros, SET_STAT_EVENT and
+   RESET_STAT do); reads do not touch. */
+typedef struct Stat_Dirty_List_struct {
+  uns* idx;  // [NUM_GLOBAL_STATS]
+  uns  num;
+} Stat_Dirty_List;
+
 
 #define UOP_QUEUE_CAPACITY_MAX_MEASURED 7
 typedef struct Uop_Queue_Fill_Time_For_Size_struct {
@@ -102,52 +114,80 @@ typedef struct Uop_Queue_Fill_Time_struct {
   Uop_Queue_Fill_Time_For_Size time_for_size[UOP_QUEUE_CAPACITY_MAX_MEASURED];
 } Uop_Queue_Fill_Time;
 
+/* Pending increments of stats that have not been added to global_stat_array
+   yet. Row 0 holds the uncore events (the _ALL macros), which are counted once
+   and added to the stat of every core by sync_stats(). With STAT_SHARDS, each
+   simulation thread has its own shard with one more row per core, so threads
+   never write the same memory. */
+typedef struct Stat_Delta_struct {
+  union {
+    Counter count;
+    double  value;
+  };
+  Flag dirty;  // index is in the dirty list of the shard
+} Stat_Delta;
+
+typedef struct Stat_Shard_struct {
+  Stat_Delta*               deltas;  // [num_rows * NUM_GLOBAL_STATS]
+  uns*                      dirty;   // indices of the dirty deltas
+  uns                       num_dirty;
+  struct Stat_Shard_struct* next;  // list of all shards
+} Stat_Shard;
+
 /**************************************************************************************/
 /* Macros */
 
 #ifndef NO_STAT
-#define STAT_EVENT(proc_id, stat)             \
-  do {                                        \
-    global_stat_array[proc_id][stat].count++; \
-  } while(0)
-
-#define STAT_EVENT_ALL(stat)                             \
-  do {                                                   \
-    for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) \
-      global_stat_array[proc_id][stat].count++;          \
-  } while(0)
-
-#define INC_STAT_EVENT(proc_id, stat, inc)           \
-  do {                                               \
-    global_stat_array[proc_id][stat].count += (inc); \
-  } while(0)
+#ifdef STAT_SHARDS
+#define STAT_SHARD() (thread_stat_shard ? thread_stat_shard : new_stat_shard())
+#define STAT_SHARD_IDX(proc_id, stat) \
+  (((proc_id) + 1) * NUM_GLOBAL_STATS + (stat))
+
+#define STAT_EVENT(proc_id, stat) \
+  stat_shard_add_count(STAT_SHARD(), STAT_SHARD_IDX(proc_id, stat), 1)
+#define INC_STAT_EVENT(proc_id, stat, inc) \
+  stat_shard_add_count(STAT_SHARD(), STAT_SHARD_IDX(proc_id, stat), (inc))
+#define INC_STAT_VALUE(proc_id, stat, inc) \
+  stat_shard_add_value(STAT_SHARD(), STAT_SHARD_IDX(proc_id, stat), (inc))
+#else
+#define STAT_SHARD() (&uncore_stat_shard)
 
-#define INC_STAT_EVENT_ALL(stat, inc)                    \
-  do {                                                   \
-    for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) \
-      global_stat_array[proc_id][stat].count += (inc);   \
+#define STAT_EVENT(proc_id, stat)           \
+  do {                                      \
+    stat_touch((proc_id), (stat))->count++; \
   } while(0)
 
-#define INC_STAT_VALUE(proc_id, stat, inc)           \
-  do {                                               \
-    global_stat_array[proc_id][stat].value += (inc); \
+#define INC_STAT_EVENT(proc_id, stat, inc)         \
+  do {                                             \
+    stat_touch((proc_id), (stat))->count += (inc); \
   } while(0)
 
-#define INC_STAT_VALUE_ALL(stat, inc)                    \
-  do {                                                   \
-    for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++) \
-      global_stat_array[proc_id][stat].value += (inc);   \
+#define INC_STAT_VALUE(proc_id, stat, inc)         \
+  do {                                             \
+    stat_touch((proc_id), (stat))->value += (inc); \
   } while(0)
+#endif
 
-#define GET_STAT_EVENT(proc_id, stat) (global_stat_array[proc_id][stat].count)
-#define GET_TOTAL_STAT_EVENT(proc_id, stat) \
-  (global_stat_array[proc_id][stat].count + \
-   global_stat_array[proc_id][stat].total_count)
-#define GET_TOTAL_STAT_VALUE(proc_id, stat) \
-  (global_stat_array[proc_id][stat].value + \
-   global_stat_array[proc_id][stat].total_value)
+#define STAT_EVENT_ALL(stat) stat_shard_add_count(STAT_SHARD(), (stat), 1)
+#define INC_STAT_EVENT_ALL(stat, inc) \
+  stat_shard_add_count(STAT_SHARD(), (stat), (inc))
+#define INC_STAT_VALUE_ALL(stat, inc) \
+  stat_shard_add_value(STAT_SHARD(), (stat), (inc))
+
+/* the accessors merge the pending increments first; only the writes touch
+   the stat */
+#define GET_STAT_EVENT(proc_id, stat) \
+  (sync_stats(), global_stat_array[proc_id][stat].count)
+#define SET_STAT_EVENT(proc_id, stat, val) \
+  (sync_stats(), stat_touch((proc_id), (stat))->count = (val))
+#define GET_TOTAL_STAT_EVENT(proc_id, stat)              \
+  (sync_stats(), global_stat_array[proc_id][stat].count + \
+                   global_stat_array[proc_id][stat].total_count)
+#define GET_TOTAL_STAT_VALUE(proc_id, stat)              \
+  (sync_stats(), global_stat_array[proc_id][stat].value + \
+                   global_stat_array[proc_id][stat].total_value)
 #define GET_ACCUM_STAT_EVENT(stat) get_accum_stat_event(stat)
-#define RESET_STAT(proc_id, stat) (global_stat_array[proc_id][stat].count = 0)
+#define RESET_STAT(proc_id, stat) SET_STAT_EVENT(proc_id, stat, 0)
 
 #define NO_RATIO NUM_GLOBAL_STATS
 
@@ -160,6 +200,7 @@ typedef struct Uop_Queue_Fill_Time_struct {
 #define INC_STAT_VALUE(proc_id, stat, inc)
 #define INC_STAT_VALUE_ALL(stat, inc)
 #define GET_STAT_EVENT(proc_id, stat) 0
+#define SET_STAT_EVENT(proc_id, stat, val)
 #define GET_TOTAL_STAT_EVENT(proc_id, stat) 0
 #define GET_TOTAL_STAT_VALUE(proc_id, stat)
 #define GET_ACCUM_STAT_EVENT(stat)
@@ -172,7 +213,12 @@ typedef struct Uop_Queue_Fill_Time_struct {
 /* Global Variables */
 
 #ifndef NO_STAT
-extern Stat** global_stat_array;
+extern Stat**           global_stat_array;
+extern Stat_Dirty_List* stat_dirty_lists;  // [NUM_CORES]
+extern Stat_Shard       uncore_stat_shard;
+#ifdef STAT_SHARDS
+extern CORE_LOCAL Stat_Shard* thread_stat_shard;
+#endif
 #endif
 
 
@@ -186,15 +232,56 @@ void        init_global_stats_array(void);
 void        gen_stat_output_file(char*, uns8, Stat*, char);
 void        init_global_stats(uns8);
 void        dump_stats(uns8, Flag, Stat[], uns);
+void        close_stats_binary(void);
 void        reset_stats(Flag);
+void        clear_stat_counts(Flag);
 void        fprint_line(FILE*);
 Stat_Enum   get_stat_idx(const char* name);
 const Stat* get_stat(uns8, const char*);
 Counter     get_accum_stat_event(Stat_Enum name);
+void        sync_stats(void);
+Stat_Shard* new_stat_shard(void);
 
 #ifdef __cplusplus
 }
 #endif
+
+/**************************************************************************************/
+/* Inline Functions */
+
+#ifndef NO_STAT
+/* stat_touch: returns a stat that is about to be written, adding it to the
+   dirty list of its core */
+static inline Stat* stat_touch(uns proc_id, uns idx) {
+  Stat* stat = &global_stat_array[proc_id][idx];
+  if(!stat->dirty) {
+    Stat_Dirty_List* list  = &stat_dirty_lists[proc_id];
+    stat->dirty            = TRUE;
+    list->idx[list->num++] = idx;
+  }
+  return stat;
+}
+#endif
+
+static inline Stat_Delta* stat_shard_delta(Stat_Shard* shard, uns idx) {
+  Stat_Delta* delta = &shard->deltas[idx];
+  if(!delta->dirty) {
+    delta->dirty                      = TRUE;
+    shard->dirty[shard->num_dirty++] = idx;
+  }
+  return delta;
+}
+
+static inline void stat_shard_add_count(Stat_Shard* shard, uns idx,
+                                        Counter inc) {
+  stat_shard_delta(shard, idx)->count += inc;
+}
+
+static inline void stat_shard_add_value(Stat_Shard* shard, uns idx,
+                                        double inc) {
+  stat_shard_delta(shard, idx)->value += inc;
+}
+
 /**************************************************************************************/
 
 #endif /* #ifndef __STATISTICS_H__ */
@@ -0,0 +1,286 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : sweep.c
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Parameter sweeps that share one warmup.
+ *
+ * Like optimizer2, a sweep forks the whole simulator at a decision point: the
+ * trace is opened and the model is warmed up once, then one child is forked
+ * per sweep point. The children share the warmed caches and predictors
+ * through copy-on-write pages, apply their own parameter overrides and
+ * simulate the rest of the run, writing their stats to
+ * OUTPUT_DIR/sweep<point>.
+ *
+ * SWEEP_FILE has one sweep point per line, given with the syntax of the
+ * command line ("--param value ..."); empty lines and lines starting with '#'
+ * are ignored. The overrides are applied just before the model is initialized
+ * for simulation mode, so only parameters read from then on take effect:
+ * structures allocated before warmup keep the values of the common run. The
+ * parameters the model is built from are listed in sweep_init_params.def; the
+ * child of a sweep point compares them before and after its overrides and
+ * stops if one of them changed.
+ ***************************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "globals/assert.h"
+#include "globals/global_defs.h"
+#include "globals/global_types.h"
+#include "globals/global_vars.h"
+#include "globals/utils.h"
+
+#include "frontend/frontend_intf.h"
+#include "frontend/pin_trace_read.h"
+#include "host_prof.h"
+#include "pc_prof.h"
+#include "param_parser.h"
+#include "ramulator.h"
+#include "statistics.h"
+#include "sweep.h"
+
+#include "bp/bp.param.h"
+#include "core.param.h"
+#include "dvfs/dvfs.param.h"
+#include "general.param.h"
+#include "memory/memory.param.h"
+#include "power/power.param.h"
+#include "prefetcher/l2l1pref.param.h"
+#include "prefetcher/pref.param.h"
+#include "prefetcher/pref_2dc.param.h"
+#include "prefetcher/pref_ghb.param.h"
+#include "prefetcher/pref_markov.param.h"
+#include "prefetcher/pref_phase.param.h"
+#include "prefetcher/pref_stride.param.h"
+#include "prefetcher/pref_stridepc.param.h"
+#include "prefetcher/stream.param.h"
+#include "ramulator.param.h"
+
+/**************************************************************************************/
+/* Macros */
+
+#define SWEEP_MAX_ARGS 256
+
+/**************************************************************************************/
+/* Types */
+
+typedef struct Sweep_Init_Param_struct {
+  const char* name;
+  const void* var;
+  uns         size;    // bytes of a numeric parameter
+  Flag        is_str;  // the variable is a char*
+} Sweep_Init_Param;
+
+typedef union Sweep_Init_Value_union {
+  uns64 num;  // raw bytes of a numeric parameter
+  char* str;  // copy of a string parameter
+} Sweep_Init_Value;
+
+/**************************************************************************************/
+/* Global Variables */
+
+static const Sweep_Init_Param sweep_init_params[] = {
+#define SWEEP_INIT_PARAM(name, variable) \
+  {#name, &variable, sizeof(variable), FALSE},
+#define SWEEP_INIT_STR_PARAM(name, variable) {#name, &variable, 0, TRUE},
+#include "sweep_init_params.def"
+#undef SWEEP_INIT_PARAM
+#undef SWEEP_INIT_STR_PARAM
+};
+
+#define NUM_SWEEP_INIT_PARAMS \
+  (sizeof(sweep_init_params) / sizeof(sweep_init_params[0]))
+
+/**************************************************************************************/
+/* Local Prototypes */
+
+static uns               read_sweep_points(char*** points);
+static Sweep_Init_Value* save_init_params(void);
+static void check_init_params(int point, Sweep_Init_Value* saved);
+static void init_sweep_point(int point, char* line);
+
+/**************************************************************************************/
+/* read_sweep_points: returns the number of sweep points of SWEEP_FILE and
+   their override lines */
+
+static uns read_sweep_points(char*** points) {
+  FILE* file = fopen(SWEEP_FILE, "r");
+  ASSERTM(0, file, "Could not open sweep file %s\n", SWEEP_FILE);
+
+  char line[MAX_STR_LENGTH + 1];
+  uns  num_points = 0;
+  *points         = NULL;
+  while(fgets(line, sizeof(line), file)) {
+    ASSERTM(0, strchr(line, '\n') || feof(file),
+            "Line %u of sweep file %s is too long\n", num_points + 1,
+            SWEEP_FILE);
+    char* start = line + strspn(line, " \t\r\n");
+    if(!*start || *start == '#')
+      continue;
+    *points = (char**)realloc(*points, sizeof(char*) * (num_points + 1));
+    (*points)[num_points++] = strdup(start);
+  }
+  fclose(file);
+  ASSERTM(0, num_points, "Sweep file %s has no sweep point\n", SWEEP_FILE);
+  return num_points;
+}
+
+/**************************************************************************************/
+/* save_init_params: returns a copy of the values of sweep_init_params */
+
+static Sweep_Init_Value* save_init_params(void) {
+  Sweep_Init_Value* saved = (Sweep_Init_Value*)calloc(NUM_SWEEP_INIT_PARAMS,
+                                                      sizeof(Sweep_Init_Value));
+  for(uns ii = 0; ii < NUM_SWEEP_INIT_PARAMS; ii++) {
+    const Sweep_Init_Param* param = &sweep_init_params[ii];
+    if(param->is_str) {
+      const char* str = *(const char* const*)param->var;
+      saved[ii].str   = str ? strdup(str) : NULL;
+    } else {
+      ASSERT(0, param->size <= sizeof(saved[ii].num));
+      memcpy(&saved[ii].num, param->var, param->size);
+    }
+  }
+  return saved;
+}
+
+/**************************************************************************************/
+/* check_init_params: stops the sweep point if its overrides changed a
+   parameter the model was already built from. The values are compared, so
+   abbreviated option names are caught too. */
+
+static void check_init_params(int point, Sweep_Init_Value* saved) {
+  for(uns ii = 0; ii < NUM_SWEEP_INIT_PARAMS; ii++) {
+    const Sweep_Init_Param* param = &sweep_init_params[ii];
+    Flag                    changed;
+    if(param->is_str) {
+      const char* old_str = saved[ii].str;
+      const char* new_str = *(const char* const*)param->var;
+      changed = (!old_str || !new_str) ? old_str != new_str :
+                                         strcmp(old_str, new_str) != 0;
+      free(saved[ii].str);
+    } else {
+      changed = memcmp(&saved[ii].num, param->var, param->size) != 0;
+    }
+    if(changed)
+      FATAL_ERROR(0,
+                  "Sweep point %d sets '%s', which is read before the sweep "
+                  "forks and would keep the value of the common run\n",
+                  point, param->name);
+  }
+  free(saved);
+}
+
+/**************************************************************************************/
+/* init_sweep_point: runs in the forked child of sweep point 'point' */
+
+static void init_sweep_point(int point, char* line) {
+  /* reopened in the sweep directory by the next dump */
+  close_stats_binary();
+  /* stop sharing file offsets and trace pipes with the parent */
+  decouple_open_files();
+  if(FRONTEND == FE_TRACE) {
+    for(uns proc_id = 0; proc_id < NUM_CORES; proc_id++)
+      pin_trace_reopen(proc_id);
+  }
+
+  char dir[MAX_STR_LENGTH + 1];
+  uns  len = snprintf(dir, MAX_STR_LENGTH, "%s/sweep%d", OUTPUT_DIR, point);
+  ASSERT(0, len < MAX_STR_LENGTH);
+  if(mkdir(dir, 0755) && errno != EEXIST)
+    FATAL_ERROR(0, "Could not create sweep directory %s: %s\n", dir,
+                strerror(errno));
+  OUTPUT_DIR = strdup(dir);
+
+  char* args[SWEEP_MAX_ARGS + 1];
+  int   num_args = 0;
+  args[num_args++] = "sweep";
+  for(char* tok = strtok(line, " \t\r\n"); tok; tok = strtok(NULL, " \t\r\n")) {
+    ASSERTM(0, num_args < SWEEP_MAX_ARGS,
+            "Sweep point %d has too many arguments\n", point);
+    args[num_args++] = tok;
+  }
+  args[num_args] = NULL;
+  Sweep_Init_Value* saved = save_init_params();
+  override_params(num_args, args, OUTPUT_DIR);
+  check_init_params(point, saved);
+
+  ramulator_set_output_dir(OUTPUT_DIR);
+  host_prof_init();
+  pc_prof_init();
+}
+
+/**************************************************************************************/
+/* sweep_fork: */
+
+Flag sweep_fork(void) {
+  ASSERTM(0, FRONTEND != FE_PIN_EXEC_DRIVEN,
+          "Sweeps need a trace frontend (the pin process cannot be forked)\n");
+
+  char** points;
+  uns    num_points = read_sweep_points(&points);
+  uns    max_procs  = SWEEP_MAX_PROCS ? SWEEP_MAX_PROCS : num_points;
+  uns    running    = 0;
+  uns    failed     = 0;
+
+  fprintf(mystdout, "** Sweep of %u points forked at insts:%llu\n", num_points,
+          inst_count[0]);
+  ramulator_stop_threads();
+  for(uns point = 0; point < num_points || running; point++) {
+    if(running == max_procs || point >= num_points) {
+      int status;
+      if(wait(&status) == -1)
+        FATAL_ERROR(0, "Sweep wait FAILED. errno: %s\n", strerror(errno));
+      if(!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+        failed++;
+      running--;
+      if(point >= num_points)
+        continue;
+    }
+
+    fflush(NULL); /* avoid repeated output */
+    pid_t pid = fork();
+    if(pid == -1)
+      FATAL_ERROR(0, "Sweep fork FAILED. errno: %s\n", strerror(errno));
+    if(!pid) {
+      init_sweep_point(point, points[point]);
+      return TRUE;
+    }
+    running++;
+  }
+
+  for(uns point = 0; point < num_points; point++)
+    free(points[point]);
+  free(points);
+  if(failed)
+    FATAL_ERROR(0, "%u of %u sweep points failed\n", failed, num_points);
+  fprintf(mystdout, "** Sweep done: %u points\n", num_points);
+  return FALSE;
+}
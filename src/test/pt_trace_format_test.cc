@@ -0,0 +1,172 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* The binary PT trace format must round-trip the text format: a text trace is
+ * parsed, written with PTTraceWriter and read back with PTTraceParser, and
+ * every PTInst is compared with the instructions the text was made from. */
+
+#include <stdio.h>
+#include <zlib.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../frontend/pt_memtrace/pt_trace_format.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+const char* TEXT_TRACE   = "pt_trace_test.txt.gz";
+const char* BINARY_TRACE = "pt_trace_test.bin";
+
+/* Random instructions with jumps back and forth and a pc whose bytes change
+   halfway through (jitted code). Enough of them that both traces run past
+   several PT_BLOCK_SIZE refills, so records straddle the ensure() boundary. */
+std::vector<PTInst> make_insts(size_t num) {
+  std::mt19937        rng(3);
+  std::vector<PTInst> insts;
+  uint64_t            pc     = 0x400000;
+  const uint64_t      jitted = 0x7f0000001000ull;
+  for(size_t i = 0; i < num; i++) {
+    PTInst inst;
+    if(i % 1000 == 500) {
+      inst.pc = jitted;
+    } else if(rng() % 8 == 0) {
+      inst.pc = 0x400000 + rng() % 0x400000;  // either direction
+    } else {
+      inst.pc = pc;
+    }
+    memset(inst.inst_bytes, 0, sizeof(inst.inst_bytes));
+    if(inst.pc == jitted) {
+      inst.size = 5;
+      memset(inst.inst_bytes, i < num / 2 ? 0x90 : 0xcc, inst.size);
+    } else {  // the same pc always has the same bytes
+      std::mt19937 code_rng(inst.pc);
+      inst.size = 1 + code_rng() % 15;
+      for(int b = 0; b < inst.size; b++)
+        inst.inst_bytes[b] = code_rng();
+    }
+    insts.push_back(inst);
+    pc = inst.pc + inst.size;
+  }
+  return insts;
+}
+
+/* Writes the text format, with and without the 0x prefix on the pc. */
+void write_text(const char* path, const std::vector<PTInst>& insts) {
+  gzFile file = gzopen(path, "wb1");
+  ASSERT_TRUE(file != NULL);
+  for(size_t i = 0; i < insts.size(); i++) {
+    const PTInst& inst = insts[i];
+    gzprintf(file, i % 2 ? "0x%llx  %u" : "%llx  %u",
+             (unsigned long long)inst.pc, inst.size);
+    for(int b = 0; b < inst.size; b++)
+      gzprintf(file, " %02x", inst.inst_bytes[b]);
+    gzprintf(file, "\n");
+  }
+  gzclose(file);
+}
+
+std::vector<PTInst> read_trace(const char* path, bool* binary) {
+  PTTraceParser       parser;
+  std::vector<PTInst> insts;
+  PTInst              inst = {};
+  EXPECT_TRUE(parser.open(path));
+  *binary = parser.is_binary();
+  while(parser.next(inst))
+    insts.push_back(inst);
+  return insts;
+}
+
+void expect_same(const std::vector<PTInst>& expected,
+                 const std::vector<PTInst>& insts) {
+  ASSERT_EQ(expected.size(), insts.size());
+  for(size_t i = 0; i < insts.size(); i++) {
+    ASSERT_EQ(expected[i].pc, insts[i].pc) << "inst " << i;
+    ASSERT_EQ(expected[i].size, insts[i].size) << "inst " << i;
+    ASSERT_EQ(0, memcmp(expected[i].inst_bytes, insts[i].inst_bytes,
+                        expected[i].size))
+      << "inst " << i;
+  }
+}
+
+void round_trip(bool compress) {
+  std::vector<PTInst> expected = make_insts(300000);
+  write_text(TEXT_TRACE, expected);
+
+  bool                binary;
+  std::vector<PTInst> text = read_trace(TEXT_TRACE, &binary);
+  EXPECT_FALSE(binary);
+  expect_same(expected, text);
+
+  PTTraceWriter writer;
+  ASSERT_TRUE(writer.open(BINARY_TRACE, compress));
+  for(const PTInst& inst : text)
+    writer.write(inst);
+  writer.close();
+  if(!compress) {
+    FILE* file = fopen(BINARY_TRACE, "rb");
+    fseek(file, 0, SEEK_END);
+    EXPECT_GT(ftell(file), 2 * PT_BLOCK_SIZE);
+    fclose(file);
+  }
+
+  std::vector<PTInst> insts = read_trace(BINARY_TRACE, &binary);
+  EXPECT_TRUE(binary);
+  expect_same(expected, insts);
+  remove(TEXT_TRACE);
+  remove(BINARY_TRACE);
+}
+
+}  // namespace
+
+TEST(PTTraceFormatTest, BinaryRoundTrip) {
+  round_trip(false);
+}
+
+TEST(PTTraceFormatTest, CompressedBinaryRoundTrip) {
+  round_trip(true);
+}
+
+TEST(PTTraceFormatTest, TruncatedVarintIsCorrupt) {
+  PTInst inst = {0x1000, 3, {0x0f, 0x1f, 0x00}};
+  PTTraceWriter writer;
+  ASSERT_TRUE(writer.open(BINARY_TRACE, false));
+  writer.write(inst);
+  writer.write(inst);
+  writer.close();
+
+  /* a record for the same pc again, cut off after the first varint byte:
+     zigzag(-3) = 5, with the continuation bit still set */
+  const uint8_t truncated[] = {3, 0x85};
+  FILE*         file        = fopen(BINARY_TRACE, "ab");
+  fwrite(truncated, 1, sizeof(truncated), file);
+  fclose(file);
+
+  PTTraceParser parser;
+  PTInst        read;
+  ASSERT_TRUE(parser.open(BINARY_TRACE));
+  EXPECT_TRUE(parser.next(read));
+  EXPECT_TRUE(parser.next(read));
+  EXPECT_FALSE(parser.next(read));
+  remove(BINARY_TRACE);
+}
@@ -0,0 +1,209 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* The ramulator speedups must not change the simulated timing: the flattened
+ * timing tables (ramulator_flat_timing), idle tick skipping
+ * (ramulator_skip_idle) and channel threads (ramulator_channel_threads) are
+ * each checked against the plain model on the same request stream. */
+
+#include <atomic>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../ramulator/ChannelThreads.h"
+#include "../ramulator/Config.h"
+#include "../ramulator/DDR4.h"
+#include "../ramulator/DRAM.h"
+#include "../ramulator/Request.h"
+#include "../ramulator/ScarabWrapper.h"
+#include "gtest/gtest.h"
+
+using namespace ramulator;
+
+namespace {
+
+typedef std::vector<std::pair<long, long>> Completions;  // (addr, tick)
+
+struct RunConfig {
+  const char* flat_timing;
+  const char* channels;
+  const char* channel_threads;
+  bool        skip_idle;
+};
+
+void stats_callback(int, int) {}
+
+/* Runs a DDR4 memory for 'ticks' memory cycles on bursts of random reads and
+   writes separated by idle gaps and returns the read completions in the order
+   they were reported. With skip_idle, idle ticks are only counted and replayed
+   in one skip() before the next real tick or send, like ramulator.cc does. */
+Completions run_memory(const RunConfig& run, long ticks, long* skipped) {
+  Config configs;
+  configs.set_core_num(1);
+  const char* options[][2] = {
+    {"standard", "DDR4"},
+    {"speed", "DDR4_2400R"},
+    {"org", "DDR4_8Gb_x8"},
+    {"channels", run.channels},
+    {"channel_threads", run.channel_threads},
+    {"ranks", "2"},
+    {"record_cmd_trace", "off"},
+    {"print_cmd_trace", "off"},
+    {"flat_timing", run.flat_timing},
+    {"use_rest_of_addr_as_row_addr", "on"},
+    {"scheduling_policy", "FRFCFS_Cap"},
+    {"readq_entries", "32"},
+    {"writeq_entries", "32"},
+    {"output_dir", "."},
+  };
+  for(auto& option : options)
+    configs.add(option[0], option[1]);
+
+  /* the ramulator stats are registered globally, so the wrapper is kept for
+     the rest of the test */
+  ScarabWrapper* wrapper = new ScarabWrapper(configs, 64, stats_callback);
+  Completions    completions;
+  long           tick = 0, idle_left = 0, pending_skip = 0;
+  auto           catch_up = [&]() {
+    if(pending_skip)
+      wrapper->skip(pending_skip);
+    *skipped += pending_skip;
+    pending_skip = 0;
+    idle_left    = 0;
+  };
+
+  std::mt19937 rng(7);
+  *skipped = 0;
+  for(tick = 0; tick < ticks; tick++) {
+    bool burst = (tick / 20000) % 3 == 0 || tick % 5000 < 50;
+    if(burst && rng() % 4 == 0) {
+      Request req;
+      req.type     = rng() % 3 ? Request::Type::READ : Request::Type::WRITE;
+      req.addr     = (long)(rng() % (1 << 28)) << 6;
+      req.coreid   = 0;
+      req.callback = [&](Request& done) {
+        completions.push_back(std::make_pair(done.addr, tick));
+      };
+      catch_up();
+      wrapper->send(req);
+    }
+    if(run.skip_idle && idle_left) {
+      idle_left--;
+      pending_skip++;
+      continue;
+    }
+    catch_up();
+    wrapper->tick();
+    if(run.skip_idle)
+      idle_left = wrapper->idle_cycles();
+  }
+  catch_up();
+  wrapper->stop_threads();
+  return completions;
+}
+
+}  // namespace
+
+TEST(RamulatorTest, FlatTimingMatchesTree) {
+  typedef DDR4::Command Cmd;
+  DDR4* spec = new DDR4("DDR4_8Gb_x8", "DDR4_2400R");
+  spec->set_channel_number(1);
+  spec->set_rank_number(2);
+  DRAM<DDR4>* tree = new DRAM<DDR4>(spec, DDR4::Level::Channel);
+  DRAM<DDR4>* flat = new DRAM<DDR4>(spec, DDR4::Level::Channel);
+  flat->flatten_timing();
+
+  std::mt19937 rng(5);
+  const Cmd    reqs[] = {Cmd::RD, Cmd::WR, Cmd::REF, Cmd::PREA, Cmd::RDA};
+  long         issued = 0;
+  for(long clk = 0; clk < 200000; clk++) {
+    for(int attempt = 0; attempt < 4; attempt++) {
+      int addr[] = {0, int(rng() % 2), int(rng() % 4), int(rng() % 4),
+                    int(rng() % 8), int(rng() % 128)};
+      Cmd req    = reqs[rng() % 5];
+      if(req == Cmd::REF || req == Cmd::PREA)
+        addr[2] = addr[3] = addr[4] = addr[5] = -1;
+      Cmd cmd = tree->decode(req, addr);
+      ASSERT_EQ(cmd, flat->decode(req, addr)) << "clk " << clk;
+      for(int c = 0; c < int(Cmd::MAX); c++) {
+        ASSERT_EQ(tree->check(Cmd(c), addr, clk), flat->check(Cmd(c), addr, clk))
+          << "clk " << clk << " cmd " << c;
+        ASSERT_EQ(tree->get_next(Cmd(c), addr), flat->get_next(Cmd(c), addr))
+          << "clk " << clk << " cmd " << c;
+      }
+      if(tree->check(cmd, addr, clk)) {
+        tree->update(cmd, addr, clk);
+        flat->update(cmd, addr, clk);
+        issued++;
+        break;
+      }
+    }
+  }
+  EXPECT_GT(issued, 0);
+  delete tree;
+  delete flat;
+  delete spec;
+}
+
+TEST(RamulatorTest, FlatTimingKeepsCompletions) {
+  long        skipped;
+  Completions tree = run_memory({"off", "1", "1", false}, 300000, &skipped);
+  Completions flat = run_memory({"on", "1", "1", false}, 300000, &skipped);
+  EXPECT_FALSE(tree.empty());
+  EXPECT_EQ(tree, flat);
+}
+
+TEST(RamulatorTest, IdleSkipKeepsCompletions) {
+  long        skipped;
+  Completions ticked = run_memory({"off", "2", "1", false}, 300000, &skipped);
+  Completions skipping = run_memory({"off", "2", "1", true}, 300000, &skipped);
+  EXPECT_GT(skipped, 0);
+  EXPECT_FALSE(ticked.empty());
+  EXPECT_EQ(ticked, skipping);
+}
+
+TEST(RamulatorTest, ChannelThreadsKeepCompletions) {
+  long        skipped;
+  Completions serial = run_memory({"off", "4", "1", false}, 300000, &skipped);
+  Completions threaded = run_memory({"off", "4", "4", false}, 300000, &skipped);
+  Completions threaded_skipping = run_memory({"off", "4", "4", true}, 300000,
+                                             &skipped);
+  EXPECT_FALSE(serial.empty());
+  EXPECT_EQ(serial, threaded);
+  EXPECT_EQ(serial, threaded_skipping);
+}
+
+TEST(RamulatorTest, ChannelThreadsRunEveryChannelOnce) {
+  const int                    channels = 8;
+  std::vector<std::atomic<int>> counts(channels);
+  for(auto& count : counts)
+    count = 0;
+  ChannelThreads threads(4, channels, [&](int i) { counts[i]++; });
+
+  for(int cycle = 0; cycle < 1000; cycle++)
+    threads.run();
+  threads.stop();  // as before a fork; the next run() restarts the workers
+  for(int cycle = 0; cycle < 1000; cycle++)
+    threads.run();
+  for(int i = 0; i < channels; i++)
+    EXPECT_EQ(counts[i], 2000) << "channel " << i;
+}
@@ -0,0 +1,132 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Folded_History_Bank must track the per-history Folded_History exactly. Both
+ * the AVX2 updates and the plain lane loop are run against a set of
+ * Folded_History over the same random push/rewind/retire sequence that the
+ * TAGE speculative history sees. */
+
+#include <cassert>
+#include <random>
+#include <vector>
+
+#include "../bp/template_lib/tage.h"
+#include "../bp/template_lib/tagescl_configs.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+const int MAX_IN_FLIGHT_BITS = 256;
+
+/* Pushes, rewinds and retires random history bits for 'steps' steps and checks
+   every fold of 'bank' against Folded_History after each one. Rewinds fold the
+   bits out before leaving the register, like global_recover_speculative_state
+   does. */
+template <class TAGE_CONFIG>
+void check_bank(bool allow_avx2, int steps, unsigned seed) {
+  typedef Folded_History<TAGE_CONFIG::MAX_HISTORY_SIZE> Fold;
+  const int N = TAGE_CONFIG::NUM_HISTORIES;
+
+  Tage_History_Sizes<TAGE_CONFIG>                       history_sizes;
+  Tage_Tag_Bits<TAGE_CONFIG>                            tag_bits;
+  Long_History_Register<TAGE_CONFIG::MAX_HISTORY_SIZE> history(
+    MAX_IN_FLIGHT_BITS);
+  Folded_History_Bank<TAGE_CONFIG> bank(allow_avx2);
+  std::vector<Fold>                indices, tags_0, tags_1;
+  for(int i = 0; i < N; i++) {
+    bank.init(i, history_sizes.arr[i], TAGE_CONFIG::LOG_ENTRIES_PER_BANK,
+              tag_bits.arr[i], tag_bits.arr[i] - 1);
+    indices.emplace_back(history_sizes.arr[i],
+                         TAGE_CONFIG::LOG_ENTRIES_PER_BANK);
+    tags_0.emplace_back(history_sizes.arr[i], tag_bits.arr[i]);
+    tags_1.emplace_back(history_sizes.arr[i], tag_bits.arr[i] - 1);
+  }
+
+  std::mt19937 rng(seed);
+  int          speculative = 0;
+  long         pushes = 0, rewinds = 0;
+  for(int step = 0; step < steps; step++) {
+    int choice = rng() % 8;
+    if(speculative < MAX_IN_FLIGHT_BITS - 8 && (choice < 5 || !speculative)) {
+      int bits = 1 + rng() % 3;  // up to 3 bits per branch, as in TAGE
+      for(int b = 0; b < bits; b++) {
+        history.push_bit(rng() & 1);
+        bank.update(history);
+        for(int i = 0; i < N; i++) {
+          indices[i].update(history);
+          tags_0[i].update(history);
+          tags_1[i].update(history);
+        }
+      }
+      speculative += bits;
+      pushes += bits;
+    } else if(choice < 7) {
+      int bits = 1 + rng() % speculative;
+      history.retire(bits);
+      speculative -= bits;
+    } else {
+      int bits = 1 + rng() % speculative;
+      for(int b = 0; b < bits; b++) {
+        bank.update_reverse(history);
+        for(int i = 0; i < N; i++) {
+          indices[i].update_reverse(history);
+          tags_0[i].update_reverse(history);
+          tags_1[i].update_reverse(history);
+        }
+        history.rewind(1);
+      }
+      speculative -= bits;
+      rewinds += bits;
+    }
+
+    for(int i = 0; i < N; i++) {
+      ASSERT_EQ(bank.index(i), indices[i].get_value())
+        << "step " << step << " history " << i;
+      ASSERT_EQ(bank.tag_0(i), tags_0[i].get_value())
+        << "step " << step << " history " << i;
+      ASSERT_EQ(bank.tag_1(i), tags_1[i].get_value())
+        << "step " << step << " history " << i;
+    }
+  }
+  // the longest history must have filled up for its out bits to be checked
+  EXPECT_GT(pushes - rewinds, TAGE_CONFIG::MAX_HISTORY_SIZE);
+}
+
+bool host_has_avx2() {
+  Folded_History_Bank<TAGE_SC_L_CONFIG_64KB::TAGE> bank;
+  return bank.uses_avx2();
+}
+
+}  // namespace
+
+TEST(TageFoldingTest, LaneLoopMatchesFoldedHistory) {
+  Folded_History_Bank<TAGE_SC_L_CONFIG_64KB::TAGE> bank(false);
+  EXPECT_FALSE(bank.uses_avx2());
+  check_bank<TAGE_SC_L_CONFIG_64KB::TAGE>(false, 50000, 1);
+  check_bank<TAGE_SC_L_CONFIG_80KB::TAGE>(false, 50000, 2);
+}
+
+TEST(TageFoldingTest, Avx2MatchesFoldedHistory) {
+  if(!host_has_avx2())
+    GTEST_SKIP() << "host has no AVX2";
+  check_bank<TAGE_SC_L_CONFIG_64KB::TAGE>(true, 50000, 1);
+  check_bank<TAGE_SC_L_CONFIG_80KB::TAGE>(true, 50000, 2);
+}
@@ -64,6 +64,8 @@ void set_thread_data(Thread_Data* new_td) {
 void init_thread(Thread_Data* td, char* argv[], char* envp[]) {
   set_map_data(&td->map_data);
   init_map(0);
+  set_lsq_data(&td->lsq_data);
+  init_lsq(0);
   init_list(&td->seq_op_list, "SEQ_OP_LIST", sizeof(Op*), TRUE);
 }
 
@@ -76,6 +78,7 @@ void recover_thread(Thread_Data* td, Addr new_pc, Counter op_num,
   rename_table_recover(op_num);
   recover_seq_op_list(td, op_num);
   recover_map();
+  recover_lsq(op_num);
   ASSERT(td->proc_id, !remain_wrongpath);
 }
 
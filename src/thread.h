@@ -29,8 +29,10 @@
 #ifndef __THREAD_H__
 #define __THREAD_H__
 
+#include "globals/global_defs.h"
 #include "globals/global_types.h"
 #include "libs/list_lib.h"
+#include "lsq.h"
 #include "map.h"
 
 
@@ -57,6 +59,7 @@ typedef struct Thread_Info_struct {
 typedef struct Thread_struct {
   uns8     proc_id;
   Map_Data map_data;
+  Lsq_Data lsq_data;
   List     seq_op_list;
   ///////////////////////////////////////////////////
   // Pipeline Gating
@@ -68,7 +71,7 @@ typedef struct Thread_struct {
 /**************************************************************************************/
 /* External variables */
 
-extern Thread_Data* td; /* here for now, variable declared in sim.c */
+extern CORE_LOCAL Thread_Data* td; /* here for now, variable declared in sim.c */
 /* if we ever go MT, this will turn into an array */
 
 
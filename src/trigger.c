@@ -119,6 +119,8 @@ Trigger* trigger_create(const char* name, const char* spec, Trigger_Type type) {
 }
 
 Flag trigger_fired(Trigger* trigger) {
+  if(trigger->armed)
+    sync_stats();
   // common (false) case first
   if(!trigger->armed || (trigger->stat->count + trigger->stat->total_count) <
                           trigger->next_threshold) {
@@ -155,6 +157,7 @@ double trigger_progress(Trigger* trigger) {
     return 1.0;
 
   ASSERT(0, trigger->next_threshold >= trigger->period);
+  sync_stats();
   Counter stat_count = trigger->stat->count + trigger->stat->total_count;
   ASSERT(0, stat_count >= trigger->next_threshold - trigger->period);
   if(stat_count >= trigger->next_threshold)
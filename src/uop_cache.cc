@@ -45,29 +45,23 @@ typedef std::pair<Addr, FT_Info_Static> Uop_Cache_Key;
 /**************************************************************************************/
 /* Local Prototypes */
 
-// uop cache derived class
-class Uop_Cache: public Cpp_Cache<Uop_Cache_Key, Uop_Cache_Data> {
- protected:
-  uns   offset_bits;
-
-  // implementing the virtual hash function
-  uns set_idx_hash(Uop_Cache_Key key);
+// uop cache set index: the cache is indexed by the FT start address
+class Uop_Cache_Index {
+  // offset_bits is only used to denote the start of the set bits
+  // the set bits follow the offset_bits on the significant side
+  // in other words,
+  // user manipulates the line_bytes of the Cpp_Cache to change the set id hashing pattern
+  uns                offset_bits;
+  // num_sets need not be a power of 2
+  Cpp_Cache_Fast_Mod set_mod;
 
  public:
-  // constructor
-  Uop_Cache(uns nl, uns asc, uns lb, Repl_Policy rp) : Cpp_Cache<Uop_Cache_Key, Uop_Cache_Data>::Cpp_Cache(nl, asc, lb, rp) {
-    // offset_bits is only used to denote the start of the set bits
-    // the set bits follow the offset_bits on the significant side
-    // in other words,
-    // user manipulates the line_bytes of the Cpp_Cache to change the set id hashing pattern
-    offset_bits  = LOG2(line_bytes);
-  }
+  Uop_Cache_Index(uns num_sets, uns line_bytes) : offset_bits(LOG2(line_bytes)), set_mod(num_sets) {}
+
+  inline uns operator()(const Uop_Cache_Key& key) const { return set_mod.mod(key.first >> offset_bits); }
 };
 
-uns Uop_Cache::set_idx_hash(Uop_Cache_Key key) {
-  // use % instead of masking to support num_sets that is not a power of 2
-  return (key.first >> offset_bits) % num_sets;
-}
+typedef Cpp_Cache<Uop_Cache_Key, Uop_Cache_Data, Uop_Cache_Index> Uop_Cache;
 
 // overload operator == of FT_Info_Static type
 bool operator==(const FT_Info_Static& lhs, const FT_Info_Static& rhs) {
@@ -87,7 +81,7 @@ bool operator==(const Uop_Cache_Key& lhs, const Uop_Cache_Key& rhs) {
 /**************************************************************************************/
 /* Global Variables */
 
-uns8 uop_cache_proc_id;
+CORE_LOCAL uns8 uop_cache_proc_id;
 // per core caches
 std::vector<Uop_Cache*> per_core_uop_cache;
 
@@ -101,11 +95,11 @@ static std::vector<Uop_Cache_Data> per_core_accumulating_line;
 static std::vector<FT_Info> per_core_accumulating_ft;
 static std::vector<Counter> per_core_accumulating_op_num;
 // pointers to the structures of the current core in use
-static std::vector<Uop_Cache_Data>* current_accumulation_buffer = NULL;
-static uns* current_num_accumulated_lines = NULL;
-static Uop_Cache_Data* current_accumulating_line = NULL;
-static FT_Info* current_accumulating_ft = NULL;
-static Counter* current_accumulating_op_num = NULL;
+static CORE_LOCAL std::vector<Uop_Cache_Data>* current_accumulation_buffer = NULL;
+static CORE_LOCAL uns* current_num_accumulated_lines = NULL;
+static CORE_LOCAL Uop_Cache_Data* current_accumulating_line = NULL;
+static CORE_LOCAL FT_Info* current_accumulating_ft = NULL;
+static CORE_LOCAL Counter* current_accumulating_op_num = NULL;
 
 // uop cache per core lookup structures
 // the lookup buffer stores the uop cache lines of an FT
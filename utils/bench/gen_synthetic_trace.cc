@@ -0,0 +1,279 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : gen_synthetic_trace.cc
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Generates bzip2-compressed pin traces of small synthetic kernels
+ *                for the simulator throughput benchmarks (bin/scarab_bench.py)
+ ***************************************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "ctype_pin_inst.h"
+#include "isa/isa.h"
+
+/**************************************************************************************/
+/* Trace writer */
+
+static const uint64_t CODE_BASE  = 0x400000;
+static const uint64_t DATA_BASE  = 0x10000000;
+static const uint64_t DATA2_BASE = 0x50000000;
+static const uint8_t  INST_SIZE  = 4;
+
+static FILE*    out;
+static uint64_t num_insts;
+static uint64_t max_insts;
+static uint64_t rand_state;
+
+static uint64_t next_rand() {
+  rand_state = rand_state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return rand_state >> 17;
+}
+
+static uint64_t pc_of(uint32_t slot) {
+  return CODE_BASE + slot * INST_SIZE;
+}
+
+static ctype_pin_inst make_inst(uint32_t slot, uint8_t op_type,
+                                const char* iclass) {
+  ctype_pin_inst inst;
+  memset(&inst, 0, sizeof(inst));
+  inst.inst_uid              = num_insts;
+  inst.instruction_addr      = pc_of(slot);
+  inst.instruction_next_addr = pc_of(slot + 1);
+  inst.size                  = INST_SIZE;
+  inst.op_type               = op_type;
+  inst.num_simd_lanes        = 1;
+  inst.lane_width_bytes      = 8;
+  strncpy(inst.pin_iclass, iclass, sizeof(inst.pin_iclass) - 1);
+  return inst;
+}
+
+static void emit(const ctype_pin_inst& inst) {
+  fwrite(&inst, sizeof(inst), 1, out);
+  num_insts++;
+}
+
+static void alu(uint32_t slot, uint8_t dst, uint8_t src) {
+  ctype_pin_inst inst = make_inst(slot, OP_IADD, "ADD");
+  inst.num_src_regs   = 2;
+  inst.src_regs[0]    = dst;
+  inst.src_regs[1]    = src;
+  inst.num_dst_regs   = 2;
+  inst.dst_regs[0]    = dst;
+  inst.dst_regs[1]    = REG_ZPS;
+  emit(inst);
+}
+
+static void cmp(uint32_t slot, uint8_t src) {
+  ctype_pin_inst inst = make_inst(slot, OP_ICMP, "CMP");
+  inst.num_src_regs   = 1;
+  inst.src_regs[0]    = src;
+  inst.num_dst_regs   = 1;
+  inst.dst_regs[0]    = REG_ZPS;
+  emit(inst);
+}
+
+static void load(uint32_t slot, uint8_t dst, uint8_t addr_reg, uint64_t va) {
+  ctype_pin_inst inst    = make_inst(slot, OP_MOV, "MOV");
+  inst.num_ld            = 1;
+  inst.ld_size           = 8;
+  inst.ld_vaddr[0]       = va;
+  inst.num_ld1_addr_regs = 1;
+  inst.ld1_addr_regs[0]  = addr_reg;
+  inst.num_dst_regs      = 1;
+  inst.dst_regs[0]       = dst;
+  emit(inst);
+}
+
+static void store(uint32_t slot, uint8_t src, uint8_t addr_reg, uint64_t va) {
+  ctype_pin_inst inst   = make_inst(slot, OP_MOV, "MOV");
+  inst.num_st           = 1;
+  inst.st_size          = 8;
+  inst.st_vaddr[0]      = va;
+  inst.num_st_addr_regs = 1;
+  inst.st_addr_regs[0]  = addr_reg;
+  inst.num_src_regs     = 1;
+  inst.src_regs[0]      = src;
+  emit(inst);
+}
+
+/* conditional branch at slot jumping to target_slot when taken */
+static void branch(uint32_t slot, uint32_t target_slot, bool taken) {
+  ctype_pin_inst inst = make_inst(slot, OP_IADD, "JNZ");
+  inst.cf_type        = CF_CBR;
+  inst.num_src_regs   = 1;
+  inst.src_regs[0]    = REG_ZPS;
+  inst.branch_target  = pc_of(target_slot);
+  inst.actually_taken = taken;
+  if(taken)
+    inst.instruction_next_addr = pc_of(target_slot);
+  emit(inst);
+}
+
+static void jump(uint32_t slot, uint32_t target_slot) {
+  ctype_pin_inst inst        = make_inst(slot, OP_IADD, "JMP");
+  inst.cf_type               = CF_BR;
+  inst.branch_target         = pc_of(target_slot);
+  inst.actually_taken        = 1;
+  inst.instruction_next_addr = pc_of(target_slot);
+  emit(inst);
+}
+
+/**************************************************************************************/
+/* Kernels: each call emits one loop iteration. A loop trip count of `trip`
+   ends every trip-th iteration with a not-taken loop branch followed by a jump
+   back to the top, so the loop branch is not trivially always taken. */
+
+static uint64_t iteration;
+static uint64_t footprint;
+static uint64_t trip;
+static double   taken_prob;
+
+static bool loop_back() {
+  return ++iteration % trip != 0;
+}
+
+/* independent integer chains */
+static void kernel_alu() {
+  uint8_t regs[4] = {REG_RAX, REG_RBX, REG_RCX, REG_RDX};
+  for(uint32_t ii = 0; ii < 8; ii++)
+    alu(ii, regs[ii % 4], regs[(ii + 1) % 4]);
+  cmp(8, REG_RSI);
+  bool taken = loop_back();
+  branch(9, 0, taken);
+  if(!taken)
+    jump(10, 0);
+}
+
+/* strided copy: one load and one store per 64B line */
+static void kernel_stream() {
+  uint64_t offset = (iteration * 64) % footprint;
+  load(0, REG_RAX, REG_RSI, DATA_BASE + offset);
+  alu(1, REG_RAX, REG_RBX);
+  store(2, REG_RAX, REG_RDI, DATA2_BASE + offset);
+  alu(3, REG_RSI, REG_RCX);
+  alu(4, REG_RDI, REG_RCX);
+  cmp(5, REG_RSI);
+  bool taken = loop_back();
+  branch(6, 0, taken);
+  if(!taken)
+    jump(7, 0);
+}
+
+/* dependent loads to random lines of the footprint */
+static void kernel_chase() {
+  uint64_t offset = (next_rand() % (footprint / 64)) * 64;
+  load(0, REG_RAX, REG_RAX, DATA_BASE + offset);
+  alu(1, REG_RBX, REG_RAX);
+  cmp(2, REG_RBX);
+  bool taken = loop_back();
+  branch(3, 0, taken);
+  if(!taken)
+    jump(4, 0);
+}
+
+/* data-dependent forward branches, each taken with probability taken_prob */
+static void kernel_branchy() {
+  for(uint32_t ii = 0; ii < 4; ii++) {
+    uint32_t base  = ii * 3;
+    bool     taken = (next_rand() % 1000000) < taken_prob * 1000000;
+    cmp(base, REG_RAX);
+    branch(base + 1, base + 3, taken);
+    if(!taken)
+      alu(base + 2, REG_RBX, REG_RAX);
+  }
+  alu(12, REG_RAX, REG_RCX);
+  bool taken = loop_back();
+  branch(13, 0, taken);
+  if(!taken)
+    jump(14, 0);
+}
+
+/**************************************************************************************/
+/* main */
+
+static void usage(const char* prog) {
+  fprintf(stderr,
+          "Usage: %s -k <alu|stream|chase|branchy> -n <insts> -o <trace.bz2>\n"
+          "          [-f <footprint bytes>] [-t <loop trip count>]\n"
+          "          [-p <taken probability>] [-s <seed>]\n",
+          prog);
+  exit(1);
+}
+
+int main(int argc, char* argv[]) {
+  std::string kernel, output;
+  max_insts  = 0;
+  footprint  = 1 << 20;
+  trip       = 64;
+  taken_prob = 0.5;
+  rand_state = 1;
+
+  for(int ii = 1; ii + 1 < argc; ii += 2) {
+    std::string opt = argv[ii];
+    const char* val = argv[ii + 1];
+    if(opt == "-k")
+      kernel = val;
+    else if(opt == "-n")
+      max_insts = strtoull(val, NULL, 0);
+    else if(opt == "-o")
+      output = val;
+    else if(opt == "-f")
+      footprint = strtoull(val, NULL, 0);
+    else if(opt == "-t")
+      trip = strtoull(val, NULL, 0);
+    else if(opt == "-p")
+      taken_prob = atof(val);
+    else if(opt == "-s")
+      rand_state = strtoull(val, NULL, 0);
+    else
+      usage(argv[0]);
+  }
+
+  void (*kernel_func)(void) = NULL;
+  if(kernel == "alu")
+    kernel_func = kernel_alu;
+  else if(kernel == "stream")
+    kernel_func = kernel_stream;
+  else if(kernel == "chase")
+    kernel_func = kernel_chase;
+  else if(kernel == "branchy")
+    kernel_func = kernel_branchy;
+  if(!kernel_func || !max_insts || output.empty() || footprint < 64 || !trip)
+    usage(argv[0]);
+
+  std::string cmd = "bzip2 -c > '" + output + "'";
+  out             = popen(cmd.c_str(), "w");
+  if(!out) {
+    fprintf(stderr, "Cannot open %s\n", output.c_str());
+    return 1;
+  }
+  while(num_insts < max_insts)
+    kernel_func();
+  return pclose(out) == 0 ? 0 : 1;
+}
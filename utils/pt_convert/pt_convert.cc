@@ -0,0 +1,68 @@
+/* Copyright 2020 HPS/SAFARI Research Groups
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/***************************************************************************************
+ * File         : pt_convert.cc
+ * Author       : HPS Research Group
+ * Date         : 10/16/2026
+ * Description  : Converts a text PT trace to the binary format read by the pt
+ *                frontend (see src/frontend/pt_memtrace/pt_trace_format.h)
+ ***************************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+
+#include "frontend/pt_memtrace/pt_trace_format.h"
+
+int main(int argc, char** argv) {
+  bool compress = true;
+  if(argc == 4 && !strcmp(argv[3], "--no-compress"))
+    compress = false;
+  else if(argc != 3) {
+    fprintf(stderr, "usage: %s <in.gz> <out> [--no-compress]\n", argv[0]);
+    return 1;
+  }
+
+  PTTraceParser in;
+  PTTraceWriter out;
+  if(!in.open(argv[1])) {
+    fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  if(in.is_binary()) {
+    fprintf(stderr, "%s is already in the binary format\n", argv[1]);
+    return 1;
+  }
+  if(!out.open(argv[2], compress)) {
+    fprintf(stderr, "Cannot create %s\n", argv[2]);
+    return 1;
+  }
+
+  PTInst             inst;
+  unsigned long long num_insts = 0;
+  while(in.next(inst)) {
+    out.write(inst);
+    num_insts++;
+  }
+  out.close();
+  printf("Converted %llu instructions\n", num_insts);
+  return 0;
+}